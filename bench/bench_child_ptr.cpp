@@ -0,0 +1,96 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+#include "pyl_child_ptr.h"
+
+using namespace pyl;
+
+namespace {
+
+struct Node : Backtraceable<Node> {
+    int value = 0;
+};
+
+using NodePtr = child_unique_ptr<Node>;
+using WideNodePtr = child_unique_ptr<Node, Node, std::default_delete<Node>, hash_field_storage>;
+
+} // namespace
+
+// ---- dynamic fields ----
+
+template <class Ptr>
+static void BM_FieldRead(benchmark::State& state) {
+    Ptr p{nullptr, new Node};
+    p["alpha"] = 1;
+    p["beta"] = 2;
+    p["gamma"] = 3;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::any_cast<int>(p.fields()->find("beta")));
+    }
+}
+BENCHMARK(BM_FieldRead<NodePtr>);
+BENCHMARK(BM_FieldRead<WideNodePtr>);
+
+static void BM_FieldWrite(benchmark::State& state) {
+    NodePtr p{nullptr, new Node};
+    int i = 0;
+    for (auto _ : state) {
+        p["counter"] = ++i;
+    }
+    benchmark::DoNotOptimize(p);
+}
+BENCHMARK(BM_FieldWrite);
+
+// ---- dynamic function dispatch ----
+
+static void BM_CallByName(benchmark::State& state) {
+    NodePtr p{nullptr, new Node};
+    p.def<int, int, int>("add", [](int a, int b) { return a + b; });
+    int x = 0;
+    for (auto _ : state) {
+        x = p.call<int>("add", x, 1);
+    }
+    benchmark::DoNotOptimize(x);
+}
+BENCHMARK(BM_CallByName);
+
+static void BM_CallViaHandle(benchmark::State& state) {
+    NodePtr p{nullptr, new Node};
+    auto add = p.def<int, int, int>("add", [](int a, int b) { return a + b; });
+    int x = 0;
+    for (auto _ : state) {
+        x = add(x, 1);
+    }
+    benchmark::DoNotOptimize(x);
+}
+BENCHMARK(BM_CallViaHandle);
+
+static void BM_CallStdFunction(benchmark::State& state) {
+    std::function<int(int, int)> add = [](int a, int b) { return a + b; };
+    int x = 0;
+    for (auto _ : state) {
+        x = add(x, 1);
+    }
+    benchmark::DoNotOptimize(x);
+}
+BENCHMARK(BM_CallStdFunction);
+
+// ---- tree building ----
+
+static void BM_BuildChain(benchmark::State& state) {
+    const auto depth = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        struct Link : Backtraceable<Link> {
+            child_unique_ptr<Link> next;
+        };
+        child_unique_ptr<Link> root{nullptr, new Link};
+        Link* tail = root.get();
+        for (int i = 0; i < depth; ++i) {
+            tail->next = child_unique_ptr<Link>{tail, new Link};
+            tail = tail->next.get();
+        }
+        benchmark::DoNotOptimize(root);
+    }
+}
+BENCHMARK(BM_BuildChain)->Arg(64);
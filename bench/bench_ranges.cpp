@@ -0,0 +1,116 @@
+#include <benchmark/benchmark.h>
+
+#include <map>
+#include <numeric>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "pyl_ranges.h"
+
+namespace {
+
+std::vector<double> make_doubles(std::size_t n) {
+    std::vector<double> v(n);
+    for (std::size_t i = 0; i < n; ++i) v[i] = static_cast<double>(i % 1000) * 0.5;
+    return v;
+}
+
+std::unordered_map<int, int> make_map(std::size_t n) {
+    std::unordered_map<int, int> m;
+    m.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) m.emplace(static_cast<int>(i), static_cast<int>(i * 2));
+    return m;
+}
+
+} // namespace
+
+// ---- keys / values / to_vector ----
+
+static void BM_KeysToVector(benchmark::State& state) {
+    auto m = make_map(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        auto ks = pyl::to_vector(pyl::keys(m));
+        benchmark::DoNotOptimize(ks.data());
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_KeysToVector)->Arg(1 << 10)->Arg(1 << 16);
+
+static void BM_ValuesSum(benchmark::State& state) {
+    auto m = make_map(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(pyl::sum(pyl::values(m)));
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_ValuesSum)->Arg(1 << 10)->Arg(1 << 16);
+
+static void BM_ToVectorFilter(benchmark::State& state) {
+    std::vector<int> v(static_cast<std::size_t>(state.range(0)));
+    std::iota(v.begin(), v.end(), 0);
+    for (auto _ : state) {
+        auto out = pyl::to_vector(v | std::views::filter([](int x) { return x % 3 == 0; }));
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_ToVectorFilter)->Arg(1 << 20);
+
+static void BM_ToVectorFilterPar(benchmark::State& state) {
+    std::vector<int> v(static_cast<std::size_t>(state.range(0)));
+    std::iota(v.begin(), v.end(), 0);
+    for (auto _ : state) {
+        auto out = pyl::to_vector(pyl::par, v | std::views::filter([](int x) { return x % 3 == 0; }));
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_ToVectorFilterPar)->Arg(1 << 20)->UseRealTime();
+
+// ---- sum ----
+
+static void BM_SumSeq(benchmark::State& state) {
+    auto v = make_doubles(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(pyl::sum(v));
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_SumSeq)->Arg(1 << 20);
+
+static void BM_SumUnseq(benchmark::State& state) {
+    auto v = make_doubles(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(pyl::sum(pyl::unseq, v));
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_SumUnseq)->Arg(1 << 20);
+
+static void BM_SumParUnseq(benchmark::State& state) {
+    auto v = make_doubles(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(pyl::sum(pyl::par_unseq, v));
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_SumParUnseq)->Arg(1 << 20)->Arg(1 << 24)->UseRealTime();
+
+static void BM_SumKahan(benchmark::State& state) {
+    auto v = make_doubles(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(pyl::sum(pyl::seq, v, pyl::SumMode::Kahan));
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_SumKahan)->Arg(1 << 20);
+
+static void BM_StdAccumulate(benchmark::State& state) {
+    auto v = make_doubles(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::accumulate(v.begin(), v.end(), 0.0));
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_StdAccumulate)->Arg(1 << 20);
@@ -0,0 +1,96 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "pyl_strong_span.h"
+#include "pyl_text.h"
+
+using namespace pyl;
+
+namespace {
+
+struct QtyTag {};
+using Qty = StrongNumber<std::int64_t, QtyTag>;
+
+struct SatQtyTag { static constexpr Overflow overflow = Overflow::Saturate; };
+using SatQty = StrongNumber<std::int64_t, SatQtyTag>;
+
+struct CheckedQtyTag { static constexpr Overflow overflow = Overflow::Checked; };
+using CheckedQty = StrongNumber<std::int64_t, CheckedQtyTag>;
+
+constexpr std::size_t n = 1 << 16;
+constexpr auto items = static_cast<std::int64_t>(n);
+
+} // namespace
+
+// ---- scalar arithmetic: strong vs raw ----
+
+static void BM_RawAccumulate(benchmark::State& state) {
+    std::vector<std::int64_t> v(n, 3);
+    for (auto _ : state) {
+        std::int64_t acc = 0;
+        for (auto x : v) acc = acc * 3 + x;
+        benchmark::DoNotOptimize(acc);
+    }
+    state.SetItemsProcessed(state.iterations() * items);
+}
+BENCHMARK(BM_RawAccumulate);
+
+template <class S>
+static void BM_StrongAccumulate(benchmark::State& state) {
+    std::vector<S> v(n, S{3});
+    for (auto _ : state) {
+        S acc{};
+        for (auto x : v) acc = acc * S{3} + x;
+        benchmark::DoNotOptimize(acc);
+    }
+    state.SetItemsProcessed(state.iterations() * items);
+}
+BENCHMARK(BM_StrongAccumulate<Qty>);
+BENCHMARK(BM_StrongAccumulate<SatQty>);
+
+// ---- bulk kernels ----
+
+static void BM_RawAdd(benchmark::State& state) {
+    std::vector<std::int64_t> a(n, 1), b(n, 2), out(n);
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < n; ++i) out[i] = a[i] + b[i];
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * items);
+}
+BENCHMARK(BM_RawAdd);
+
+template <class S>
+static void BM_BulkAdd(benchmark::State& state) {
+    std::vector<S> a(n, S{1}), b(n, S{2}), out(n);
+    for (auto _ : state) {
+        bulk::add(a, b, out);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * items);
+}
+BENCHMARK(BM_BulkAdd<Qty>);
+BENCHMARK(BM_BulkAdd<SatQty>);
+BENCHMARK(BM_BulkAdd<CheckedQty>);
+
+// ---- formatting ----
+
+static void BM_StrongToString(benchmark::State& state) {
+    Qty q{1234567};
+    for (auto _ : state) {
+        auto s = q.to_string();
+        benchmark::DoNotOptimize(s);
+    }
+}
+BENCHMARK(BM_StrongToString);
+
+static void BM_StrongFormatTo(benchmark::State& state) {
+    Qty q{1234567};
+    char buf[Qty::max_chars];
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(q.format_to(buf));
+    }
+}
+BENCHMARK(BM_StrongFormatTo);
@@ -0,0 +1,153 @@
+#include <benchmark/benchmark.h>
+
+#include <any>
+#include <cstdio>
+#include <sstream>
+#include <string>
+
+#include "pyl_text.h"
+
+#if __has_include(<format>)
+#include <format>
+#endif
+
+using namespace pyl;
+
+// ---- operator+ chains ----
+
+static void BM_TextPlusChain(benchmark::State& state) {
+    Text name = "alpha";
+    int rows = 42;
+    double ratio = 0.75;
+    for (auto _ : state) {
+        Text t = name + ": rows=" + rows + ", ratio=" + ratio + " done";
+        benchmark::DoNotOptimize(t);
+    }
+}
+BENCHMARK(BM_TextPlusChain);
+
+static void BM_TextConcat(benchmark::State& state) {
+    Text name = "alpha";
+    int rows = 42;
+    double ratio = 0.75;
+    for (auto _ : state) {
+        Text t = concat(name, ": rows=", rows, ", ratio=", ratio, " done");
+        benchmark::DoNotOptimize(t);
+    }
+}
+BENCHMARK(BM_TextConcat);
+
+static void BM_StdStringPlusChain(benchmark::State& state) {
+    std::string name = "alpha";
+    int rows = 42;
+    double ratio = 0.75;
+    for (auto _ : state) {
+        std::string t = name + ": rows=" + std::to_string(rows) + ", ratio=" +
+                        std::to_string(ratio) + " done";
+        benchmark::DoNotOptimize(t);
+    }
+}
+BENCHMARK(BM_StdStringPlusChain);
+
+// ---- F() formatting (compiled_format::format is F without the sink) ----
+
+static void BM_FFormat(benchmark::State& state) {
+    int x = 12345;
+    double y = 2.5;
+    std::string name = "sensor";
+    for (auto _ : state) {
+        auto s = compiled_format<"{name}: x={x}, y={y}", "name", "x", "y">::format(name, x, y);
+        benchmark::DoNotOptimize(s);
+    }
+}
+BENCHMARK(BM_FFormat);
+
+#if defined(__cpp_lib_format)
+static void BM_StdFormat(benchmark::State& state) {
+    int x = 12345;
+    double y = 2.5;
+    std::string name = "sensor";
+    for (auto _ : state) {
+        auto s = std::format("{}: x={}, y={:f}", name, x, y);
+        benchmark::DoNotOptimize(s);
+    }
+}
+BENCHMARK(BM_StdFormat);
+#endif
+
+static void BM_Snprintf(benchmark::State& state) {
+    int x = 12345;
+    double y = 2.5;
+    std::string name = "sensor";
+    for (auto _ : state) {
+        char buf[128];
+        int n = std::snprintf(buf, sizeof(buf), "%s: x=%d, y=%f", name.c_str(), x, y);
+        std::string s(buf, static_cast<std::size_t>(n));
+        benchmark::DoNotOptimize(s);
+    }
+}
+BENCHMARK(BM_Snprintf);
+
+static void BM_Ostringstream(benchmark::State& state) {
+    int x = 12345;
+    double y = 2.5;
+    std::string name = "sensor";
+    for (auto _ : state) {
+        std::ostringstream oss;
+        oss << name << ": x=" << x << ", y=" << y;
+        auto s = oss.str();
+        benchmark::DoNotOptimize(s);
+    }
+}
+BENCHMARK(BM_Ostringstream);
+
+// ---- any_to_string ----
+
+static void BM_AnyToStringInt(benchmark::State& state) {
+    std::any a = 123456;
+    for (auto _ : state) {
+        auto s = any_to_string(a);
+        benchmark::DoNotOptimize(s);
+    }
+}
+BENCHMARK(BM_AnyToStringInt);
+
+static void BM_AnyToStringText(benchmark::State& state) {
+    std::any a = Text("some label");
+    for (auto _ : state) {
+        auto s = any_to_string(a);
+        benchmark::DoNotOptimize(s);
+    }
+}
+BENCHMARK(BM_AnyToStringText);
+
+static void BM_AppendAnyReused(benchmark::State& state) {
+    std::any a = 3.25;
+    std::string out;
+    for (auto _ : state) {
+        out.clear();
+        append_any(out, a);
+        benchmark::DoNotOptimize(out);
+    }
+}
+BENCHMARK(BM_AppendAnyReused);
+
+// ---- hashing ----
+
+static void BM_TextHash(benchmark::State& state) {
+    Text t(std::string(static_cast<std::size_t>(state.range(0)), 'x'));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(t.hash());
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_TextHash)->Arg(8)->Arg(64)->Arg(1024);
+
+static void BM_StdStringHash(benchmark::State& state) {
+    std::string s(static_cast<std::size_t>(state.range(0)), 'x');
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::hash<std::string>{}(s));
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_StdStringHash)->Arg(8)->Arg(64)->Arg(1024);
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <system_error>
+#include <type_traits>
+
+namespace pyl {
+
+// ---------------------------------------------------------
+// to_chars / append_chars – allocation-free number formatting
+//
+// Output matches std::to_string():
+//   - integers: plain decimal (also __int128 / unsigned __int128)
+//   - floating point: fixed notation with 6 decimals ("%f")
+//
+// Usage:
+//   char buf[pyl::max_chars<double>];
+//   char* end = pyl::to_chars(buf, buf + sizeof(buf), 3.5);  // "3.500000"
+//
+//   std::string out;
+//   pyl::append_chars(out, 42);                              // out += "42"
+//
+// Other types (e.g. StrongNumber) plug in by providing a
+// to_chars(first, last, value) overload and a max_chars specialization;
+// append_chars, to_text and F then use it.
+// ---------------------------------------------------------
+
+namespace chars_detail {
+
+// std::is_arithmetic / std::numeric_limits do not cover __int128 in
+// strict (-std=c++20) mode
+#ifdef __SIZEOF_INT128__
+__extension__ typedef __int128 int128_t;
+__extension__ typedef unsigned __int128 uint128_t;
+
+template <typename T>
+inline constexpr bool is_int128_v =
+    std::is_same_v<std::remove_cv_t<T>, int128_t> ||
+    std::is_same_v<std::remove_cv_t<T>, uint128_t>;
+#else
+template <typename T>
+inline constexpr bool is_int128_v = false;
+#endif
+
+} // namespace chars_detail
+
+// Built-in numbers to_chars() formats directly
+template <typename T>
+concept chars_number = std::is_arithmetic_v<T> || chars_detail::is_int128_v<T>;
+
+// Upper bound on characters written by to_chars() for T
+template <typename T>
+inline constexpr std::size_t max_chars = [] {
+    if constexpr (std::is_floating_point_v<T>) {
+        // sign + integer digits + '.' + 6 decimals
+        return static_cast<std::size_t>(std::numeric_limits<T>::max_exponent10) + 1 + 1 + 1 + 6;
+    } else if constexpr (chars_detail::is_int128_v<T>) {
+        // sign + 39 digits
+        return std::size_t{40};
+    } else {
+        // sign + digits
+        return static_cast<std::size_t>(std::numeric_limits<T>::digits10) + 1 + 1;
+    }
+}();
+
+namespace chars_detail {
+
+#ifdef __SIZEOF_INT128__
+// Decimal digits of a 128-bit magnitude, written in 19-digit blocks so
+// every division after the first is a plain 64-bit one
+inline char* to_chars_u128(char* first, char* last, uint128_t v, bool negative) noexcept {
+    constexpr std::uint64_t block = 10000000000000000000ULL;  // 10^19
+    char tmp[40];
+    char* p = tmp + sizeof(tmp);
+    while (v >= block) {
+        auto chunk = static_cast<std::uint64_t>(v % block);
+        v /= block;
+        for (int i = 0; i < 19; ++i) {
+            *--p = static_cast<char>('0' + chunk % 10);
+            chunk /= 10;
+        }
+    }
+    auto head = static_cast<std::uint64_t>(v);
+    do {
+        *--p = static_cast<char>('0' + head % 10);
+        head /= 10;
+    } while (head != 0);
+    if (negative) *--p = '-';
+
+    auto len = static_cast<std::size_t>(tmp + sizeof(tmp) - p);
+    if (static_cast<std::size_t>(last - first) < len) return nullptr;
+    std::memcpy(first, p, len);
+    return first + len;
+}
+#endif
+
+} // namespace chars_detail
+
+// Write `value` into [first, last); returns one past the last char written,
+// or nullptr if the buffer is too small.
+template <chars_number T>
+inline char* to_chars(char* first, char* last, T value) noexcept {
+#ifdef __SIZEOF_INT128__
+    if constexpr (std::is_same_v<T, chars_detail::uint128_t>) {
+        return chars_detail::to_chars_u128(first, last, value, false);
+    } else if constexpr (std::is_same_v<T, chars_detail::int128_t>) {
+        // magnitude via unsigned negation (well-defined for the minimum)
+        auto u = static_cast<chars_detail::uint128_t>(value);
+        return value < 0 ? chars_detail::to_chars_u128(first, last, 0 - u, true)
+                         : chars_detail::to_chars_u128(first, last, u, false);
+    } else
+#endif
+    {
+        std::to_chars_result r;
+        if constexpr (std::is_same_v<T, bool>) {
+            r = std::to_chars(first, last, static_cast<int>(value));
+        } else if constexpr (std::is_floating_point_v<T>) {
+            r = std::to_chars(first, last, value, std::chars_format::fixed, 6);
+        } else {
+            r = std::to_chars(first, last, value);
+        }
+        return r.ec == std::errc{} ? r.ptr : nullptr;
+    }
+}
+
+// Anything to_chars() can write into a max_chars<T> buffer
+template <typename T>
+concept chars_writable = requires(const T& v, char* p) {
+    { to_chars(p, p, v) } -> std::same_as<char*>;
+} && (max_chars<T> > 0);
+
+// Append `value` to `out` without a temporary std::string
+template <typename T>
+    requires chars_writable<T>
+inline void append_chars(std::string& out, const T& value) {
+    char buf[max_chars<T>];
+    char* end = to_chars(buf, buf + sizeof(buf), value);
+    out.append(buf, static_cast<std::size_t>(end - buf));
+}
+
+} // namespace pyl
@@ -1,11 +1,14 @@
 #pragma once
 
 #include <any>
+#include <array>
 #include <cassert>
 #include <concepts>
 #include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <memory>
+#include <memory_resource>
 #include <ostream>
 #include <stdexcept>
 #include <string>
@@ -15,7 +18,11 @@
 #include <unordered_map>
 #include <utility>
 #include <vector>
-#include <sstream>
+
+#include "pyl_field_storage.h"
+#include "pyl_hash.h"
+#include "pyl_stream_pool.h"
+#include "pyl_type_name.h"
 
 namespace pyl {
 
@@ -33,6 +40,194 @@ struct Backtraceable {
     bool has_parent() const noexcept    { return parent != nullptr; }
 };
 
+// -------------------------------------------------------------
+// TrackedBacktraceable: Backtraceable that also counts attached
+// children (maintained by child_unique_ptr).
+//
+// Adopting a leaf (child_count == 0) can never create a cycle, so
+// the check is O(1) for freshly built nodes; only moving a subtree
+// that has children walks the ancestor chain.
+//
+// Define PYL_DISABLE_CYCLE_CHECK (CMake option of the same name) to
+// skip cycle detection altogether.
+// -------------------------------------------------------------
+template<typename Parent>
+struct TrackedBacktraceable : Backtraceable<Parent> {
+    std::size_t child_count = 0;  // children attached via child_unique_ptr
+};
+
+// -------------------------------------------------------------
+// pmr_deleter<T>: allocate and free child objects through a
+// std::pmr::memory_resource (a null resource means new/delete)
+//
+// Child pointers default-constructed inside an object that create()
+// is building inherit its resource, so a whole tree shares one arena.
+// The resource only covers objects the pointer allocates itself
+// (emplace, make_child_unique_ptr_in, full_copy): a pointer adopted
+// through reset(p) or from a std::unique_ptr is taken as coming from
+// new and is freed with delete.
+//
+//   pyl::child_arena arena;
+//   auto root = pyl::make_child_unique_ptr_in<Node>(arena, nullptr, 1);
+// -------------------------------------------------------------
+namespace pmr_detail {
+
+// Resource of the object currently being constructed by
+// pmr_deleter::create(); default-constructed deleters (i.e. the child
+// pointers inside that object) pick it up.
+inline thread_local std::pmr::memory_resource* constructing = nullptr;
+
+struct constructing_scope {
+    std::pmr::memory_resource* saved;
+    explicit constructing_scope(std::pmr::memory_resource* r) noexcept
+        : saved(constructing) { constructing = r; }
+    ~constructing_scope() { constructing = saved; }
+    constructing_scope(const constructing_scope&) = delete;
+    constructing_scope& operator=(const constructing_scope&) = delete;
+};
+
+} // namespace pmr_detail
+
+template<typename T>
+struct pmr_deleter {
+    std::pmr::memory_resource* resource = pmr_detail::constructing;   // used by create()
+    bool pointee_from_new = false;   // current object was adopted, not created
+
+    pmr_deleter() noexcept = default;
+    constexpr pmr_deleter(std::pmr::memory_resource* r) noexcept : resource(r) {}
+
+    // child_unique_ptr reports how each object it takes over was made
+    void adopted(bool from_new) noexcept { pointee_from_new = from_new; }
+
+    template<typename... Args>
+    T* create(Args&&... args) const {
+        if (!resource) {
+            return new T(std::forward<Args>(args)...);
+        }
+        void* mem = resource->allocate(sizeof(T), alignof(T));
+        try {
+            pmr_detail::constructing_scope scope(resource);
+            return ::new (mem) T(std::forward<Args>(args)...);
+        } catch (...) {
+            resource->deallocate(mem, sizeof(T), alignof(T));
+            throw;
+        }
+    }
+
+    void operator()(T* p) const noexcept {
+        if (!resource || pointee_from_new) {
+            delete p;
+            return;
+        }
+        p->~T();
+        resource->deallocate(p, sizeof(T), alignof(T));
+    }
+};
+
+// -------------------------------------------------------------
+// child_arena: monotonic arena for whole trees
+//
+// Per-node deallocation is a no-op, so tearing a tree down only runs
+// destructors. To skip even that, release() the root pointer and
+// then call arena.release(): the memory is reclaimed at once, but no
+// destructors run, so nodes must own nothing outside the arena
+// (dynamic fields/functions live on the regular heap).
+// -------------------------------------------------------------
+using child_arena = std::pmr::monotonic_buffer_resource;
+
+// -------------------------------------------------------------
+// fn_handle<R(Args...)>: typed handle to a function registered with
+// child_unique_ptr::def(). Calling it is one indirect call; arguments
+// and the result are passed as-is.
+//
+//   auto mul = ptr.def<int, int, int>("mul", [](int a, int b) { return a * b; });
+//   int r = mul(6, 7);
+// -------------------------------------------------------------
+namespace fn_detail {
+
+// Type-erased entry shared by the name table and handles
+struct fn_entry {
+    virtual ~fn_entry() = default;
+
+    // name-based path: arguments boxed in `n` std::any values
+    virtual std::any call_packed(const std::any* args, std::size_t n) const = 0;
+    virtual const std::type_info& signature() const noexcept = 0;
+};
+
+template<typename R, typename... Args>
+struct typed_fn_entry : fn_entry {
+    using invoke_fn = R (*)(const typed_fn_entry&, Args...);
+    invoke_fn invoke;
+
+    explicit typed_fn_entry(invoke_fn i) noexcept : invoke(i) {}
+
+    const std::type_info& signature() const noexcept override {
+        return typeid(R(Args...));
+    }
+};
+
+template<typename F, typename R, typename... Args>
+struct callable_fn_entry final : typed_fn_entry<R, Args...> {
+    F f;
+
+    template<typename G>
+    explicit callable_fn_entry(G&& g)
+        : typed_fn_entry<R, Args...>(&invoke_direct), f(std::forward<G>(g)) {}
+
+    static R invoke_direct(const typed_fn_entry<R, Args...>& self, Args... args) {
+        const auto& me = static_cast<const callable_fn_entry&>(self);
+        if constexpr (std::is_void_v<R>) {
+            std::invoke(me.f, std::forward<Args>(args)...);
+        } else {
+            return std::invoke(me.f, std::forward<Args>(args)...);
+        }
+    }
+
+    std::any call_packed(const std::any* args, std::size_t n) const override {
+        if (n != sizeof...(Args)) {
+            throw std::runtime_error("dynamic call: argument count mismatch");
+        }
+        return unpack(args, std::index_sequence_for<Args...>{});
+    }
+
+    template<std::size_t... I>
+    std::any unpack([[maybe_unused]] const std::any* args, std::index_sequence<I...>) const {
+        if constexpr (std::is_void_v<R>) {
+            std::invoke(f, std::any_cast<Args>(args[I])...);
+            return std::any{};
+        } else {
+            return std::any(std::invoke(f, std::any_cast<Args>(args[I])...));
+        }
+    }
+};
+
+} // namespace fn_detail
+
+template<typename Sig>
+class fn_handle;
+
+template<typename R, typename... Args>
+class fn_handle<R(Args...)> {
+public:
+    using entry_type = fn_detail::typed_fn_entry<R, Args...>;
+
+    fn_handle() noexcept = default;
+    explicit fn_handle(std::shared_ptr<const entry_type> e) noexcept
+        : entry_(std::move(e)) {}
+
+    explicit operator bool() const noexcept { return entry_ != nullptr; }
+
+    R operator()(Args... args) const {
+        if (!entry_) {
+            throw std::runtime_error("fn_handle: empty handle");
+        }
+        return entry_->invoke(*entry_, std::forward<Args>(args)...);
+    }
+
+private:
+    std::shared_ptr<const entry_type> entry_;
+};
+
 // -------------------------------------------------------------
 // child_unique_ptr
 //
@@ -41,8 +236,11 @@ struct Backtraceable {
 // - Parent* back-pointer for T if it derives Backtraceable<Parent>
 // - Optional cycle detection (via Parent::parent chain)
 // - Dynamic fields map: ptr["key"] <=> std::any value
+//   (storage chosen by FieldStorage, see pyl_field_storage.h;
+//   concurrent_field_storage makes fields and functions safe to
+//   read and write from many threads)
 // - Dynamic functions:
-//     ptr.def<R, Args...>("name", lambda);
+//     auto h = ptr.def<R, Args...>("name", lambda);  h(args...);
 //     R r = ptr.call<R>("name", args...);
 //     auto res = ptr("name", args...); res.as<R>();
 // - Service helpers: to_string, to_full_string, equals, full_equals,
@@ -52,13 +250,18 @@ struct Backtraceable {
 template<
     typename Parent,
     typename T      = Parent,
-    typename Deleter = std::default_delete<T>
+    typename Deleter = std::default_delete<T>,
+    field_storage FieldStorage = flat_field_storage<>
 >
 class child_unique_ptr {
 public:
-    using pointer      = T*;
-    using element_type = T;
-    using deleter_type = Deleter;
+    using pointer       = T*;
+    using element_type  = T;
+    using deleter_type  = Deleter;
+    using storage_type  = FieldStorage;
+
+    // Fields and functions are RCU-published (see pyl_rcu.h)
+    static constexpr bool concurrent = synchronized_field_storage<FieldStorage>;
 
     // -------------------------------
     // call_result: wrapper for std::any
@@ -103,9 +306,10 @@ public:
         reset(p);
     }
 
+    // p must be one that d can free (as with std::unique_ptr(p, d))
     child_unique_ptr(Parent* parent, pointer p, const Deleter& d) noexcept
         : parent_(parent), deleter_(d) {
-        reset(p);
+        adopt(p, false);
     }
 
     child_unique_ptr(const child_unique_ptr&)            = delete;
@@ -123,7 +327,7 @@ public:
     child_unique_ptr& operator=(child_unique_ptr&& other) noexcept {
         if (this != &other) {
             pointer p = other.release();
-            reset(p);
+            adopt(p, false);
             deleter_    = std::move(other.deleter_);
             dyn_fields_ = std::move(other.dyn_fields_);
             dyn_fns_    = std::move(other.dyn_fns_);
@@ -156,28 +360,27 @@ public:
         return p;
     }
 
+    // p comes from new (never from a memory resource); use emplace()
+    // to allocate through the deleter
     void reset(pointer p = pointer()) noexcept {
-        if (p && parent_ && would_create_cycle(p, parent_)) {
-            // Silently refuse adoption to prevent cycles
-            return;
-        }
-
-        if (ptr_) {
-            clear_parent_on_child();
-            deleter_(ptr_);
-        }
-        ptr_ = p;
-        set_parent_on_child();
-        // dynamic data remains attached to this pointer object
+        adopt(p, true);
     }
 
+    // Allocates through the deleter when it provides create() (e.g.
+    // pmr_deleter), otherwise with new.
     template<typename... Args>
     void emplace(Args&&... args) {
-        reset(new T(std::forward<Args>(args)...));
+        if constexpr (requires(Deleter& d) { { d.create(std::forward<Args>(args)...) } -> std::same_as<pointer>; }) {
+            adopt(deleter_.create(std::forward<Args>(args)...), false);
+        } else {
+            reset(new T(std::forward<Args>(args)...));
+        }
     }
 
     void swap(child_unique_ptr& other) noexcept {
         using std::swap;
+        clear_parent_on_child();
+        other.clear_parent_on_child();
         swap(ptr_, other.ptr_);
         swap(deleter_, other.deleter_);
         swap(dyn_fields_, other.dyn_fields_);
@@ -193,29 +396,61 @@ public:
         return *this;
     }
 
+private:
+    // Take ownership of p; from_new tells a deleter with adopted()
+    // (pmr_deleter) whether to free it with delete
+    void adopt(pointer p, bool from_new) noexcept {
+        if (p && parent_ && would_create_cycle(p, parent_)) {
+            // Silently refuse adoption to prevent cycles
+            return;
+        }
+
+        if (ptr_) {
+            clear_parent_on_child();
+            deleter_(ptr_);
+        }
+        ptr_ = p;
+        if constexpr (requires(Deleter& d) { d.adopted(true); }) {
+            deleter_.adopted(from_new && p);
+        }
+        set_parent_on_child();
+        // dynamic data remains attached to this pointer object
+    }
+
+public:
+
     // ---------------------------------------------------------
     // Dynamic field map: ptr["key"] <=> any value
+    // Allocated on first assignment, so pointers without dynamic
+    // fields stay small. The map is published with a CAS, so two
+    // threads racing on the first assignment agree on one map.
     // ---------------------------------------------------------
 private:
-    using dyn_field_map_t = std::unordered_map<std::string, std::any>;
-    std::unique_ptr<dyn_field_map_t> dyn_fields_;
+    using dyn_field_map_t = FieldStorage;
+    rcu_ptr<dyn_field_map_t> dyn_fields_;
 
     dyn_field_map_t& ensure_fields() {
-        if (!dyn_fields_) {
-            dyn_fields_ = std::make_unique<dyn_field_map_t>();
+        if (dyn_field_map_t* m = dyn_fields_.load()) {
+            return *m;
+        }
+        auto fresh = std::make_unique<dyn_field_map_t>();
+        if (dyn_fields_.publish_if_null(fresh.get())) {
+            return *fresh.release();
         }
-        return *dyn_fields_;
+        return *dyn_fields_.load();   // another thread won
     }
 
     const dyn_field_map_t* fields_or_null() const noexcept {
-        return dyn_fields_.get();
+        return dyn_fields_.load();
     }
 
 public:
+    // Refers to the key passed to operator[]; use it within the
+    // same expression (as in ptr["k"] = v or int v = ptr["k"]).
     class field_proxy {
     public:
-        field_proxy(child_unique_ptr* owner, std::string key)
-            : owner_(owner), key_(std::move(key)) {}
+        field_proxy(child_unique_ptr* owner, std::string_view key)
+            : owner_(owner), key_(key) {}
 
         // assignment: ptr["k"] = value;
         template<typename U>
@@ -224,7 +459,11 @@ public:
                 throw std::runtime_error("child_unique_ptr::operator[] assign on null pointer");
             }
             auto& m = owner_->ensure_fields();
-            m[key_] = std::any(std::forward<U>(value));
+            if constexpr (concurrent) {
+                m.store(key_, std::any(std::forward<U>(value)));
+            } else {
+                m.get_or_insert(key_) = std::any(std::forward<U>(value));
+            }
             return *this;
         }
 
@@ -244,18 +483,28 @@ public:
             if (!m) {
                 throw std::runtime_error("field_proxy: no dynamic fields map");
             }
-            auto it = m->find(key_);
-            if (it == m->end()) {
-                throw std::runtime_error("field_proxy: key not found: " + key_);
+            auto get = [this](const std::any* v) -> U {
+                if (!v) {
+                    throw std::runtime_error("field_proxy: key not found: " + std::string(key_));
+                }
+                return std::any_cast<U>(*v);
+            };
+            if constexpr (concurrent) {
+                return m->read(key_, get);
+            } else {
+                return get(m->find(key_));
             }
-            return std::any_cast<U>(it->second);
         }
 
         bool exists() const {
             if (!owner_) return false;
             const auto* m = owner_->fields_or_null();
             if (!m) return false;
-            return m->find(key_) != m->end();
+            if constexpr (concurrent) {
+                return m->read(key_, [](const std::any* v) { return v != nullptr; });
+            } else {
+                return m->find(key_) != nullptr;
+            }
         }
 
         // call as function: ptr["fn"](args...).as<R>()
@@ -269,106 +518,146 @@ public:
 
     private:
         child_unique_ptr* owner_;
-        std::string key_;
+        std::string key_;   // owned: a stored proxy outlives temporary keys
     };
 
-    field_proxy operator[](std::string key) {
+    field_proxy operator[](std::string_view key) {
         if (!ptr_) {
             throw std::runtime_error("child_unique_ptr::operator[] on null pointer");
         }
-        return field_proxy(this, std::move(key));
+        return field_proxy(this, key);
     }
 
-    const field_proxy operator[](std::string key) const {
+    const field_proxy operator[](std::string_view key) const {
         if (!ptr_) {
             throw std::runtime_error("child_unique_ptr::operator[] const on null pointer");
         }
-        return field_proxy(const_cast<child_unique_ptr*>(this), std::move(key));
+        return field_proxy(const_cast<child_unique_ptr*>(this), key);
+    }
+
+    // Read-only access to the field storage (nullptr until a field is set)
+    const storage_type* fields() const noexcept {
+        return dyn_fields_.load();
     }
 
     // ---------------------------------------------------------
     // Dynamic functions: def / call / operator()
     // ---------------------------------------------------------
 private:
-    using dyn_fn_t = std::function<std::any(const std::vector<std::any>&)>;
-    using dyn_fn_map_t = std::unordered_map<std::string, dyn_fn_t>;
-    std::unique_ptr<dyn_fn_map_t> dyn_fns_;
+    using dyn_fn_entry = fn_detail::fn_entry;
+    struct fn_name_hash {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view s) const noexcept {
+            return hash_string(s);
+        }
+    };
+    using dyn_fn_map_t = std::unordered_map<std::string, std::shared_ptr<const dyn_fn_entry>,
+                                            fn_name_hash, std::equal_to<>>;
+    // concurrent: an immutable map replaced as a whole by def()
+    rcu_ptr<dyn_fn_map_t> dyn_fns_;
 
     dyn_fn_map_t& ensure_fns() {
         if (!dyn_fns_) {
-            dyn_fns_ = std::make_unique<dyn_fn_map_t>();
+            dyn_fns_.store(new dyn_fn_map_t);
         }
-        return *dyn_fns_;
+        return *dyn_fns_.load();
     }
 
     const dyn_fn_map_t* fns_or_null() const noexcept {
-        return dyn_fns_.get();
+        return dyn_fns_.load();
     }
 
-    template<typename R, typename... Args>
-    static std::any call_fn_from_anys(
-        const std::function<R(Args...)>& fn,
-        const std::vector<std::any>& args
-    ) {
-        if (args.size() != sizeof...(Args)) {
-            throw std::runtime_error("dynamic call: argument count mismatch");
+    void copy_dynamic_from(const child_unique_ptr& src) {
+        if (const dyn_field_map_t* f = src.fields_or_null()) {
+            dyn_fields_ = rcu_ptr<dyn_field_map_t>(new dyn_field_map_t(*f));
         }
-        return call_fn_from_anys_impl<R, Args...>(fn, args,
-                                                  std::index_sequence_for<Args...>{});
-    }
-
-    template<typename R, typename... Args, std::size_t... I>
-    static std::any call_fn_from_anys_impl(
-        const std::function<R(Args...)>& fn,
-        const std::vector<std::any>& args,
-        std::index_sequence<I...>
-    ) {
-        if constexpr (std::is_void_v<R>) {
-            fn(std::any_cast<Args>(args[I])...);
-            return std::any{};
+        auto copy_fns = [&] {
+            if (const dyn_fn_map_t* m = src.fns_or_null()) {
+                dyn_fns_ = rcu_ptr<dyn_fn_map_t>(new dyn_fn_map_t(*m));
+            }
+        };
+        if constexpr (concurrent) {
+            rcu_read_guard g;
+            copy_fns();
         } else {
-            return std::any(fn(std::any_cast<Args>(args[I])...));
+            copy_fns();
         }
     }
 
-public:
-    // Define a dynamic function:
-    //   ptr.def<R, Args...>("name", lambda);
-    template<typename R, typename... Args, typename F>
-    void def(const std::string& name, F&& f) {
-        std::function<R(Args...)> fn(std::forward<F>(f));
-        auto& m = ensure_fns();
-        m[name] = [fn = std::move(fn)](const std::vector<std::any>& a) -> std::any {
-            return call_fn_from_anys<R, Args...>(fn, a);
-        };
-    }
-
-    // Generic call: returns call_result (wraps std::any)
-    template<typename... Args>
-    call_result operator()(const std::string& name, Args&&... args) const {
+    const std::shared_ptr<const dyn_fn_entry>& find_fn(std::string_view name, const char* where) const {
         if (!ptr_) {
-            throw std::runtime_error("child_unique_ptr::operator(): null pointer");
+            throw std::runtime_error(std::string(where) + ": null pointer");
         }
         const dyn_fn_map_t* m = fns_or_null();
         if (!m) {
-            throw std::runtime_error("child_unique_ptr::operator(): no functions defined");
+            throw std::runtime_error(std::string(where) + ": no functions defined");
         }
         auto it = m->find(name);
         if (it == m->end()) {
-            throw std::runtime_error("child_unique_ptr::operator(): function not found: " + name);
+            throw std::runtime_error(std::string(where) + ": function not found: " + std::string(name));
+        }
+        return it->second;
+    }
+
+    // f(entry) while the entry is guaranteed to stay alive
+    template<typename F>
+    decltype(auto) with_fn(std::string_view name, const char* where, F&& f) const {
+        if constexpr (concurrent) {
+            rcu_read_guard g;
+            return std::forward<F>(f)(find_fn(name, where));
+        } else {
+            return std::forward<F>(f)(find_fn(name, where));
+        }
+    }
+
+public:
+    // Define a dynamic function:
+    //   ptr.def<R, Args...>("name", lambda);
+    //
+    // Returns a typed handle for direct calls (no name lookup, no
+    // std::any boxing); it stays valid if the name is later redefined
+    // or this pointer is destroyed.
+    template<typename R, typename... Args, typename F>
+    fn_handle<R(Args...)> def(const std::string& name, F&& f) {
+        auto entry = std::make_shared<const fn_detail::callable_fn_entry<std::decay_t<F>, R, Args...>>(
+            std::forward<F>(f));
+        if constexpr (concurrent) {
+            auto lk = rcu_writer_lock(&dyn_fns_);
+            const dyn_fn_map_t* cur = fns_or_null();
+            auto next = cur ? std::make_unique<dyn_fn_map_t>(*cur) : std::make_unique<dyn_fn_map_t>();
+            (*next)[name] = entry;
+            dyn_fns_.store(next.release());
+        } else {
+            ensure_fns()[name] = entry;
         }
+        return fn_handle<R(Args...)>{std::move(entry)};
+    }
 
-        std::vector<std::any> packed;
-        packed.reserve(sizeof...(Args));
-        (packed.emplace_back(std::forward<Args>(args)), ...);
+    // Look up a typed handle by name; the signature must match def()
+    //   auto area = ptr.fn<double(double, double)>("area");
+    template<typename Sig>
+    fn_handle<Sig> fn(std::string_view name) const {
+        return with_fn(name, "child_unique_ptr::fn()", [&](const std::shared_ptr<const dyn_fn_entry>& e) {
+            if (e->signature() != typeid(Sig)) {
+                throw std::runtime_error("child_unique_ptr::fn(): signature mismatch for " + std::string(name));
+            }
+            return fn_handle<Sig>{std::static_pointer_cast<const typename fn_handle<Sig>::entry_type>(e)};
+        });
+    }
 
-        std::any ret = it->second(packed);
-        return call_result(std::move(ret));
+    // Generic call: returns call_result (wraps std::any)
+    // Arguments are packed into a stack array, not a std::vector.
+    template<typename... Args>
+    call_result operator()(std::string_view name, Args&&... args) const {
+        return with_fn(name, "child_unique_ptr::operator()", [&](const std::shared_ptr<const dyn_fn_entry>& e) {
+            std::array<std::any, sizeof...(Args)> packed{std::any(std::forward<Args>(args))...};
+            return call_result(e->call_packed(packed.data(), packed.size()));
+        });
     }
 
     // Typed call convenience: like Java-style
     template<typename R, typename... Args>
-    R call(const std::string& name, Args&&... args) const {
+    R call(std::string_view name, Args&&... args) const {
         return (*this)(name, std::forward<Args>(args)...).template as<R>();
     }
 
@@ -385,31 +674,36 @@ public:
         } else if constexpr (requires(std::ostream& os, const T& t) {
             { os << t } -> std::same_as<std::ostream&>;
         }) {
-            std::ostringstream oss;
-            oss << *ptr_;
-            return oss.str();
+            stream_lease s;
+            s.stream() << *ptr_;
+            return s.str();
         } else {
-            std::ostringstream oss;
-            oss << "<" << typeid(T).name()
-                << " @" << static_cast<const void*>(ptr_) << ">";
-            return oss.str();
+            PYL_STATS_INC(to_text_typeid);
+            std::string s = "<";
+            s += type_name<T>();
+            s += " @";
+            append_address(s, ptr_);
+            s += '>';
+            return s;
         }
     }
 
     // No hash() call here (hash may fallback to full_string)
     std::string to_full_string() const {
-        std::ostringstream oss;
-        oss << "[" << typeid(T).name()
-            << " value=" << to_string();
+        std::string s = "[";
+        s += type_name<T>();
+        s += " value=";
+        s += to_string();
         if constexpr (std::is_base_of_v<Backtraceable<Parent>, T>) {
             if (ptr_ && ptr_->parent) {
-                oss << " parent@" << static_cast<const void*>(ptr_->parent);
+                s += " parent@";
+                append_address(s, ptr_->parent);
             } else {
-                oss << " parent=null";
+                s += " parent=null";
             }
         }
-        oss << "]";
-        return oss.str();
+        s += ']';
+        return s;
     }
 
     bool equals(const child_unique_ptr& other) const {
@@ -434,42 +728,47 @@ public:
         return equals(other);
     }
 
-    // hash():
-    //  - if T has hash(), use it
-    //  - else if std::hash<T> is valid, use that
-    //  - else: hash(to_full_string())
+    // hash() must agree with equals():
+    //  - if pyl::hash<T> works (T::hash(), std::hash<T>, object bytes,
+    //    to_string() contents, ...), hash the pointee
+    //  - T compared by equals()/== but not hashable: one hash per type
+    //    (correct, but every such key collides; give T a hash())
+    //  - else: pointer identity, matching the equals() fallback
     std::size_t hash() const {
         if (!ptr_) return 0u;
 
-        if constexpr (requires(const T& t) {
-            { t.hash() } -> std::convertible_to<std::size_t>;
-        }) {
-            return ptr_->hash();
-        } else if constexpr (requires(const T& t) {
-            { std::hash<T>{}(t) } -> std::convertible_to<std::size_t>;
+        if constexpr (hashable<T>) {
+            return pyl::hash<T>{}(*ptr_);
+        } else if constexpr (requires(const T& a, const T& b) {
+            { a.equals(b) } -> std::convertible_to<bool>;
+        } || requires(const T& a, const T& b) {
+            { a == b } -> std::convertible_to<bool>;
         }) {
-            return std::hash<T>{}(*ptr_);
+            return hash_string(type_name<T>());
         } else {
-            return std::hash<std::string>{}(to_full_string());
+            return hash_int(static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(ptr_)));
         }
     }
 
-    // full_copy() is the "real" deep-copy policy
+    // full_copy() is the "real" deep-copy policy. Dynamic fields and
+    // functions come along: the field storage is copied (O(1) with
+    // cow_field_storage, see pyl_cow.h) and function entries, which
+    // are immutable, are shared.
     child_unique_ptr full_copy() const {
-        if (!ptr_) {
-            return child_unique_ptr{parent_};
-        }
-
-        if constexpr (requires(const T& t) {
-            { t.clone() } -> std::same_as<std::unique_ptr<T>>;
-        }) {
-            auto up = ptr_->clone();
-            return child_unique_ptr{parent_, up.release()};
-        } else if constexpr (std::is_copy_constructible_v<T>) {
-            return child_unique_ptr{parent_, new T(*ptr_)};
-        } else {
-            throw std::logic_error("child_unique_ptr::full_copy(): T is not cloneable or copy-constructible");
+        child_unique_ptr out{parent_, nullptr, deleter_};
+        if (ptr_) {
+            if constexpr (requires(const T& t) {
+                { t.clone() } -> std::same_as<std::unique_ptr<T>>;
+            }) {
+                out.reset(ptr_->clone().release());
+            } else if constexpr (std::is_copy_constructible_v<T>) {
+                out.emplace(*ptr_);
+            } else {
+                throw std::logic_error("child_unique_ptr::full_copy(): T is not cloneable or copy-constructible");
+            }
         }
+        out.copy_dynamic_from(*this);
+        return out;
     }
 
     // copy() just delegates to full_copy()
@@ -503,7 +802,13 @@ private:
     pointer ptr_      = nullptr;  // owned
     Deleter deleter_{};
 
-    static bool would_create_cycle(pointer child, Parent* new_parent) noexcept {
+    static constexpr bool tracks_children = std::is_base_of_v<TrackedBacktraceable<Parent>, Parent>;
+
+    static bool would_create_cycle([[maybe_unused]] pointer child,
+                                   [[maybe_unused]] Parent* new_parent) noexcept {
+#ifdef PYL_DISABLE_CYCLE_CHECK
+        return false;
+#else
         if constexpr (!std::is_base_of_v<Backtraceable<Parent>, T>) {
             return false;
         } else if constexpr (!std::is_base_of_v<Parent, T>) {
@@ -511,25 +816,43 @@ private:
             return false;
         } else {
             auto* as_parent = static_cast<Parent*>(child);
+            if constexpr (tracks_children) {
+                // a leaf is nobody's ancestor
+                if (as_parent->child_count == 0) {
+                    return as_parent == new_parent;
+                }
+            }
+            PYL_STATS_INC(cycle_check);
+            [[maybe_unused]] std::size_t depth = 0;
             for (Parent* cur = new_parent; cur; cur = cur->parent) {
+                ++depth;
                 if (cur == as_parent) {
+                    PYL_STATS_RECORD(cycle_walk_depth, depth);
                     return true;
                 }
             }
+            PYL_STATS_RECORD(cycle_walk_depth, depth);
             return false;
         }
+#endif
     }
 
     void set_parent_on_child() noexcept {
         if (!ptr_) return;
         if constexpr (std::is_base_of_v<Backtraceable<Parent>, T>) {
             ptr_->parent = parent_;
+            if constexpr (tracks_children) {
+                if (parent_) ++parent_->child_count;
+            }
         }
     }
 
     void clear_parent_on_child() noexcept {
         if (!ptr_) return;
         if constexpr (std::is_base_of_v<Backtraceable<Parent>, T>) {
+            if constexpr (tracks_children) {
+                if (ptr_->parent) --ptr_->parent->child_count;
+            }
             ptr_->parent = nullptr;
         }
     }
@@ -556,6 +879,15 @@ make_child_unique_ptr(Parent* parent, Args&&... args) {
     return tmp;
 }
 
+// Allocate the child from `resource` (see pmr_deleter / child_arena)
+template<typename Parent, typename T = Parent, typename... Args>
+child_unique_ptr<Parent, T, pmr_deleter<T>>
+make_child_unique_ptr_in(std::pmr::memory_resource& resource, Parent* parent, Args&&... args) {
+    child_unique_ptr<Parent, T, pmr_deleter<T>> tmp{parent, nullptr, pmr_deleter<T>{&resource}};
+    tmp.emplace(std::forward<Args>(args)...);
+    return tmp;
+}
+
 } // namespace pyl
 
 // -------------------------------------------------------------
@@ -566,13 +898,13 @@ make_child_unique_ptr(Parent* parent, Args&&... args) {
 
 namespace pyl {
 
-template<typename Parent, typename T, typename Deleter>
-Text child_unique_ptr<Parent, T, Deleter>::to_text() const {
+template<typename Parent, typename T, typename Deleter, field_storage FieldStorage>
+Text child_unique_ptr<Parent, T, Deleter, FieldStorage>::to_text() const {
     return Text{to_string()};
 }
 
-template<typename Parent, typename T, typename Deleter>
-Text child_unique_ptr<Parent, T, Deleter>::to_full_text() const {
+template<typename Parent, typename T, typename Deleter, field_storage FieldStorage>
+Text child_unique_ptr<Parent, T, Deleter, FieldStorage>::to_full_text() const {
     return Text{to_full_string()};
 }
 
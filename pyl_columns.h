@@ -0,0 +1,238 @@
+#pragma once
+
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <numeric>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "pyl_ranges.h"
+
+namespace pyl {
+
+// ---------------------------------------------------------
+// columns<K, V> – pair-like data stored as two contiguous arrays
+//
+// Usage:
+//   pyl::columns<std::uint64_t, double> prices(price_map);   // from any pair range
+//   prices.emplace_back(42, 9.5);
+//
+//   double total = pyl::sum(pyl::par_unseq, pyl::values(prices));  // contiguous span
+//   for (auto [k, v] : prices) v *= 1.1;                           // proxy pairs
+//   auto hot = prices | IF(k, v, v > 100.0) | MAP(k, v, k);
+//
+// The elements are proxies derived from std::pair<const K&, V&>
+// (std::get and structured bindings work as usual), so columns model
+// PairLikeRange (random access) and work with the IF / MAP / ENUM
+// pair forms. keys() / values() return std::span over the separate
+// arrays: aggregating one column never pulls the other into cache,
+// and the contiguous reduce / sum kernels take the span directly.
+// Keys are read-only through the range, like std::map's.
+// ---------------------------------------------------------
+
+namespace columns_detail {
+
+// Element proxy: a pair of references into the key and value columns.
+// A distinct type (rather than a plain std::pair of references) so the
+// iterators can declare a common reference with std::pair<K, V>.
+template <class KRef, class VRef>
+struct column_ref : std::pair<KRef, VRef> {
+    column_ref(KRef k, VRef v) noexcept : std::pair<KRef, VRef>(k, v) {}
+};
+
+} // namespace columns_detail
+
+template <class K, class V>
+class columns {
+    static_assert(!std::is_same_v<K, bool> && !std::is_same_v<V, bool>,
+                  "columns<K, V>: std::vector<bool> cannot be viewed as a span");
+
+    template <bool Const>
+    class iterator_t {
+        using value_ptr = std::conditional_t<Const, const V*, V*>;
+
+    public:
+        using iterator_concept  = std::random_access_iterator_tag;
+        using iterator_category = std::input_iterator_tag;   // proxy references
+        using value_type        = std::pair<K, V>;
+        using difference_type   = std::ptrdiff_t;
+        using reference         = columns_detail::column_ref<const K&, std::conditional_t<Const, const V&, V&>>;
+
+        iterator_t() = default;
+        iterator_t(const K* k, value_ptr v) noexcept : k_(k), v_(v) {}
+
+        // iterator -> const_iterator
+        iterator_t(const iterator_t<!Const>& other) noexcept
+            requires Const
+            : k_(other.k_), v_(other.v_) {}
+
+        reference operator*() const noexcept { return reference(*k_, *v_); }
+        reference operator[](difference_type n) const noexcept { return reference(k_[n], v_[n]); }
+
+        iterator_t& operator++() noexcept { ++k_; ++v_; return *this; }
+        iterator_t operator++(int) noexcept { auto t = *this; ++*this; return t; }
+        iterator_t& operator--() noexcept { --k_; --v_; return *this; }
+        iterator_t operator--(int) noexcept { auto t = *this; --*this; return t; }
+
+        iterator_t& operator+=(difference_type n) noexcept { k_ += n; v_ += n; return *this; }
+        iterator_t& operator-=(difference_type n) noexcept { k_ -= n; v_ -= n; return *this; }
+
+        friend iterator_t operator+(iterator_t it, difference_type n) noexcept { return it += n; }
+        friend iterator_t operator+(difference_type n, iterator_t it) noexcept { return it += n; }
+        friend iterator_t operator-(iterator_t it, difference_type n) noexcept { return it -= n; }
+        friend difference_type operator-(const iterator_t& a, const iterator_t& b) noexcept {
+            return a.k_ - b.k_;
+        }
+
+        friend bool operator==(const iterator_t& a, const iterator_t& b) noexcept { return a.k_ == b.k_; }
+        friend auto operator<=>(const iterator_t& a, const iterator_t& b) noexcept { return a.k_ <=> b.k_; }
+
+    private:
+        friend class iterator_t<!Const>;
+
+        const K* k_ = nullptr;
+        value_ptr v_ = nullptr;
+    };
+
+public:
+    using key_type        = K;
+    using mapped_type     = V;
+    using value_type      = std::pair<K, V>;
+    using size_type       = std::size_t;
+    using reference       = columns_detail::column_ref<const K&, V&>;
+    using const_reference = columns_detail::column_ref<const K&, const V&>;
+    using iterator        = iterator_t<false>;
+    using const_iterator  = iterator_t<true>;
+
+    columns() = default;
+
+    columns(std::initializer_list<value_type> init) {
+        reserve(init.size());
+        for (const auto& [k, v] : init) emplace_back(k, v);
+    }
+
+    // Copy any pair-like range (std::map, vector<pair>, kv_view, ...)
+    template <PairLikeRange R>
+        requires (!std::is_same_v<std::remove_cvref_t<R>, columns>)
+    explicit columns(R&& r) {
+        if constexpr (std::ranges::sized_range<R>) {
+            reserve(static_cast<std::size_t>(std::ranges::size(r)));
+        }
+        for (auto&& kv : r) emplace_back(std::get<0>(kv), std::get<1>(kv));
+    }
+
+    std::size_t size() const noexcept { return keys_.size(); }
+    bool empty() const noexcept { return keys_.empty(); }
+
+    void reserve(std::size_t n) {
+        keys_.reserve(n);
+        values_.reserve(n);
+    }
+
+    void clear() noexcept {
+        keys_.clear();
+        values_.clear();
+    }
+
+    template <class KK, class VV>
+    reference emplace_back(KK&& k, VV&& v) {
+        keys_.emplace_back(std::forward<KK>(k));
+        try {
+            values_.emplace_back(std::forward<VV>(v));
+        } catch (...) {
+            keys_.pop_back();   // keep both columns the same length
+            throw;
+        }
+        return reference(keys_.back(), values_.back());
+    }
+
+    void push_back(const value_type& kv) { emplace_back(kv.first, kv.second); }
+    void push_back(value_type&& kv) { emplace_back(std::move(kv.first), std::move(kv.second)); }
+
+    reference operator[](std::size_t i) noexcept { return reference(keys_[i], values_[i]); }
+    const_reference operator[](std::size_t i) const noexcept { return const_reference(keys_[i], values_[i]); }
+
+    const K& key(std::size_t i) const noexcept { return keys_[i]; }
+    V& value(std::size_t i) noexcept { return values_[i]; }
+    const V& value(std::size_t i) const noexcept { return values_[i]; }
+
+    // The columns themselves
+    std::span<const K> keys() const noexcept { return keys_; }
+    std::span<V> values() noexcept { return values_; }
+    std::span<const V> values() const noexcept { return values_; }
+
+    iterator begin() noexcept { return iterator(keys_.data(), values_.data()); }
+    iterator end() noexcept { return iterator(keys_.data() + size(), values_.data() + size()); }
+    const_iterator begin() const noexcept { return const_iterator(keys_.data(), values_.data()); }
+    const_iterator end() const noexcept { return const_iterator(keys_.data() + size(), values_.data() + size()); }
+
+    // Reorder both columns by key (stable), e.g. before a binary search
+    void sort_by_key() {
+        std::vector<std::size_t> order(size());
+        std::iota(order.begin(), order.end(), std::size_t{0});
+        std::stable_sort(order.begin(), order.end(),
+                         [&](std::size_t a, std::size_t b) { return keys_[a] < keys_[b]; });
+        keys_   = permuted(keys_, order);
+        values_ = permuted(values_, order);
+    }
+
+    friend bool operator==(const columns&, const columns&) = default;
+
+private:
+    template <class T>
+    static std::vector<T> permuted(std::vector<T>& src, const std::vector<std::size_t>& order) {
+        std::vector<T> out;
+        out.reserve(src.size());
+        for (std::size_t i : order) out.push_back(std::move(src[i]));
+        return out;
+    }
+
+    std::vector<K> keys_;
+    std::vector<V> values_;
+};
+
+// keys(c) / values(c) for columns are the underlying spans (more
+// specialized than the generic transform views). Temporaries are
+// rejected: the span would outlive its storage.
+template <class K, class V>
+std::span<const K> keys(const columns<K, V>& c) noexcept { return c.keys(); }
+template <class K, class V>
+std::span<const K> keys(columns<K, V>& c) noexcept { return c.keys(); }
+template <class K, class V>
+void keys(columns<K, V>&&) = delete;
+
+template <class K, class V>
+std::span<V> values(columns<K, V>& c) noexcept { return c.values(); }
+template <class K, class V>
+std::span<const V> values(const columns<K, V>& c) noexcept { return c.values(); }
+template <class K, class V>
+void values(columns<K, V>&&) = delete;
+
+} // namespace pyl
+
+// Tuple protocol and common reference for the element proxy
+template <class KRef, class VRef>
+struct std::tuple_size<pyl::columns_detail::column_ref<KRef, VRef>>
+    : std::integral_constant<std::size_t, 2> {};
+
+template <std::size_t I, class KRef, class VRef>
+struct std::tuple_element<I, pyl::columns_detail::column_ref<KRef, VRef>>
+    : std::tuple_element<I, std::pair<KRef, VRef>> {};
+
+template <class KRef, class VRef, class K, class V,
+          template <class> class TQual, template <class> class UQual>
+struct std::basic_common_reference<pyl::columns_detail::column_ref<KRef, VRef>, std::pair<K, V>, TQual, UQual> {
+    using type = std::pair<K, V>;
+};
+
+template <class K, class V, class KRef, class VRef,
+          template <class> class TQual, template <class> class UQual>
+struct std::basic_common_reference<std::pair<K, V>, pyl::columns_detail::column_ref<KRef, VRef>, TQual, UQual> {
+    using type = std::pair<K, V>;
+};
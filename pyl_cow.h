@@ -0,0 +1,316 @@
+#pragma once
+
+#include <any>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "pyl_field_storage.h"
+
+namespace pyl {
+
+// ---------------------------------------------------------
+// Copy-on-write sharing
+//
+//   cow_ptr<T>              – shared, immutable-until-written node handle;
+//                             copying is O(1), write() clones the node
+//                             only while it is shared
+//   cow_field_storage<S>    – field storage policy whose copies share
+//                             one S until a side writes
+//
+// Persistent trees: give nodes cow_ptr children. A copy of the root is
+// a snapshot; writing through a path clones just that path, every
+// untouched subtree (and its dynamic fields) stays shared.
+//
+//   struct Config {
+//       int limit = 0;
+//       pyl::cow_ptr<Config> left, right;
+//   };
+//   auto live = pyl::make_cow<Config>();
+//   auto snap = live;                          // per-request snapshot
+//   live.write().left.write().limit = 5;       // clones root and left
+//   REQUIRE(live->right.shares_with(snap->right));
+//
+// Handles behave like std::shared_ptr: distinct handles may be used
+// from different threads; one handle is not synchronized. Publish a
+// new root to readers through an rcu_ptr (pyl_rcu.h) or a mutex.
+// ---------------------------------------------------------
+
+namespace cow_detail {
+
+// Intrusively counted block; write() detaches while shared
+template<typename T>
+class handle {
+    struct block {
+        std::atomic<std::size_t> refs{1};
+        T value;
+
+        template<typename... Args>
+        explicit block(std::in_place_t, Args&&... args) : value(std::forward<Args>(args)...) {}
+    };
+
+public:
+    handle() noexcept = default;
+
+    template<typename... Args>
+    static handle make(Args&&... args) {
+        handle h;
+        h.b_ = new block(std::in_place, std::forward<Args>(args)...);
+        return h;
+    }
+
+    handle(const handle& other) noexcept : b_(other.b_) {
+        if (b_) b_->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+    handle& operator=(const handle& other) noexcept {
+        handle(other).swap(*this);
+        return *this;
+    }
+
+    handle(handle&& other) noexcept : b_(std::exchange(other.b_, nullptr)) {}
+    handle& operator=(handle&& other) noexcept {
+        handle(std::move(other)).swap(*this);
+        return *this;
+    }
+
+    ~handle() { release(); }
+
+    const T* get() const noexcept { return b_ ? &b_->value : nullptr; }
+    explicit operator bool() const noexcept { return b_ != nullptr; }
+
+    // acquire: a count of 1 also means every other owner's reads
+    // happened before their release
+    std::size_t use_count() const noexcept {
+        return b_ ? b_->refs.load(std::memory_order_acquire) : 0;
+    }
+
+    bool same(const handle& other) const noexcept { return b_ == other.b_; }
+
+    // Precondition: non-null
+    T& write() {
+        if (b_->refs.load(std::memory_order_acquire) != 1) {
+            block* copy = new block(std::in_place, std::as_const(b_->value));
+            release();
+            b_ = copy;
+        }
+        return b_->value;
+    }
+
+    void reset() noexcept {
+        release();
+        b_ = nullptr;
+    }
+
+    void swap(handle& other) noexcept { std::swap(b_, other.b_); }
+
+private:
+    block* b_ = nullptr;
+
+    void release() noexcept {
+        if (b_ && b_->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            delete b_;
+        }
+    }
+};
+
+} // namespace cow_detail
+
+// ---------------------------------------------------------
+// cow_field_storage – shares the inner storage between copies; the
+// first mutation on a shared copy clones it. As a child_unique_ptr
+// policy it makes full_copy() O(1) for dynamic fields.
+// ---------------------------------------------------------
+template<field_storage Inner = flat_field_storage<>>
+class cow_field_storage {
+public:
+    const std::any* find(std::string_view key) const noexcept {
+        const Inner* s = inner_.get();
+        return s ? s->find(key) : nullptr;
+    }
+
+    // mutable access detaches
+    std::any* find(std::string_view key) {
+        if (!std::as_const(*this).find(key)) return nullptr;
+        return inner_.write().find(key);
+    }
+
+    std::any& get_or_insert(std::string_view key) {
+        if (!inner_) inner_ = cow_detail::handle<Inner>::make();
+        return inner_.write().get_or_insert(key);
+    }
+
+    bool erase(std::string_view key) {
+        if (!std::as_const(*this).find(key)) return false;
+        return inner_.write().erase(key);
+    }
+
+    std::size_t size() const noexcept {
+        const Inner* s = inner_.get();
+        return s ? static_cast<std::size_t>(s->size()) : 0u;
+    }
+    bool empty() const noexcept { return size() == 0; }
+    void clear() noexcept { inner_.reset(); }
+
+    template<typename F>
+    void for_each(F&& f) const {
+        if (const Inner* s = inner_.get()) s->for_each(std::forward<F>(f));
+    }
+
+    bool shares_with(const cow_field_storage& other) const noexcept {
+        return inner_ && inner_.same(other.inner_);
+    }
+
+private:
+    cow_detail::handle<Inner> inner_;
+};
+
+// ---------------------------------------------------------
+// cow_ptr<T, FieldStorage> – copy-on-write node handle
+//
+// Reads go through const access (operator->, operator*, get());
+// write() returns a mutable T&, cloning the node first if another
+// handle shares it. T's copy constructor is the clone, so children
+// held as cow_ptr are shared, not copied. Dynamic fields
+// (p["key"] = v) belong to the handle, as with child_unique_ptr, and
+// are shared with its copies in the same way.
+// ---------------------------------------------------------
+template<typename T, field_storage FieldStorage = flat_field_storage<>>
+class cow_ptr {
+public:
+    using element_type = T;
+    using storage_type = cow_field_storage<FieldStorage>;
+
+    constexpr cow_ptr() noexcept = default;
+    constexpr cow_ptr(std::nullptr_t) noexcept {}
+
+    template<typename... Args>
+    static cow_ptr make(Args&&... args) {
+        cow_ptr p;
+        p.node_ = cow_detail::handle<T>::make(std::forward<Args>(args)...);
+        return p;
+    }
+
+    const T* get() const noexcept { return node_.get(); }
+    const T& operator*() const noexcept { return *node_.get(); }
+    const T* operator->() const noexcept { return node_.get(); }
+    explicit operator bool() const noexcept { return static_cast<bool>(node_); }
+
+    T& write() {
+        if (!node_) {
+            throw std::runtime_error("cow_ptr::write() on null pointer");
+        }
+        return node_.write();
+    }
+
+    // p.update([](T& t) { ... });
+    template<typename F>
+    decltype(auto) update(F&& f) {
+        return std::invoke(std::forward<F>(f), write());
+    }
+
+    std::size_t use_count() const noexcept { return node_.use_count(); }
+    bool shares_with(const cow_ptr& other) const noexcept {
+        return node_ && node_.same(other.node_);
+    }
+
+    void reset() noexcept {
+        node_.reset();
+        fields_.clear();
+    }
+
+    // ---------------------------------------------------------
+    // Dynamic fields: p["key"] = v detaches only the field map
+    // ---------------------------------------------------------
+    class field_proxy {
+    public:
+        field_proxy(cow_ptr* owner, std::string_view key)
+            : owner_(owner), key_(key) {}
+
+        template<typename U>
+        field_proxy& operator=(U&& value) {
+            owner_->fields_.get_or_insert(key_) = std::any(std::forward<U>(value));
+            return *this;
+        }
+
+        template<typename U>
+        operator U() const {
+            return as<U>();
+        }
+
+        template<typename U>
+        U as() const {
+            const std::any* v = std::as_const(owner_->fields_).find(key_);
+            if (!v) {
+                throw std::runtime_error("cow_ptr: key not found: " + std::string(key_));
+            }
+            return std::any_cast<U>(*v);
+        }
+
+        bool exists() const {
+            return std::as_const(owner_->fields_).find(key_) != nullptr;
+        }
+
+    private:
+        cow_ptr* owner_;
+        std::string key_;
+    };
+
+    field_proxy operator[](std::string_view key) {
+        if (!node_) {
+            throw std::runtime_error("cow_ptr::operator[] on null pointer");
+        }
+        return field_proxy(this, key);
+    }
+
+    // the proxy is only read from (const)
+    const field_proxy operator[](std::string_view key) const {
+        if (!node_) {
+            throw std::runtime_error("cow_ptr::operator[] const on null pointer");
+        }
+        return field_proxy(const_cast<cow_ptr*>(this), key);
+    }
+
+    // nullptr until a field is set
+    const storage_type* fields() const noexcept {
+        return fields_.empty() ? nullptr : &fields_;
+    }
+
+    // ---------------------------------------------------------
+    // Service-style helpers
+    // ---------------------------------------------------------
+    bool equals(const cow_ptr& other) const {
+        if (node_.same(other.node_)) return true;
+        if (!node_ || !other.node_) return false;
+        if constexpr (std::equality_comparable<T>) {
+            return *get() == *other.get();
+        } else {
+            return false;
+        }
+    }
+
+    bool full_equals(const cow_ptr& other) const {
+        return equals(other);
+    }
+
+    // Copies are already independent for every observer: full_copy()
+    // is the O(1) shared copy (clones happen lazily on write)
+    cow_ptr full_copy() const { return *this; }
+    cow_ptr copy() const { return *this; }
+
+private:
+    cow_detail::handle<T> node_;
+    storage_type fields_;
+};
+
+template<typename T, field_storage FieldStorage = flat_field_storage<>, typename... Args>
+cow_ptr<T, FieldStorage> make_cow(Args&&... args) {
+    return cow_ptr<T, FieldStorage>::make(std::forward<Args>(args)...);
+}
+
+} // namespace pyl
@@ -0,0 +1,330 @@
+#include "pyl_executor.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace pyl {
+
+// ===================== CPU topology =====================
+
+namespace {
+
+struct cpu_topology {
+    std::vector<int> cpus;    // usable logical CPUs, grouped by node
+    std::vector<int> nodes;   // NUMA node of cpus[i]
+    std::size_t node_count = 1;
+};
+
+// "0-3,8-11" -> 0 1 2 3 8 9 10 11
+std::vector<int> parse_cpulist(const std::string& s) {
+    std::vector<int> out;
+    std::size_t i = 0;
+    auto number = [&] {
+        int v = 0;
+        while (i < s.size() && s[i] >= '0' && s[i] <= '9') v = v * 10 + (s[i++] - '0');
+        return v;
+    };
+    while (i < s.size() && s[i] >= '0' && s[i] <= '9') {
+        int lo = number();
+        int hi = lo;
+        if (i < s.size() && s[i] == '-') {
+            ++i;
+            hi = number();
+        }
+        for (int c = lo; c <= hi; ++c) out.push_back(c);
+        if (i < s.size() && s[i] == ',') ++i;
+    }
+    return out;
+}
+
+cpu_topology detect_topology() {
+    cpu_topology t;
+#if defined(__linux__)
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    bool have_mask = sched_getaffinity(0, sizeof(allowed), &allowed) == 0;
+
+    std::size_t nodes_seen = 0;
+    for (int node = 0; node < 64; ++node) {
+        std::ifstream in("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+        std::string list;
+        if (!in || !std::getline(in, list)) continue;
+        bool any = false;
+        for (int cpu : parse_cpulist(list)) {
+            if (have_mask && (cpu >= CPU_SETSIZE || !CPU_ISSET(static_cast<std::size_t>(cpu), &allowed))) continue;
+            t.cpus.push_back(cpu);
+            t.nodes.push_back(node);
+            any = true;
+        }
+        if (any) ++nodes_seen;
+    }
+
+    if (t.cpus.empty() && have_mask) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(static_cast<std::size_t>(cpu), &allowed)) {
+                t.cpus.push_back(cpu);
+                t.nodes.push_back(0);
+            }
+        }
+        nodes_seen = 1;
+    }
+    t.node_count = std::max<std::size_t>(1, nodes_seen);
+#endif
+    if (t.cpus.empty()) {
+        unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+        for (unsigned c = 0; c < hw; ++c) {
+            t.cpus.push_back(static_cast<int>(c));
+            t.nodes.push_back(0);
+        }
+    }
+    return t;
+}
+
+const cpu_topology& topology() {
+    static const cpu_topology t = detect_topology();
+    return t;
+}
+
+} // namespace
+
+// ===================== executor =====================
+
+struct executor::Impl {
+    // One slice of a bulk call's index space; the owner and thieves all
+    // claim indices from the front
+    struct alignas(64) slice {
+        std::atomic<std::size_t> next{0};
+        std::size_t end = 0;
+    };
+
+    struct job {
+        job(std::size_t n, bulk_task t, std::size_t parts)
+            : task(t), slices(parts), slice_list(new slice[parts]) {
+            const std::size_t base = n / parts, extra = n % parts;
+            auto start = [&](std::size_t k) { return k * base + std::min(k, extra); };
+            for (std::size_t k = 0; k < parts; ++k) {
+                slice_list[k].next.store(start(k), std::memory_order_relaxed);
+                slice_list[k].end = start(k + 1);
+            }
+        }
+
+        bulk_task task;
+        std::size_t slices;
+        std::unique_ptr<slice[]> slice_list;
+
+        std::atomic<bool> failed{false};
+        std::mutex error_mutex;
+        std::exception_ptr error;
+
+        // guarded by Impl::mutex
+        std::size_t users = 0;    // workers currently inside run()
+        bool exhausted = false;   // a full pass found nothing left to claim
+    };
+
+    explicit Impl(executor_options options);
+    ~Impl();
+
+    void worker_loop(std::size_t slot);
+    void run(job& j, std::size_t slot);
+    job* find_job();
+
+    std::size_t threads = 1;              // workers + the caller
+    std::size_t node_count = 1;
+    std::vector<std::vector<std::size_t>> steal_order;   // per slot
+
+    std::mutex mutex;
+    std::condition_variable work_cv;
+    std::condition_variable done_cv;
+    std::vector<job*> jobs;
+    bool stop = false;
+    std::vector<std::thread> workers;
+};
+
+namespace {
+
+// Executor whose worker is the current thread (nested bulk runs inline):
+// set for a worker's lifetime and for a caller's own share of a bulk
+thread_local const void* tls_executor = nullptr;
+
+struct executor_scope {
+    explicit executor_scope(const void* e) noexcept : previous(tls_executor) { tls_executor = e; }
+    ~executor_scope() { tls_executor = previous; }
+    executor_scope(const executor_scope&) = delete;
+    executor_scope& operator=(const executor_scope&) = delete;
+
+    const void* previous;
+};
+
+} // namespace
+
+executor::Impl::Impl(executor_options options) {
+    const cpu_topology& topo = topology();
+    threads = options.threads ? options.threads : topo.cpus.size();
+    threads = std::max<std::size_t>(1, threads);
+    node_count = topo.node_count;
+
+    // slot s (0 = caller, s = worker s - 1) sits on CPU cpus[s % ncpu]
+    auto node_of = [&](std::size_t s) { return topo.nodes[s % topo.cpus.size()]; };
+
+    // Steal order: same node first, then the rest; ring order within each
+    steal_order.resize(threads);
+    for (std::size_t s = 0; s < threads; ++s) {
+        for (int pass = 0; pass < 2; ++pass) {
+            for (std::size_t d = 1; d < threads; ++d) {
+                std::size_t victim = (s + d) % threads;
+                if ((node_of(victim) == node_of(s)) == (pass == 0)) steal_order[s].push_back(victim);
+            }
+        }
+    }
+
+    workers.reserve(threads - 1);
+    for (std::size_t slot = 1; slot < threads; ++slot) {
+        workers.emplace_back([this, slot, pin = options.pin_threads, cpu = topo.cpus[slot % topo.cpus.size()]] {
+#if defined(__linux__)
+            if (pin) {
+                cpu_set_t set;
+                CPU_ZERO(&set);
+                CPU_SET(static_cast<std::size_t>(cpu), &set);
+                pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+            }
+#else
+            (void)pin;
+            (void)cpu;
+#endif
+            worker_loop(slot);
+        });
+    }
+}
+
+executor::Impl::~Impl() {
+    {
+        std::lock_guard<std::mutex> lk(mutex);
+        stop = true;
+    }
+    work_cv.notify_all();
+    for (auto& t : workers) t.join();
+}
+
+executor::Impl::job* executor::Impl::find_job() {
+    for (job* j : jobs) {
+        if (!j->exhausted) return j;
+    }
+    return nullptr;
+}
+
+void executor::Impl::run(job& j, std::size_t slot) {
+    // Slices only ever shrink, so one pass over all of them is enough
+    auto drain = [&](std::size_t k) {
+        slice& sl = j.slice_list[k];
+        while (!j.failed.load(std::memory_order_relaxed)) {
+            std::size_t i = sl.next.fetch_add(1, std::memory_order_relaxed);
+            if (i >= sl.end) return;
+            try {
+                j.task(i);
+            } catch (...) {
+                std::lock_guard<std::mutex> lk(j.error_mutex);
+                if (!j.error) j.error = std::current_exception();
+                j.failed.store(true, std::memory_order_relaxed);
+            }
+        }
+    };
+
+    if (slot < j.slices) drain(slot);
+    for (std::size_t victim : steal_order[slot]) {
+        if (victim < j.slices) drain(victim);
+    }
+}
+
+void executor::Impl::worker_loop(std::size_t slot) {
+    tls_executor = this;
+    std::unique_lock<std::mutex> lk(mutex);
+    for (;;) {
+        work_cv.wait(lk, [&] { return stop || find_job() != nullptr; });
+        if (stop) return;
+
+        job* j = find_job();
+        ++j->users;
+        lk.unlock();
+        run(*j, slot);
+        lk.lock();
+        j->exhausted = true;
+        if (--j->users == 0) done_cv.notify_all();
+    }
+}
+
+executor::executor() : executor(executor_options{}) {}
+
+executor::executor(executor_options options) : impl_(std::make_unique<Impl>(options)) {}
+
+executor::~executor() = default;
+
+void executor::bulk(std::size_t n, bulk_task task) {
+    if (n == 0) return;
+    if (n == 1 || impl_->workers.empty() || tls_executor == impl_.get()) {
+        for (std::size_t i = 0; i < n; ++i) task(i);
+        return;
+    }
+
+    Impl::job j(n, task, std::min(n, impl_->threads));
+    {
+        std::lock_guard<std::mutex> lk(impl_->mutex);
+        impl_->jobs.push_back(&j);
+    }
+    impl_->work_cv.notify_all();
+
+    {
+        executor_scope scope(impl_.get());
+        impl_->run(j, 0);
+    }
+
+    {
+        std::unique_lock<std::mutex> lk(impl_->mutex);
+        j.exhausted = true;
+        std::erase(impl_->jobs, &j);
+        impl_->done_cv.wait(lk, [&] { return j.users == 0; });
+    }
+    if (j.error) std::rethrow_exception(j.error);
+}
+
+std::size_t executor::concurrency() const noexcept {
+    return impl_->threads;
+}
+
+std::size_t executor::numa_nodes() const noexcept {
+    return impl_->node_count;
+}
+
+// ===================== Default / global scheduler =====================
+
+executor& default_executor() {
+    static executor* e = new executor;   // leaked: may be used during exit
+    return *e;
+}
+
+namespace {
+
+std::atomic<scheduler*> g_scheduler{nullptr};
+
+} // namespace
+
+scheduler& current_scheduler() noexcept {
+    scheduler* s = g_scheduler.load(std::memory_order_acquire);
+    return s ? *s : default_executor();
+}
+
+scheduler* set_scheduler(scheduler* s) noexcept {
+    return g_scheduler.exchange(s, std::memory_order_acq_rel);
+}
+
+} // namespace pyl
@@ -0,0 +1,236 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace pyl {
+
+// ---------------------------------------------------------
+// executor – one shared work-stealing pool for all parallel helpers
+//
+// Usage:
+//   pyl::parallel_for(0, n, [&](std::size_t b, std::size_t e) { ... });
+//   pyl::parallel_for(rows, [](Row& r) { r.normalize(); }, 1024);
+//   auto total = pyl::parallel_reduce(v, 0LL, std::plus<>{});
+//
+//   pyl::executor pool({.threads = 4});      // a private pool
+//   pyl::set_scheduler(&pool);               // ... used by pyl::par too
+//   pyl::set_scheduler(nullptr);             // back to the default pool
+//
+// The default executor starts lazily with one thread per CPU the process
+// may run on (the caller is one of them), so nested or concurrent pyl
+// algorithms never oversubscribe the machine. Each bulk call splits its
+// tasks into one contiguous slice per thread; a thread drains its own
+// slice, then steals from the others, trying threads on its own NUMA
+// node first.
+//
+// Other thread pools plug in by implementing pyl::scheduler.
+// ---------------------------------------------------------
+
+// Non-owning reference to a `void(std::size_t)` callable
+class bulk_task {
+public:
+    template <class F>
+        requires (!std::is_same_v<std::remove_cvref_t<F>, bulk_task>) &&
+                 std::is_invocable_v<F&, std::size_t>
+    bulk_task(F& f) noexcept
+        : obj_(const_cast<void*>(static_cast<const void*>(std::addressof(f)))),
+          call_([](void* o, std::size_t i) { (*static_cast<F*>(o))(i); }) {}
+
+    void operator()(std::size_t i) const { call_(obj_, i); }
+
+private:
+    void* obj_;
+    void (*call_)(void*, std::size_t);
+};
+
+class scheduler {
+public:
+    virtual ~scheduler() = default;
+
+    // Run task(i) for every i in [0, n) and return once all have finished.
+    // The first exception thrown by a task is rethrown here; tasks not yet
+    // started at that point may be skipped.
+    virtual void bulk(std::size_t n, bulk_task task) = 0;
+
+    // Number of threads that may run tasks at the same time
+    virtual std::size_t concurrency() const noexcept = 0;
+};
+
+// Runs every task on the calling thread, in order (tests, debugging)
+class inline_scheduler final : public scheduler {
+public:
+    void bulk(std::size_t n, bulk_task task) override {
+        for (std::size_t i = 0; i < n; ++i) task(i);
+    }
+    std::size_t concurrency() const noexcept override { return 1; }
+};
+
+struct executor_options {
+    std::size_t threads = 0;   // total, including the caller; 0 = one per CPU
+    bool pin_threads = false;  // bind each worker to one CPU (Linux)
+};
+
+class executor final : public scheduler {
+public:
+    executor();
+    explicit executor(executor_options options);
+    ~executor() override;   // joins the workers; no bulk() may be running
+
+    executor(const executor&)            = delete;
+    executor& operator=(const executor&) = delete;
+
+    // Calls from inside one of this executor's tasks run sequentially
+    void bulk(std::size_t n, bulk_task task) override;
+    std::size_t concurrency() const noexcept override;
+
+    // NUMA nodes seen by the steal order (1 when unknown)
+    std::size_t numa_nodes() const noexcept;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+// Process-wide pool (started on first use, never destroyed)
+executor& default_executor();
+
+// Scheduler used by parallel_for / parallel_reduce and pyl::par; never null
+scheduler& current_scheduler() noexcept;
+
+// Install a scheduler (nullptr restores the default executor); returns the
+// previous one. The scheduler is not owned and must outlive its use.
+scheduler* set_scheduler(scheduler* s) noexcept;
+
+// Installs a scheduler for the lifetime of the guard
+class scoped_scheduler {
+public:
+    explicit scoped_scheduler(scheduler& s) noexcept : previous_(set_scheduler(&s)) {}
+    ~scoped_scheduler() { set_scheduler(previous_); }
+
+    scoped_scheduler(const scoped_scheduler&)            = delete;
+    scoped_scheduler& operator=(const scoped_scheduler&) = delete;
+
+private:
+    scheduler* previous_;
+};
+
+// ---------------------------------------------------------
+// parallel_for / parallel_reduce – fork-join over index ranges and
+// random-access sized ranges
+//
+// `grain` is the number of indices per task; 0 picks one that gives every
+// thread several tasks. With an explicit grain, chunk boundaries (and so
+// parallel_reduce results) do not depend on the thread count.
+// ---------------------------------------------------------
+
+namespace executor_detail {
+
+inline std::size_t auto_grain(std::size_t n, const scheduler& s) noexcept {
+    return std::max<std::size_t>(1, n / (std::max<std::size_t>(1, s.concurrency()) * 8));
+}
+
+template <class R>
+concept random_access_sized =
+    std::ranges::random_access_range<R> && std::ranges::sized_range<R>;
+
+} // namespace executor_detail
+
+// fn(b, e) for consecutive sub-ranges of [first, last)
+template <class Fn>
+    requires std::is_invocable_v<Fn&, std::size_t, std::size_t>
+void parallel_for(scheduler& s, std::size_t first, std::size_t last, Fn&& fn, std::size_t grain = 0) {
+    if (last <= first) return;
+    const std::size_t n = last - first;
+    if (grain == 0) grain = executor_detail::auto_grain(n, s);
+    const std::size_t chunks = (n + grain - 1) / grain;
+
+    auto task = [&](std::size_t c) {
+        std::size_t b = first + c * grain;
+        fn(b, std::min(last, b + grain));
+    };
+    if (chunks == 1) {
+        task(0);
+    } else {
+        s.bulk(chunks, task);
+    }
+}
+
+template <class Fn>
+    requires std::is_invocable_v<Fn&, std::size_t, std::size_t>
+void parallel_for(std::size_t first, std::size_t last, Fn&& fn, std::size_t grain = 0) {
+    parallel_for(current_scheduler(), first, last, std::forward<Fn>(fn), grain);
+}
+
+// fn(element) for every element of r
+template <executor_detail::random_access_sized R, class Fn>
+    requires std::is_invocable_v<Fn&, std::ranges::range_reference_t<R>>
+void parallel_for(scheduler& s, R&& r, Fn&& fn, std::size_t grain = 0) {
+    auto it = std::ranges::begin(r);
+    auto n = static_cast<std::size_t>(std::ranges::size(r));
+    parallel_for(s, 0, n, [&](std::size_t b, std::size_t e) {
+        auto p = it + static_cast<std::ranges::range_difference_t<R>>(b);
+        for (std::size_t i = b; i < e; ++i, ++p) fn(*p);
+    }, grain);
+}
+
+template <executor_detail::random_access_sized R, class Fn>
+    requires std::is_invocable_v<Fn&, std::ranges::range_reference_t<R>>
+void parallel_for(R&& r, Fn&& fn, std::size_t grain = 0) {
+    parallel_for(current_scheduler(), std::forward<R>(r), std::forward<Fn>(fn), grain);
+}
+
+// op(init, map(b0, e0), map(b1, e1), ...) folded left to right
+template <class T, class Map, class Op>
+    requires std::is_invocable_v<Map&, std::size_t, std::size_t>
+T parallel_reduce(scheduler& s, std::size_t first, std::size_t last, T init,
+                  Map map, Op op, std::size_t grain = 0) {
+    if (last <= first) return init;
+    const std::size_t n = last - first;
+    if (grain == 0) grain = executor_detail::auto_grain(n, s);
+    const std::size_t chunks = (n + grain - 1) / grain;
+
+    std::vector<std::optional<T>> partial(chunks);
+    parallel_for(s, first, last, [&](std::size_t b, std::size_t e) {
+        partial[(b - first) / grain].emplace(map(b, e));
+    }, grain);
+
+    for (auto& p : partial) init = op(std::move(init), std::move(*p));
+    return init;
+}
+
+template <class T, class Map, class Op>
+    requires std::is_invocable_v<Map&, std::size_t, std::size_t>
+T parallel_reduce(std::size_t first, std::size_t last, T init, Map map, Op op, std::size_t grain = 0) {
+    return parallel_reduce(current_scheduler(), first, last, std::move(init),
+                           std::move(map), std::move(op), grain);
+}
+
+// op folded over the elements of r, starting from init; op must be
+// associative (each chunk is folded on its own, then the partials)
+template <executor_detail::random_access_sized R, class T, class Op>
+T parallel_reduce(scheduler& s, R&& r, T init, Op op, std::size_t grain = 0) {
+    auto it = std::ranges::begin(r);
+    auto n = static_cast<std::size_t>(std::ranges::size(r));
+    return parallel_reduce(s, 0, n, std::move(init), [&](std::size_t b, std::size_t e) {
+        auto p = it + static_cast<std::ranges::range_difference_t<R>>(b);
+        T acc = static_cast<T>(*p);
+        for (std::size_t i = b + 1; i < e; ++i) acc = op(std::move(acc), *++p);
+        return acc;
+    }, op, grain);
+}
+
+template <executor_detail::random_access_sized R, class T, class Op>
+T parallel_reduce(R&& r, T init, Op op, std::size_t grain = 0) {
+    return parallel_reduce(current_scheduler(), std::forward<R>(r), std::move(init),
+                           std::move(op), grain);
+}
+
+} // namespace pyl
@@ -0,0 +1,431 @@
+#pragma once
+
+#include <algorithm>
+#include <any>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "pyl_hash.h"
+#include "pyl_rcu.h"
+
+namespace pyl {
+
+// ---------------------------------------------------------
+// Dynamic-field storage policies for child_unique_ptr
+//
+// A storage maps field names to std::any values and is looked up
+// with std::string_view keys (no temporary std::string per access).
+//
+//   flat_field_storage<N>  – sorted small vector, first N fields inline
+//                            (default; best for a handful of fields)
+//   hash_field_storage     – std::unordered_map (many fields)
+//   concurrent_field_storage<N>
+//                          – N RCU-published shards; lock-free reads,
+//                            safe to share between threads
+//   cow_field_storage<S>   – copies share one S until written
+//                            (pyl_cow.h)
+//
+// Usage:
+//   child_unique_ptr<Node, Node, std::default_delete<Node>,
+//                    pyl::hash_field_storage> p;
+// ---------------------------------------------------------
+
+template<typename S>
+concept field_storage = requires(S& s, const S& cs, std::string_view key) {
+    { s.find(key) }          -> std::same_as<std::any*>;
+    { cs.find(key) }         -> std::same_as<const std::any*>;
+    { s.get_or_insert(key) } -> std::same_as<std::any&>;
+    { s.erase(key) }         -> std::same_as<bool>;
+    { cs.size() }            -> std::convertible_to<std::size_t>;
+    { cs.empty() }           -> std::convertible_to<bool>;
+    s.clear();
+};
+
+// Storages that synchronize themselves: child_unique_ptr reads through
+// read(key, f) (f gets a const std::any*, nullptr if absent) and
+// writes through store(key, value) instead of find / get_or_insert.
+template<typename S>
+concept synchronized_field_storage = field_storage<S> &&
+    requires(S& s, const S& cs, std::string_view key, std::any value) {
+        s.store(key, std::move(value));
+        { cs.read(key, [](const std::any*) { return true; }) } -> std::same_as<bool>;
+    };
+
+// ---------------------------------------------------------
+// flat_field_storage – entries kept sorted by key in one contiguous
+// block. Up to InlineCapacity entries live inside the object; beyond
+// that all entries move to a std::vector.
+// ---------------------------------------------------------
+template<std::size_t InlineCapacity = 4>
+class flat_field_storage {
+public:
+    using entry = std::pair<std::string, std::any>;
+
+    flat_field_storage() = default;
+
+    flat_field_storage(const flat_field_storage& other) { copy_from(other); }
+    flat_field_storage& operator=(const flat_field_storage& other) {
+        if (this != &other) {
+            clear();
+            copy_from(other);
+        }
+        return *this;
+    }
+
+    flat_field_storage(flat_field_storage&& other) noexcept { move_from(other); }
+    flat_field_storage& operator=(flat_field_storage&& other) noexcept {
+        if (this != &other) {
+            clear();
+            move_from(other);
+        }
+        return *this;
+    }
+
+    std::any* find(std::string_view key) noexcept {
+        entry* e = lookup(key);
+        return e ? &e->second : nullptr;
+    }
+
+    const std::any* find(std::string_view key) const noexcept {
+        const entry* e = const_cast<flat_field_storage*>(this)->lookup(key);
+        return e ? &e->second : nullptr;
+    }
+
+    std::any& get_or_insert(std::string_view key) {
+        entry* first = data();
+        entry* pos = lower_bound(key);
+        if (pos != first + size_ && pos->first == key) {
+            return pos->second;
+        }
+        auto index = static_cast<std::size_t>(pos - first);
+
+        if (on_heap()) {
+            auto it = heap_.emplace(heap_.begin() + static_cast<std::ptrdiff_t>(index),
+                                    std::string(key), std::any{});
+            ++size_;
+            return it->second;
+        }
+        if (size_ == InlineCapacity) {
+            // spill everything to the heap, then insert there
+            heap_.reserve(InlineCapacity * 2);
+            for (std::size_t i = 0; i < size_; ++i) {
+                heap_.push_back(std::move(inline_[i]));
+                inline_[i] = entry{};
+            }
+            auto it = heap_.emplace(heap_.begin() + static_cast<std::ptrdiff_t>(index),
+                                    std::string(key), std::any{});
+            ++size_;
+            return it->second;
+        }
+
+        // shift the inline tail right by one slot
+        for (std::size_t i = size_; i > index; --i) {
+            inline_[i] = std::move(inline_[i - 1]);
+        }
+        inline_[index].first.assign(key);
+        inline_[index].second.reset();
+        ++size_;
+        return inline_[index].second;
+    }
+
+    bool erase(std::string_view key) {
+        entry* e = lookup(key);
+        if (!e) return false;
+        auto index = static_cast<std::size_t>(e - data());
+        if (on_heap()) {
+            heap_.erase(heap_.begin() + static_cast<std::ptrdiff_t>(index));
+        } else {
+            for (std::size_t i = index; i + 1 < size_; ++i) {
+                inline_[i] = std::move(inline_[i + 1]);
+            }
+            inline_[size_ - 1] = entry{};
+        }
+        --size_;
+        return true;
+    }
+
+    std::size_t size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+
+    void clear() noexcept {
+        if (on_heap()) {
+            heap_.clear();
+        } else {
+            for (std::size_t i = 0; i < size_; ++i) {
+                inline_[i] = entry{};
+            }
+        }
+        size_ = 0;
+    }
+
+    // f(std::string_view key, const std::any& value), in key order
+    template<typename F>
+    void for_each(F&& f) const {
+        const entry* first = const_cast<flat_field_storage*>(this)->data();
+        for (std::size_t i = 0; i < size_; ++i) {
+            f(std::string_view(first[i].first), first[i].second);
+        }
+    }
+
+private:
+    std::array<entry, InlineCapacity> inline_{};
+    std::vector<entry> heap_;   // non-empty once spilled
+    std::size_t size_ = 0;
+
+    // once spilled we stay on the heap until clear()
+    bool on_heap() const noexcept { return !heap_.empty(); }
+
+    entry* data() noexcept { return on_heap() ? heap_.data() : inline_.data(); }
+
+    entry* lower_bound(std::string_view key) noexcept {
+        entry* first = data();
+        return std::lower_bound(first, first + size_, key,
+            [](const entry& e, std::string_view k) { return std::string_view(e.first) < k; });
+    }
+
+    entry* lookup(std::string_view key) noexcept {
+        entry* pos = lower_bound(key);
+        return (pos != data() + size_ && pos->first == key) ? pos : nullptr;
+    }
+
+    void copy_from(const flat_field_storage& other) {
+        if (other.on_heap()) {
+            heap_ = other.heap_;
+        } else {
+            for (std::size_t i = 0; i < other.size_; ++i) {
+                inline_[i] = other.inline_[i];
+            }
+        }
+        size_ = other.size_;
+    }
+
+    void move_from(flat_field_storage& other) noexcept {
+        if (other.on_heap()) {
+            heap_ = std::move(other.heap_);
+            other.heap_.clear();
+        } else {
+            for (std::size_t i = 0; i < other.size_; ++i) {
+                inline_[i] = std::move(other.inline_[i]);
+                other.inline_[i] = entry{};
+            }
+        }
+        size_ = other.size_;
+        other.size_ = 0;
+    }
+};
+
+// ---------------------------------------------------------
+// hash_field_storage – std::unordered_map with heterogeneous lookup
+// ---------------------------------------------------------
+class hash_field_storage {
+public:
+    std::any* find(std::string_view key) noexcept {
+        auto it = map_.find(key);
+        return it != map_.end() ? &it->second : nullptr;
+    }
+
+    const std::any* find(std::string_view key) const noexcept {
+        auto it = map_.find(key);
+        return it != map_.end() ? &it->second : nullptr;
+    }
+
+    std::any& get_or_insert(std::string_view key) {
+        auto it = map_.find(key);
+        if (it == map_.end()) {
+            it = map_.emplace(std::string(key), std::any{}).first;
+        }
+        return it->second;
+    }
+
+    bool erase(std::string_view key) {
+        auto it = map_.find(key);
+        if (it == map_.end()) return false;
+        map_.erase(it);
+        return true;
+    }
+
+    std::size_t size() const noexcept { return map_.size(); }
+    bool empty() const noexcept { return map_.empty(); }
+    void clear() noexcept { map_.clear(); }
+
+    // f(std::string_view key, const std::any& value), unspecified order
+    template<typename F>
+    void for_each(F&& f) const {
+        for (const auto& [k, v] : map_) {
+            f(std::string_view(k), v);
+        }
+    }
+
+private:
+    struct key_hash {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view s) const noexcept {
+            return std::hash<std::string_view>{}(s);
+        }
+    };
+
+    std::unordered_map<std::string, std::any, key_hash, std::equal_to<>> map_;
+};
+
+// ---------------------------------------------------------
+// concurrent_field_storage – for child_unique_ptrs shared between
+// threads.
+//
+// Keys are hashed onto Shards shards; each shard is an immutable
+// sorted vector published through an rcu_ptr. read() and for_each()
+// run inside an RCU read section and never lock or write shared
+// memory, so any number of readers scale with cores. store() and
+// erase() copy one shard under a striped writer lock and publish the
+// copy; readers that are mid-lookup keep seeing the old shard.
+//
+// find() / get_or_insert() / clear() exist for the field_storage
+// protocol and are for exclusive use (setup, copying, loading);
+// the pointer find() returns is valid inside an rcu_read_guard until
+// the next write.
+// ---------------------------------------------------------
+template<std::size_t Shards = 8>
+class concurrent_field_storage {
+    static_assert(Shards > 0);
+
+public:
+    using entry = std::pair<std::string, std::any>;
+
+    concurrent_field_storage() = default;
+
+    concurrent_field_storage(const concurrent_field_storage& other) { copy_from(other); }
+    concurrent_field_storage& operator=(const concurrent_field_storage& other) {
+        if (this != &other) {
+            concurrent_field_storage tmp(other);
+            for (std::size_t i = 0; i < Shards; ++i) {
+                shards_[i].swap(tmp.shards_[i]);
+            }
+        }
+        return *this;
+    }
+
+    concurrent_field_storage(concurrent_field_storage&&) noexcept            = default;
+    concurrent_field_storage& operator=(concurrent_field_storage&&) noexcept = default;
+
+    // f(const std::any*) inside a read section; the pointer must not
+    // escape f
+    template<typename F>
+    decltype(auto) read(std::string_view key, F&& f) const {
+        rcu_read_guard g;
+        return std::forward<F>(f)(lookup(shard_for(key).load(), key));
+    }
+
+    void store(std::string_view key, std::any value) {
+        auto& sh = shard_for(key);
+        auto lk = rcu_writer_lock(&sh);
+        auto next = copy_of(sh.load());
+        auto pos = lower_bound(*next, key);
+        if (pos != next->end() && pos->first == key) {
+            pos->second = std::move(value);
+        } else {
+            next->emplace(pos, std::string(key), std::move(value));
+        }
+        sh.store(next.release());
+    }
+
+    bool erase(std::string_view key) {
+        auto& sh = shard_for(key);
+        auto lk = rcu_writer_lock(&sh);
+        const shard* cur = sh.load();
+        if (!lookup(cur, key)) return false;
+        auto next = copy_of(cur);
+        next->erase(lower_bound(*next, key));
+        sh.store(next->empty() ? nullptr : next.release());
+        return true;
+    }
+
+    std::any* find(std::string_view key) noexcept {
+        return const_cast<std::any*>(lookup(shard_for(key).load(), key));
+    }
+
+    const std::any* find(std::string_view key) const noexcept {
+        return lookup(shard_for(key).load(), key);
+    }
+
+    std::any& get_or_insert(std::string_view key) {
+        if (std::any* v = find(key)) return *v;
+        store(key, std::any{});
+        return *find(key);
+    }
+
+    // Not noexcept: the first read section on a thread registers it (allocates)
+    std::size_t size() const {
+        rcu_read_guard g;
+        std::size_t n = 0;
+        for (const auto& sh : shards_) {
+            if (const shard* s = sh.load()) n += s->size();
+        }
+        return n;
+    }
+
+    bool empty() const { return size() == 0; }
+
+    void clear() {
+        for (auto& sh : shards_) {
+            auto lk = rcu_writer_lock(&sh);
+            sh.store(nullptr);
+        }
+    }
+
+    // f(std::string_view key, const std::any& value), unspecified order;
+    // each shard is seen as one consistent version
+    template<typename F>
+    void for_each(F&& f) const {
+        rcu_read_guard g;
+        for (const auto& sh : shards_) {
+            if (const shard* s = sh.load()) {
+                for (const auto& [k, v] : *s) f(std::string_view(k), v);
+            }
+        }
+    }
+
+private:
+    using shard = std::vector<entry>;   // sorted by key
+    std::array<rcu_ptr<shard>, Shards> shards_;
+
+    rcu_ptr<shard>& shard_for(std::string_view key) noexcept {
+        return shards_[hash_string(key) % Shards];
+    }
+    const rcu_ptr<shard>& shard_for(std::string_view key) const noexcept {
+        return shards_[hash_string(key) % Shards];
+    }
+
+    template<typename V>
+    static auto lower_bound(V& v, std::string_view key) noexcept {
+        return std::lower_bound(v.begin(), v.end(), key,
+            [](const entry& e, std::string_view k) { return std::string_view(e.first) < k; });
+    }
+
+    static const std::any* lookup(const shard* s, std::string_view key) noexcept {
+        if (!s) return nullptr;
+        auto pos = lower_bound(*s, key);
+        return (pos != s->end() && pos->first == key) ? &pos->second : nullptr;
+    }
+
+    static std::unique_ptr<shard> copy_of(const shard* s) {
+        return s ? std::make_unique<shard>(*s) : std::make_unique<shard>();
+    }
+
+    void copy_from(const concurrent_field_storage& other) {
+        rcu_read_guard g;
+        for (std::size_t i = 0; i < Shards; ++i) {
+            if (const shard* s = other.shards_[i].load()) {
+                shards_[i] = rcu_ptr<shard>(new shard(*s));
+            }
+        }
+    }
+};
+
+} // namespace pyl
@@ -0,0 +1,230 @@
+#pragma once
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+namespace pyl {
+
+// ---------------------------------------------------------
+// generator<T> – lazy, Python-style generator function as a range
+//
+// Usage:
+//   pyl::generator<int> countdown(int n) {
+//       while (n > 0) co_yield n--;
+//   }
+//
+//   for (int x : countdown(3)) { ... }                   // 3 2 1
+//   auto evens = countdown(10) | IF(x, x % 2 == 0) | MAP(x, x * x);
+//   long total = pyl::sum(read_events(sock));            // nothing buffered
+//
+// A generator is a move-only input view: elements are produced on
+// demand, one at a time, and it can be iterated once. Elements are
+// `const T&` (or `T&` for generator<T&>) referring to the yielded
+// object, which stays valid until the next increment. An exception
+// thrown in the body propagates out of begin() / operator++.
+//
+// Coroutine frames come from a per-thread cache of recycled blocks,
+// so a steady stream of short-lived generators does not touch malloc.
+// ---------------------------------------------------------
+
+namespace generator_detail {
+
+// Per-thread free lists of coroutine frames, by 64-byte size class
+class frame_pool {
+public:
+    static constexpr std::size_t granularity = 64;
+    static constexpr std::size_t classes     = 33;   // frames up to 2 KiB are cached
+    static constexpr std::size_t max_cached  = 16;   // blocks kept per class
+
+    frame_pool() = default;
+    frame_pool(const frame_pool&)            = delete;
+    frame_pool& operator=(const frame_pool&) = delete;
+
+    ~frame_pool() {
+        for (auto*& head : free_) {
+            while (head) ::operator delete(std::exchange(head, head->next));
+        }
+    }
+
+    void* allocate(std::size_t n) {
+        std::size_t c = size_class(n);
+        if (c < classes) {
+            if (node* p = free_[c]) {
+                free_[c] = p->next;
+                --count_[c];
+                return p;
+            }
+            return ::operator new(c * granularity);
+        }
+        return ::operator new(n);
+    }
+
+    void deallocate(void* p, std::size_t n) noexcept {
+        std::size_t c = size_class(n);
+        if (c < classes && count_[c] < max_cached) {
+            free_[c] = ::new (p) node{free_[c]};
+            ++count_[c];
+            return;
+        }
+        ::operator delete(p);
+    }
+
+    // Blocks currently cached (all classes)
+    std::size_t cached() const noexcept {
+        std::size_t total = 0;
+        for (std::size_t c : count_) total += c;
+        return total;
+    }
+
+private:
+    struct node {
+        node* next;
+    };
+
+    static std::size_t size_class(std::size_t n) noexcept {
+        return (n + granularity - 1) / granularity;
+    }
+
+    node* free_[classes] = {};
+    std::size_t count_[classes] = {};
+};
+
+// Set once this thread's pool is destroyed; trivially destructible, so
+// it stays readable for frames freed by later thread_local destructors
+inline thread_local bool frame_pool_gone = false;
+
+struct frame_pool_holder {
+    frame_pool pool;
+    ~frame_pool_holder() { frame_pool_gone = true; }
+};
+
+// This thread's pool, or nullptr during thread exit once it is gone
+inline frame_pool* local_frame_pool() {
+    if (frame_pool_gone) return nullptr;
+    thread_local frame_pool_holder holder;
+    return &holder.pool;
+}
+
+} // namespace generator_detail
+
+template <class T>
+class generator : public std::ranges::view_interface<generator<T>> {
+public:
+    using value_type = std::remove_cvref_t<T>;
+    using reference  = std::conditional_t<std::is_reference_v<T>, T, const T&>;
+
+    struct promise_type {
+        std::add_pointer_t<reference> current = nullptr;
+        std::exception_ptr error;
+
+        generator get_return_object() noexcept {
+            return generator(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        std::suspend_always initial_suspend() const noexcept { return {}; }
+        std::suspend_always final_suspend() const noexcept { return {}; }
+
+        // The yielded object (or temporary) lives until the coroutine resumes
+        std::suspend_always yield_value(reference value) noexcept {
+            current = std::addressof(value);
+            return {};
+        }
+
+        void return_void() const noexcept {}
+        void unhandled_exception() noexcept { error = std::current_exception(); }
+
+        // Generators are synchronous: co_await is not allowed in the body
+        template <class U>
+        std::suspend_never await_transform(U&&) = delete;
+
+        static void* operator new(std::size_t n) {
+            auto* pool = generator_detail::local_frame_pool();
+            return pool ? pool->allocate(n) : ::operator new(n);
+        }
+        static void operator delete(void* p, std::size_t n) noexcept {
+            auto* pool = generator_detail::local_frame_pool();
+            if (pool) {
+                pool->deallocate(p, n);
+            } else {
+                ::operator delete(p);
+            }
+        }
+    };
+
+    using handle_type = std::coroutine_handle<promise_type>;
+
+    class iterator {
+    public:
+        using value_type      = generator::value_type;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+        iterator(iterator&& other) noexcept : h_(std::exchange(other.h_, nullptr)) {}
+        iterator& operator=(iterator&& other) noexcept {
+            h_ = std::exchange(other.h_, nullptr);
+            return *this;
+        }
+
+        reference operator*() const noexcept { return static_cast<reference>(*h_.promise().current); }
+
+        iterator& operator++() {
+            h_.resume();
+            rethrow(h_);
+            return *this;
+        }
+        void operator++(int) { ++*this; }
+
+        friend bool operator==(const iterator& it, std::default_sentinel_t) noexcept {
+            return !it.h_ || it.h_.done();
+        }
+
+    private:
+        friend class generator;
+        explicit iterator(handle_type h) noexcept : h_(h) {}
+
+        handle_type h_ = nullptr;
+    };
+
+    generator() noexcept = default;
+    generator(generator&& other) noexcept : h_(std::exchange(other.h_, nullptr)) {}
+    generator& operator=(generator&& other) noexcept {
+        if (this != &other) {
+            destroy();
+            h_ = std::exchange(other.h_, nullptr);
+        }
+        return *this;
+    }
+    ~generator() { destroy(); }
+
+    // Runs the body up to the first co_yield; call once
+    iterator begin() {
+        if (h_) {
+            h_.resume();
+            rethrow(h_);
+        }
+        return iterator(h_);
+    }
+    std::default_sentinel_t end() const noexcept { return {}; }
+
+private:
+    explicit generator(handle_type h) noexcept : h_(h) {}
+
+    static void rethrow(handle_type h) {
+        if (h.promise().error) std::rethrow_exception(std::exchange(h.promise().error, nullptr));
+    }
+
+    void destroy() noexcept {
+        if (h_) std::exchange(h_, nullptr).destroy();
+    }
+
+    handle_type h_ = nullptr;
+};
+
+} // namespace pyl
@@ -0,0 +1,280 @@
+#pragma once
+
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+#include "pyl_object_interface.h"
+#include "pyl_stats.h"
+
+namespace pyl {
+
+// ---------------------------------------------------------
+// pyl::hash – fast hashing for pyl objects and plain values
+//
+//   std::size_t h = pyl::hash<Text>{}(name);
+//   std::size_t b = pyl::hash_bytes(buf, len);
+//
+//   pyl::flat_map<Text, int> counts;
+//   counts.find(std::string_view("key"));   // no temporary Text
+//
+// Strings and string-like pyl types (Text, TextView, InternedText,
+// std::string, string_view, literals) hash their contents with the same
+// wyhash-style function, so they are interchangeable lookup keys.
+//
+// pyl::hash<T> picks, in order:
+//   1. T::hash()                  (ObjInterface types)
+//   2. string contents
+//   3. integers, enums, pointers, floating point (mixed bits)
+//   4. std::hash<T>
+//   5. object bytes, for types with unique object representations
+//   6. T::to_string() contents
+// Tiers 5 and 6 only apply to types that define no equality (== or
+// equals()): a user-defined equality can call objects equal whose
+// bytes or text differ. Such types need a hash() member or std::hash,
+// or, when == compares exactly the object bytes (e.g. a defaulted ==
+// over integer members), can opt in with
+//   template <> inline constexpr bool pyl::hash_object_bytes<Point> = true;
+// Specialize pyl::hash<T> to override.
+// ---------------------------------------------------------
+
+// Opt-in: T's equality compares exactly its object representation
+template <typename T>
+inline constexpr bool hash_object_bytes = false;
+
+namespace hash_detail {
+
+inline constexpr std::uint64_t p0 = 0xa0761d6478bd642fULL;
+inline constexpr std::uint64_t p1 = 0xe7037ed1a0b428dbULL;
+inline constexpr std::uint64_t p2 = 0x8ebc6af09c88c6e3ULL;
+inline constexpr std::uint64_t p3 = 0x589965cc75374cc3ULL;
+
+// 64x64 -> 128 multiply; a = low half, b = high half
+inline void mum(std::uint64_t& a, std::uint64_t& b) noexcept {
+#ifdef __SIZEOF_INT128__
+    __extension__ typedef unsigned __int128 u128;
+    u128 r = static_cast<u128>(a) * b;
+    a = static_cast<std::uint64_t>(r);
+    b = static_cast<std::uint64_t>(r >> 64);
+#else
+    std::uint64_t ha = a >> 32, hb = b >> 32;
+    std::uint64_t la = static_cast<std::uint32_t>(a), lb = static_cast<std::uint32_t>(b);
+    std::uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    std::uint64_t t = rl + (rm0 << 32);
+    std::uint64_t c = t < rl;
+    std::uint64_t lo = t + (rm1 << 32);
+    c += lo < t;
+    b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+    a = lo;
+#endif
+}
+
+inline std::uint64_t mix(std::uint64_t a, std::uint64_t b) noexcept {
+    mum(a, b);
+    return a ^ b;
+}
+
+inline std::uint64_t read8(const unsigned char* p) noexcept {
+    std::uint64_t v;
+    std::memcpy(&v, p, 8);
+    return v;
+}
+
+inline std::uint64_t read4(const unsigned char* p) noexcept {
+    std::uint32_t v;
+    std::memcpy(&v, p, 4);
+    return v;
+}
+
+inline std::uint64_t read3(const unsigned char* p, std::size_t k) noexcept {
+    return (std::uint64_t{p[0]} << 16) | (std::uint64_t{p[k >> 1]} << 8) | std::uint64_t{p[k - 1]};
+}
+
+// wyhash (final version 4): 16 bytes per multiply, three independent
+// lanes for long inputs
+inline std::uint64_t wyhash(const void* key, std::size_t len, std::uint64_t seed) noexcept {
+    const auto* p = static_cast<const unsigned char*>(key);
+    seed ^= mix(seed ^ p0, p1);
+    std::uint64_t a = 0, b = 0;
+    if (len <= 16) {
+        if (len >= 4) {
+            std::size_t off = (len >> 3) << 2;
+            a = (read4(p) << 32) | read4(p + off);
+            b = (read4(p + len - 4) << 32) | read4(p + len - 4 - off);
+        } else if (len > 0) {
+            a = read3(p, len);
+        }
+    } else {
+        std::size_t i = len;
+        if (i > 48) {
+            std::uint64_t see1 = seed, see2 = seed;
+            do {
+                seed = mix(read8(p) ^ p1, read8(p + 8) ^ seed);
+                see1 = mix(read8(p + 16) ^ p2, read8(p + 24) ^ see1);
+                see2 = mix(read8(p + 32) ^ p3, read8(p + 40) ^ see2);
+                p += 48;
+                i -= 48;
+            } while (i > 48);
+            seed ^= see1 ^ see2;
+        }
+        while (i > 16) {
+            seed = mix(read8(p) ^ p1, read8(p + 8) ^ seed);
+            i -= 16;
+            p += 16;
+        }
+        a = read8(p + i - 16);
+        b = read8(p + i - 8);
+    }
+    a ^= p1;
+    b ^= seed;
+    mum(a, b);
+    return mix(a ^ p0 ^ len, b ^ p1);
+}
+
+// Strings and string-like pyl types (hash and compare by contents)
+template <typename T>
+concept string_like =
+    std::is_convertible_v<const T&, std::string_view> ||
+    requires(const T& v) { { v.str() } -> std::convertible_to<const std::string&>; } ||
+    requires(const T& v) { { v.view() } -> std::same_as<std::string_view>; };
+
+// Equality that the byte / to_string() tiers cannot be trusted to respect
+template <typename T>
+concept has_equality =
+    std::equality_comparable<T> ||
+    requires(const T& a, const T& b) { { a.equals(b) } -> std::convertible_to<bool>; };
+
+template <typename T>
+inline constexpr bool bytes_hashable =
+    std::has_unique_object_representations_v<T> && (!has_equality<T> || hash_object_bytes<T>);
+
+template <typename T>
+concept text_hashable = HasToString<T> && !has_equality<T>;
+
+template <string_like T>
+std::string_view as_string_view(const T& v) noexcept {
+    if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+        return std::string_view(v);
+    } else if constexpr (requires { { v.view() } -> std::same_as<std::string_view>; }) {
+        return v.view();
+    } else {
+        return std::string_view(v.str());
+    }
+}
+
+} // namespace hash_detail
+
+// Hash of [data, data + len)
+inline std::size_t hash_bytes(const void* data, std::size_t len, std::uint64_t seed = 0) noexcept {
+    return static_cast<std::size_t>(hash_detail::wyhash(data, len, seed));
+}
+
+inline std::size_t hash_string(std::string_view s) noexcept {
+    return hash_bytes(s.data(), s.size());
+}
+
+// Well-mixed hash of a 64-bit value (std::hash<int> is the identity)
+inline std::size_t hash_int(std::uint64_t v) noexcept {
+    return static_cast<std::size_t>(hash_detail::mix(v ^ hash_detail::p0, hash_detail::p1));
+}
+
+// Combine two hashes (order-dependent)
+inline std::size_t hash_combine(std::size_t seed, std::size_t h) noexcept {
+    return static_cast<std::size_t>(
+        hash_detail::mix(static_cast<std::uint64_t>(seed) ^ hash_detail::p2,
+                         static_cast<std::uint64_t>(h) ^ hash_detail::p3));
+}
+
+template <typename T>
+struct hash {
+    std::size_t operator()(const T& v) const
+        requires (HasHash<T> || hash_detail::string_like<T> ||
+                  std::is_integral_v<T> || std::is_enum_v<T> || std::is_pointer_v<T> ||
+                  std::is_floating_point_v<T> ||
+                  requires { std::hash<T>{}(v); } ||
+                  hash_detail::bytes_hashable<T> ||
+                  hash_detail::text_hashable<T>)
+    {
+        if constexpr (HasHash<T>) {
+            return static_cast<std::size_t>(v.hash());
+        } else if constexpr (hash_detail::string_like<T>) {
+            return hash_string(hash_detail::as_string_view(v));
+        } else if constexpr (std::is_integral_v<T> || std::is_enum_v<T>) {
+            return hash_int(static_cast<std::uint64_t>(v));
+        } else if constexpr (std::is_pointer_v<T>) {
+            return hash_int(static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(v)));
+        } else if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>) {
+            // +0.0 and -0.0 compare equal, so they must hash alike
+            T x = v == T(0) ? T(0) : v;
+            using Bits = std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>;
+            return hash_int(std::bit_cast<Bits>(x));
+        } else if constexpr (requires { std::hash<T>{}(v); }) {
+            return hash_int(static_cast<std::uint64_t>(std::hash<T>{}(v)));
+        } else if constexpr (hash_detail::bytes_hashable<T>) {
+            return hash_bytes(std::addressof(v), sizeof(T));
+        } else {
+            PYL_STATS_INC(hash_to_string);
+            return hash_string(v.to_string());
+        }
+    }
+};
+
+template <typename T>
+concept hashable = requires(const T& v) {
+    { pyl::hash<T>{}(v) } -> std::convertible_to<std::size_t>;
+};
+
+// Heterogeneous hasher / equality for the unordered containers:
+// Text-keyed maps can be probed with string_view, literals, TextView
+// or InternedText without building a Text.
+struct transparent_hash {
+    using is_transparent = void;
+
+    template <typename T>
+        requires hashable<T>
+    std::size_t operator()(const T& v) const {
+        return pyl::hash<T>{}(v);
+    }
+};
+
+struct transparent_equal {
+    using is_transparent = void;
+
+    template <typename A, typename B>
+    bool operator()(const A& a, const B& b) const {
+        if constexpr (hash_detail::string_like<A> && hash_detail::string_like<B>) {
+            return hash_detail::as_string_view(a) == hash_detail::as_string_view(b);
+        } else if constexpr (std::is_same_v<A, B> && HasEquals<A>) {
+            return a.equals(b);
+        } else {
+            return a == b;
+        }
+    }
+};
+
+// Hash containers keyed through pyl::hash with transparent lookup.
+// These are std::unordered_map / std::unordered_set (stable references,
+// node-based); the name marks them as the pyl default for hashed keys.
+template <typename K, typename V,
+          typename Hash  = transparent_hash,
+          typename Equal = transparent_equal,
+          typename Alloc = std::allocator<std::pair<const K, V>>>
+using flat_map = std::unordered_map<K, V, Hash, Equal, Alloc>;
+
+template <typename K,
+          typename Hash  = transparent_hash,
+          typename Equal = transparent_equal,
+          typename Alloc = std::allocator<K>>
+using flat_set = std::unordered_set<K, Hash, Equal, Alloc>;
+
+} // namespace pyl
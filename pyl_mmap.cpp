@@ -0,0 +1,153 @@
+#include "pyl_mmap.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <system_error>
+
+#if __has_include(<sys/mman.h>) && __has_include(<unistd.h>)
+#define PYL_HAVE_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#define PYL_HAVE_MMAP 0
+#endif
+
+namespace pyl {
+
+namespace {
+
+[[noreturn]] void throw_file_error(int err, const std::string& what, const std::string& path) {
+    throw std::system_error(err, std::generic_category(), "mapped_file: " + what + " " + path);
+}
+
+#if PYL_HAVE_MMAP
+int to_madvise(access_hint hint) noexcept {
+    switch (hint) {
+        case access_hint::sequential: return MADV_SEQUENTIAL;
+        case access_hint::random:     return MADV_RANDOM;
+        case access_hint::willneed:   return MADV_WILLNEED;
+        case access_hint::normal:     break;
+    }
+    return MADV_NORMAL;
+}
+#endif
+
+} // namespace
+
+#if PYL_HAVE_MMAP
+
+mapped_file::mapped_file(const std::string& path, access_hint hint) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) throw_file_error(errno, "cannot open", path);
+
+    struct stat st {};
+    if (::fstat(fd, &st) != 0) {
+        int err = errno;
+        ::close(fd);
+        throw_file_error(err, "cannot stat", path);
+    }
+
+    size_ = static_cast<std::size_t>(st.st_size);
+    if (size_ > 0) {
+        void* p = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p == MAP_FAILED) {
+            int err = errno;
+            ::close(fd);
+            throw_file_error(err, "cannot map", path);
+        }
+        data_ = static_cast<const char*>(p);
+    }
+    ::close(fd);   // the mapping keeps the file referenced
+    open_ = true;
+    advise(hint);
+}
+
+void mapped_file::advise(access_hint hint) const noexcept {
+    if (data_) ::madvise(const_cast<char*>(data_), size_, to_madvise(hint));
+}
+
+void mapped_file::advise(std::size_t offset, std::size_t length, access_hint hint) const noexcept {
+    if (!data_ || offset >= size_) return;
+    // madvise wants a page-aligned start
+    static const auto page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    std::size_t start = offset - offset % page;
+    std::size_t len = std::min(length, size_ - offset) + (offset - start);   // no wrap for huge length
+    ::madvise(const_cast<char*>(data_ + start), len, to_madvise(hint));
+}
+
+void mapped_file::close() noexcept {
+    if (data_) {
+        if (owns_heap_) {
+            delete[] data_;
+        } else {
+            ::munmap(const_cast<char*>(data_), size_);
+        }
+    }
+    data_ = nullptr;
+    size_ = 0;
+    open_ = false;
+    owns_heap_ = false;
+}
+
+#else
+
+// No mmap: read the whole file once
+mapped_file::mapped_file(const std::string& path, access_hint) {
+    std::FILE* f = std::fopen(path.c_str(), "rb");
+    if (!f) throw_file_error(errno, "cannot open", path);
+
+    std::string buf;
+    char chunk[1 << 16];
+    std::size_t n;
+    while ((n = std::fread(chunk, 1, sizeof(chunk), f)) > 0) buf.append(chunk, n);
+    std::fclose(f);
+
+    size_ = buf.size();
+    if (size_ > 0) {
+        char* p = new char[size_];
+        std::memcpy(p, buf.data(), size_);
+        data_ = p;
+        owns_heap_ = true;
+    }
+    open_ = true;
+}
+
+void mapped_file::advise(access_hint) const noexcept {}
+
+void mapped_file::advise(std::size_t, std::size_t, access_hint) const noexcept {}
+
+void mapped_file::close() noexcept {
+    if (owns_heap_) delete[] data_;
+    data_ = nullptr;
+    size_ = 0;
+    open_ = false;
+    owns_heap_ = false;
+}
+
+#endif
+
+mapped_file::~mapped_file() {
+    close();
+}
+
+mapped_file::mapped_file(mapped_file&& other) noexcept
+    : data_(std::exchange(other.data_, nullptr)),
+      size_(std::exchange(other.size_, 0)),
+      open_(std::exchange(other.open_, false)),
+      owns_heap_(std::exchange(other.owns_heap_, false)) {}
+
+mapped_file& mapped_file::operator=(mapped_file&& other) noexcept {
+    if (this != &other) {
+        close();
+        data_      = std::exchange(other.data_, nullptr);
+        size_      = std::exchange(other.size_, 0);
+        open_      = std::exchange(other.open_, false);
+        owns_heap_ = std::exchange(other.owns_heap_, false);
+    }
+    return *this;
+}
+
+} // namespace pyl
@@ -0,0 +1,236 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <optional>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace pyl {
+
+// ---------------------------------------------------------
+// mapped_file – read-only memory mapping of a whole file
+//
+// Usage:
+//   pyl::mapped_file f("snapshot.tsv");            // throws std::system_error
+//   std::string_view bytes = f.bytes();            // no copy
+//   f.advise(pyl::access_hint::random);            // change the kernel hint
+//
+// Pages are faulted in on first touch, so opening is O(1) regardless
+// of file size. On platforms without mmap the file is read into memory.
+// ---------------------------------------------------------
+
+enum class access_hint {
+    normal,
+    sequential,   // aggressive readahead, pages dropped behind the scan
+    random,       // no readahead (point lookups)
+    willneed,     // start reading the range now
+};
+
+class mapped_file {
+public:
+    mapped_file() noexcept = default;
+    explicit mapped_file(const std::string& path, access_hint hint = access_hint::sequential);
+    ~mapped_file();
+
+    mapped_file(mapped_file&& other) noexcept;
+    mapped_file& operator=(mapped_file&& other) noexcept;
+    mapped_file(const mapped_file&)            = delete;
+    mapped_file& operator=(const mapped_file&) = delete;
+
+    const char* data() const noexcept { return data_; }
+    std::size_t size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+    bool is_open() const noexcept { return open_; }
+
+    std::string_view bytes() const noexcept { return {data_, size_}; }
+
+    // Kernel paging hint for the whole file or for [offset, offset + length)
+    // (no-op where unsupported)
+    void advise(access_hint hint) const noexcept;
+    void advise(std::size_t offset, std::size_t length, access_hint hint) const noexcept;
+
+    void close() noexcept;
+
+private:
+    const char* data_ = nullptr;
+    std::size_t size_ = 0;
+    bool open_        = false;
+    bool owns_heap_   = false;   // fallback copy instead of a mapping
+};
+
+// ---------------------------------------------------------
+// kv_view – zero-copy (key, value) pairs over "key<sep>value\n" lines
+//
+//   pyl::kv_file snap("snapshot.tsv");             // tab-separated
+//   for (auto [k, v] : snap) { ... }               // std::string_view pairs
+//   auto ks = pyl::to_vector(pyl::keys(snap));
+//   auto hot = snap | IF(k, v, v.size() > 100) | MAP(k, v, k);
+//   auto v = snap.find("user:42");                 // binary search (sorted files)
+//
+// Elements are std::pair<std::string_view, std::string_view> pointing
+// into the mapping; they stay valid while the file is mapped. A trailing
+// '\r' is dropped, blank lines are skipped, and a line without the
+// separator is a key with an empty value.
+// ---------------------------------------------------------
+
+using kv_pair = std::pair<std::string_view, std::string_view>;
+
+class kv_view : public std::ranges::view_interface<kv_view> {
+public:
+    class iterator {
+    public:
+        using iterator_concept  = std::forward_iterator_tag;
+        using iterator_category = std::input_iterator_tag;   // yields prvalues
+        using value_type        = kv_pair;
+        using difference_type   = std::ptrdiff_t;
+
+        iterator() = default;
+
+        kv_pair operator*() const noexcept { return current_; }
+
+        iterator& operator++() noexcept {
+            pos_ = next_;
+            load();
+            return *this;
+        }
+        iterator operator++(int) noexcept {
+            auto tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        friend bool operator==(const iterator& a, const iterator& b) noexcept { return a.pos_ == b.pos_; }
+        friend bool operator==(const iterator& it, std::default_sentinel_t) noexcept { return it.pos_ == it.end_; }
+
+    private:
+        friend class kv_view;
+
+        iterator(const char* pos, const char* end, char sep) noexcept
+            : pos_(pos), end_(end), sep_(sep) {
+            load();
+        }
+
+        // Parse the line at pos_, skipping blank lines
+        void load() noexcept {
+            while (pos_ != end_) {
+                bool blank = false;
+                next_ = parse_line(pos_, end_, sep_, current_, blank);
+                if (!blank) return;
+                pos_ = next_;
+            }
+        }
+
+        // Split the line starting at p; returns the start of the next line
+        static const char* parse_line(const char* p, const char* end, char sep,
+                                      kv_pair& out, bool& blank) noexcept {
+            const char* nl = static_cast<const char*>(std::memchr(p, '\n', static_cast<std::size_t>(end - p)));
+            const char* line_end = nl ? nl : end;
+            const char* next = nl ? nl + 1 : end;
+            if (line_end != p && line_end[-1] == '\r') --line_end;
+
+            auto len = static_cast<std::size_t>(line_end - p);
+            blank = len == 0;
+            const char* s = static_cast<const char*>(std::memchr(p, sep, len));
+            if (s) {
+                out.first  = std::string_view(p, static_cast<std::size_t>(s - p));
+                out.second = std::string_view(s + 1, static_cast<std::size_t>(line_end - s - 1));
+            } else {
+                out.first  = std::string_view(p, len);
+                out.second = std::string_view();
+            }
+            return next;
+        }
+
+        const char* pos_  = nullptr;   // start of the current line
+        const char* end_  = nullptr;
+        const char* next_ = nullptr;   // start of the following line
+        kv_pair current_{};
+        char sep_ = '\t';
+    };
+
+    kv_view() = default;
+    explicit kv_view(std::string_view data, char sep = '\t') noexcept : data_(data), sep_(sep) {}
+
+    iterator begin() const noexcept { return iterator(data_.data(), data_.data() + data_.size(), sep_); }
+    std::default_sentinel_t end() const noexcept { return {}; }
+
+    std::string_view bytes() const noexcept { return data_; }
+    char separator() const noexcept { return sep_; }
+
+    // First entry whose key is not less than `key` (bytewise); requires
+    // the lines to be sorted by key. O(log n) line probes; blank lines
+    // are skipped like iteration does, so they may appear anywhere.
+    iterator lower_bound(std::string_view key) const noexcept {
+        const char* base = data_.data();
+        const char* lo = base;
+        const char* hi = base + data_.size();
+        while (lo < hi) {
+            const char* mid = lo + (hi - lo) / 2;
+            const char* ls = mid;
+            while (ls > lo && ls[-1] != '\n') --ls;
+            kv_pair kv;
+            bool blank = false;
+            const char* next = iterator::parse_line(ls, hi, sep_, kv, blank);
+            // Probe the first entry at or after a blank line; ls stays at
+            // the blank so `hi = ls` never drops the entry itself
+            while (blank && next != hi) next = iterator::parse_line(next, hi, sep_, kv, blank);
+            if (blank) {
+                hi = ls;
+            } else if (kv.first < key) {
+                lo = next;
+            } else {
+                hi = ls;
+            }
+        }
+        return iterator(lo, base + data_.size(), sep_);
+    }
+
+    // Value stored for `key` in a sorted file
+    std::optional<std::string_view> find(std::string_view key) const noexcept {
+        auto it = lower_bound(key);
+        if (it == end() || (*it).first != key) return std::nullopt;
+        return (*it).second;
+    }
+
+private:
+    std::string_view data_;
+    char sep_ = '\t';
+};
+
+// ---------------------------------------------------------
+// kv_file – mapped_file + kv_view (owning, move-only range)
+// ---------------------------------------------------------
+
+class kv_file {
+public:
+    explicit kv_file(const std::string& path, char sep = '\t',
+                     access_hint hint = access_hint::sequential)
+        : file_(path, hint), sep_(sep) {}
+
+    kv_view view() const noexcept { return kv_view(file_.bytes(), sep_); }
+
+    kv_view::iterator begin() const noexcept { return view().begin(); }
+    std::default_sentinel_t end() const noexcept { return {}; }
+
+    kv_view::iterator lower_bound(std::string_view key) const noexcept { return view().lower_bound(key); }
+    std::optional<std::string_view> find(std::string_view key) const noexcept { return view().find(key); }
+
+    // Point lookups on a cold file: switch off readahead
+    void advise(access_hint hint) const noexcept { file_.advise(hint); }
+
+    const mapped_file& file() const noexcept { return file_; }
+
+private:
+    mapped_file file_;
+    char sep_;
+};
+
+} // namespace pyl
+
+// Elements point into the mapping, not into the view object
+template <>
+inline constexpr bool std::ranges::enable_borrowed_range<pyl::kv_view> = true;
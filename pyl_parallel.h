@@ -0,0 +1,216 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <vector>
+
+#include "pyl_executor.h"
+
+namespace pyl {
+
+// ---------------------------------------------------------
+// Execution policies for the pyl algorithms
+//
+//   pyl::sum(pyl::par, v);                  // chunked across threads
+//   pyl::reduce(pyl::par_unseq, v, 0, op);  // threads + vector kernel
+//
+//   seq       – in order, one thread (same as the plain overloads)
+//   unseq     – one thread, multi-accumulator (vectorizable) kernel
+//   par       – fixed-size chunks on the shared executor
+//   par_unseq – par with the vectorizable kernel per chunk
+//
+// Chunk boundaries depend only on the input size, never on the number
+// of threads, so parallel results are reproducible run to run.
+// ---------------------------------------------------------
+
+struct sequenced_policy {};
+struct unsequenced_policy {};
+struct parallel_policy {};
+struct parallel_unsequenced_policy {};
+
+inline constexpr sequenced_policy            seq{};
+inline constexpr unsequenced_policy          unseq{};
+inline constexpr parallel_policy             par{};
+inline constexpr parallel_unsequenced_policy par_unseq{};
+
+template <class P>
+concept execution_policy =
+    std::is_same_v<std::remove_cvref_t<P>, sequenced_policy> ||
+    std::is_same_v<std::remove_cvref_t<P>, unsequenced_policy> ||
+    std::is_same_v<std::remove_cvref_t<P>, parallel_policy> ||
+    std::is_same_v<std::remove_cvref_t<P>, parallel_unsequenced_policy>;
+
+template <class P>
+inline constexpr bool is_parallel_policy_v =
+    std::is_same_v<std::remove_cvref_t<P>, parallel_policy> ||
+    std::is_same_v<std::remove_cvref_t<P>, parallel_unsequenced_policy>;
+
+template <class P>
+inline constexpr bool is_unsequenced_policy_v =
+    std::is_same_v<std::remove_cvref_t<P>, unsequenced_policy> ||
+    std::is_same_v<std::remove_cvref_t<P>, parallel_unsequenced_policy>;
+
+// Floating-point summation strategy
+//   Fast     – plain (multi-accumulator) addition
+//   Pairwise – blocked pairwise summation, O(log n) error growth
+//   Kahan    – compensated (Neumaier) summation, near-exact
+enum class SumMode { Fast, Pairwise, Kahan };
+
+namespace parallel_detail {
+
+// Elements per parallel chunk (fixed => deterministic partials)
+inline constexpr std::size_t chunk_size = std::size_t{1} << 15;
+
+inline std::size_t chunk_count(std::size_t n) noexcept {
+    return (n + chunk_size - 1) / chunk_size;
+}
+
+// Run fn(chunk_index, begin, end) for every `grain`-sized chunk of
+// [0, n) on the current scheduler (the shared pyl::executor unless one
+// was installed). The first exception thrown by fn is rethrown on the
+// caller.
+template <class Fn>
+void for_each_chunk(std::size_t n, std::size_t grain, Fn&& fn) {
+    grain = std::max<std::size_t>(1, grain);
+    const std::size_t chunks = (n + grain - 1) / grain;
+    if (chunks == 0) return;
+
+    auto run_chunk = [&](std::size_t c) {
+        std::size_t b = c * grain;
+        fn(c, b, std::min(n, b + grain));
+    };
+    if (chunks == 1) {
+        run_chunk(0);
+    } else {
+        current_scheduler().bulk(chunks, run_chunk);
+    }
+}
+
+// Fixed chunk_size chunks (deterministic reductions)
+template <class Fn>
+void for_each_chunk(std::size_t n, Fn&& fn) {
+    for_each_chunk(n, chunk_size, std::forward<Fn>(fn));
+}
+
+// Grain giving each thread several chunks (for searches, where load
+// balance matters more than reproducible chunk boundaries)
+inline std::size_t balanced_grain(std::size_t n) noexcept {
+    return executor_detail::auto_grain(n, current_scheduler());
+}
+
+// ---- summation kernels over [p, p + n) ----
+
+template <class T>
+T sum_sequential(const T* p, std::size_t n) noexcept {
+    T acc{};
+    for (std::size_t i = 0; i < n; ++i) acc = static_cast<T>(acc + p[i]);
+    return acc;
+}
+
+// Independent accumulators break the loop-carried dependency so the
+// compiler can keep several vector lanes in flight.
+template <class T>
+T sum_unrolled(const T* p, std::size_t n) noexcept {
+    constexpr std::size_t lanes = 8;
+    T acc[lanes] = {};
+    std::size_t i = 0;
+    for (; i + lanes <= n; i += lanes) {
+        for (std::size_t l = 0; l < lanes; ++l) {
+            acc[l] = static_cast<T>(acc[l] + p[i + l]);
+        }
+    }
+    T tail{};
+    for (; i < n; ++i) tail = static_cast<T>(tail + p[i]);
+
+    // fixed combination order
+    for (std::size_t w = lanes / 2; w > 0; w /= 2) {
+        for (std::size_t l = 0; l < w; ++l) acc[l] = static_cast<T>(acc[l] + acc[l + w]);
+    }
+    return static_cast<T>(acc[0] + tail);
+}
+
+template <class T>
+T sum_pairwise(const T* p, std::size_t n) noexcept {
+    constexpr std::size_t block = 128;
+    if (n <= block) return sum_unrolled(p, n);
+    std::size_t half = n / 2;
+    return static_cast<T>(sum_pairwise(p, half) + sum_pairwise(p + half, n - half));
+}
+
+// Neumaier variant of Kahan summation (also handles |x| > |sum|)
+template <class T>
+struct kahan_acc {
+    T sum{};
+    T comp{};
+
+    void add(T x) noexcept {
+        T t = sum + x;
+        if (std::abs(sum) >= std::abs(x)) {
+            comp += (sum - t) + x;
+        } else {
+            comp += (x - t) + sum;
+        }
+        sum = t;
+    }
+    void add(const kahan_acc& other) noexcept {
+        add(other.sum);
+        add(other.comp);
+    }
+    T result() const noexcept { return sum + comp; }
+};
+
+template <class T>
+kahan_acc<T> sum_kahan(const T* p, std::size_t n) noexcept {
+    kahan_acc<T> acc;
+    for (std::size_t i = 0; i < n; ++i) acc.add(p[i]);
+    return acc;
+}
+
+// Sum [p, p + n) with the given policy and mode
+template <class Policy, class T>
+T sum_contiguous(const Policy&, const T* p, std::size_t n, SumMode mode) {
+    const bool use_kahan    = std::is_floating_point_v<T> && mode == SumMode::Kahan;
+    const bool use_pairwise = std::is_floating_point_v<T> && mode == SumMode::Pairwise;
+
+    auto chunk_sum = [&](const T* q, std::size_t m) -> T {
+        if (use_pairwise) return sum_pairwise(q, m);
+        if constexpr (is_unsequenced_policy_v<Policy>) {
+            return sum_unrolled(q, m);
+        } else {
+            return sum_sequential(q, m);
+        }
+    };
+
+    if constexpr (!is_parallel_policy_v<Policy>) {
+        if constexpr (std::is_floating_point_v<T>) {
+            if (use_kahan) return sum_kahan(p, n).result();
+        }
+        return chunk_sum(p, n);
+    } else {
+        std::size_t chunks = chunk_count(n);
+        if constexpr (std::is_floating_point_v<T>) {
+            if (use_kahan) {
+                std::vector<kahan_acc<T>> partial(chunks);
+                for_each_chunk(n, [&](std::size_t c, std::size_t b, std::size_t e) {
+                    partial[c] = sum_kahan(p + b, e - b);
+                });
+                kahan_acc<T> total;
+                for (const auto& k : partial) total.add(k);
+                return total.result();
+            }
+        }
+        std::vector<T> partial(chunks);
+        for_each_chunk(n, [&](std::size_t c, std::size_t b, std::size_t e) {
+            partial[c] = chunk_sum(p + b, e - b);
+        });
+        return use_pairwise ? sum_pairwise(partial.data(), partial.size())
+                            : sum_sequential(partial.data(), partial.size());
+    }
+}
+
+} // namespace parallel_detail
+
+} // namespace pyl
@@ -1,14 +1,19 @@
 #pragma once
 
 #include <ranges>
+#include <span>
 #include <vector>
 #include <utility>
 #include <tuple>
 #include <cstddef>
 #include <functional>
+#include <optional>
 #include <algorithm>
+#include <atomic>
 #include <type_traits>
 
+#include "pyl_parallel.h"
+
 namespace pyl {
 
 // ---------------------------------------------------------
@@ -24,22 +29,40 @@ concept PairLikeRange =
         std::get<1>(ref);
     };
 
+namespace ranges_detail {
+
+// std::get<I> that never returns a reference into a temporary: ranges
+// yielding pairs by value (kv_view, zip-like adaptors) get the element
+// by value, reference members and lvalue pairs stay references.
+template <std::size_t I>
+struct get_element_fn {
+    template <class KV>
+    constexpr decltype(auto) operator()(KV&& kv) const {
+        if constexpr (std::is_lvalue_reference_v<KV>) {
+            return std::get<I>(kv);
+        } else {
+            using E = std::tuple_element_t<I, std::remove_cvref_t<KV>>;
+            if constexpr (std::is_reference_v<E>) {
+                return static_cast<E>(std::get<I>(kv));
+            } else {
+                return static_cast<std::remove_cv_t<E>>(std::get<I>(std::move(kv)));
+            }
+        }
+    }
+};
+
+} // namespace ranges_detail
+
 // keys(range) -> view of first element of each pair
 template <PairLikeRange R>
 auto keys(R&& r) {
-    return std::forward<R>(r)
-         | std::views::transform([](auto&& kv) -> decltype(auto) {
-               return std::get<0>(std::forward<decltype(kv)>(kv));
-           });
+    return std::forward<R>(r) | std::views::transform(ranges_detail::get_element_fn<0>{});
 }
 
 // values(range) -> view of second element of each pair
 template <PairLikeRange R>
 auto values(R&& r) {
-    return std::forward<R>(r)
-         | std::views::transform([](auto&& kv) -> decltype(auto) {
-               return std::get<1>(std::forward<decltype(kv)>(kv));
-           });
+    return std::forward<R>(r) | std::views::transform(ranges_detail::get_element_fn<1>{});
 }
 
 // pairs(range) – identity, but keeps the symmetric API
@@ -50,18 +73,124 @@ auto pairs(R&& r) {
 
 // ---------------------------------------------------------
 // to_vector(range): materialize any input_range into std::vector
+//
+// Sized ranges reserve up front. Elements are moved when the range is
+// an owning rvalue (e.g. to_vector(std::move(v))) or yields rvalues.
 // ---------------------------------------------------------
 
 template <std::ranges::input_range R>
 auto to_vector(R&& r) {
     using T = std::ranges::range_value_t<R>;
+    constexpr bool owns_elements =
+        !std::is_lvalue_reference_v<R> && !std::ranges::view<std::remove_cvref_t<R>>;
+
     std::vector<T> out;
+    if constexpr (std::ranges::sized_range<R>) {
+        out.reserve(static_cast<std::size_t>(std::ranges::size(r)));
+    }
     for (auto&& e : r) {
-        out.emplace_back(e);
+        if constexpr (owns_elements && !std::is_const_v<std::remove_reference_t<decltype(e)>>) {
+            out.emplace_back(std::move(e));
+        } else {
+            out.emplace_back(std::forward<decltype(e)>(e));
+        }
     }
     return out;
 }
 
+// ---------------------------------------------------------
+// to_vector(policy, range): parallel materialization
+//
+//   auto rows = pyl::to_vector(pyl::par, v | MAP(x, f(x)) | IF(y, y > 0));
+//
+// - random-access sized ranges are filled chunk by chunk in place
+// - a filter over a random-access sized range (IF as the last stage)
+//   is filtered per chunk, then the chunks are scattered to their
+//   final offsets
+// - anything else is materialized sequentially
+// Order is preserved in all cases.
+// ---------------------------------------------------------
+
+namespace ranges_detail {
+
+template <class R>
+struct is_filter_view : std::false_type {};
+
+template <class V, class Pred>
+struct is_filter_view<std::ranges::filter_view<V, Pred>> : std::true_type {};
+
+template <class T>
+inline constexpr bool parallel_fill_v =
+    std::is_default_constructible_v<T> && std::is_move_assignable_v<T>;
+
+template <class R>
+concept random_access_sized =
+    std::ranges::random_access_range<R> && std::ranges::sized_range<R>;
+
+// filter_view whose base can be split into chunks
+template <class F>
+concept chunkable_filter_view =
+    is_filter_view<F>::value &&
+    random_access_sized<decltype(std::declval<const F&>().base())>;
+
+// Count-then-scatter materialization of `base | filter(pred)`
+template <class T, class Base, class Pred>
+std::vector<T> parallel_filter_to_vector(Base base, const Pred& pred) {
+    auto n = static_cast<std::size_t>(std::ranges::size(base));
+    auto first = std::ranges::begin(base);
+
+    // pass 1: filter each chunk into a local buffer
+    std::vector<std::vector<T>> local(parallel_detail::chunk_count(n));
+    parallel_detail::for_each_chunk(n, [&](std::size_t c, std::size_t b, std::size_t e) {
+        auto it = first + static_cast<std::ranges::range_difference_t<Base>>(b);
+        for (std::size_t i = b; i < e; ++i, ++it) {
+            decltype(auto) x = *it;
+            if (std::invoke(pred, x)) {
+                local[c].emplace_back(std::forward<decltype(x)>(x));
+            }
+        }
+    });
+
+    // pass 2: prefix offsets, then move every chunk to its place
+    std::vector<std::size_t> offset(local.size() + 1, 0);
+    for (std::size_t c = 0; c < local.size(); ++c) {
+        offset[c + 1] = offset[c] + local[c].size();
+    }
+    std::vector<T> out(offset.back());
+    parallel_detail::for_each_chunk(n, [&](std::size_t c, std::size_t, std::size_t) {
+        std::move(local[c].begin(), local[c].end(),
+                  out.begin() + static_cast<std::ptrdiff_t>(offset[c]));
+    });
+    return out;
+}
+
+} // namespace ranges_detail
+
+template <execution_policy P, std::ranges::input_range R>
+auto to_vector(const P&, R&& r) {
+    using T    = std::ranges::range_value_t<R>;
+    using Bare = std::remove_cvref_t<R>;
+
+    if constexpr (!is_parallel_policy_v<P> || !ranges_detail::parallel_fill_v<T>) {
+        return to_vector(std::forward<R>(r));
+    } else if constexpr (ranges_detail::random_access_sized<R>) {
+        auto n = static_cast<std::size_t>(std::ranges::size(r));
+        std::vector<T> out(n);
+        auto first = std::ranges::begin(r);
+        parallel_detail::for_each_chunk(n, [&](std::size_t, std::size_t b, std::size_t e) {
+            auto it = first + static_cast<std::ranges::range_difference_t<R>>(b);
+            for (std::size_t i = b; i < e; ++i, ++it) {
+                out[i] = *it;
+            }
+        });
+        return out;
+    } else if constexpr (ranges_detail::chunkable_filter_view<Bare>) {
+        return ranges_detail::parallel_filter_to_vector<T>(r.base(), r.pred());
+    } else {
+        return to_vector(std::forward<R>(r));
+    }
+}
+
 // ---------------------------------------------------------
 // reduce / sum – Python-like reduction helpers
 // ---------------------------------------------------------
@@ -88,6 +217,91 @@ auto sum(R&& r) {
     return reduce(std::forward<R>(r), V{});
 }
 
+// ---------------------------------------------------------
+// reduce / sum with an execution policy (see pyl_parallel.h)
+//
+//   double s = pyl::sum(pyl::par_unseq, metrics);
+//   double k = pyl::sum(pyl::par, metrics, pyl::SumMode::Kahan);
+//   int    p = pyl::reduce(pyl::par, v, 1, std::multiplies<>{});
+//
+// The parallel overloads need `op` to be associative; chunks of
+// random-access ranges are reduced concurrently and combined in
+// order. Other ranges fall back to the sequential loop.
+// ---------------------------------------------------------
+
+namespace ranges_detail {
+
+template <class R>
+concept contiguous_arithmetic_range =
+    std::ranges::contiguous_range<R> && std::ranges::sized_range<R> &&
+    std::is_arithmetic_v<std::ranges::range_value_t<R>>;
+
+template <class Op, class V>
+inline constexpr bool is_plus_v =
+    std::is_same_v<Op, std::plus<>> || std::is_same_v<Op, std::plus<V>>;
+
+} // namespace ranges_detail
+
+template <execution_policy P, std::ranges::input_range R, class T, class Op>
+T reduce(const P& policy, R&& r, T init, Op op) {
+    using V = std::ranges::range_value_t<R>;
+
+    if constexpr (ranges_detail::contiguous_arithmetic_range<R> &&
+                  ranges_detail::is_plus_v<Op, V> && std::is_same_v<T, V>) {
+        return static_cast<T>(init + parallel_detail::sum_contiguous(
+            policy, std::ranges::data(r), std::ranges::size(r), SumMode::Fast));
+    } else if constexpr (is_parallel_policy_v<P> &&
+                         std::ranges::random_access_range<R> &&
+                         std::ranges::sized_range<R> &&
+                         std::constructible_from<T, std::ranges::range_reference_t<R>> &&
+                         std::is_invocable_r_v<T, Op&, T, T>) {
+        auto first = std::ranges::begin(r);
+        auto n = static_cast<std::size_t>(std::ranges::size(r));
+        std::vector<std::optional<T>> partial(parallel_detail::chunk_count(n));
+
+        parallel_detail::for_each_chunk(n, [&](std::size_t c, std::size_t b, std::size_t e) {
+            auto it = first + static_cast<std::ranges::range_difference_t<R>>(b);
+            T acc(*it);
+            for (std::size_t i = b + 1; i < e; ++i) {
+                ++it;
+                acc = op(std::move(acc), *it);
+            }
+            partial[c].emplace(std::move(acc));
+        });
+
+        for (auto& p : partial) {
+            init = op(std::move(init), std::move(*p));
+        }
+        return init;
+    } else {
+        return reduce(std::forward<R>(r), std::move(init), std::move(op));
+    }
+}
+
+template <execution_policy P, std::ranges::input_range R, class T>
+T reduce(const P& policy, R&& r, T init) {
+    return reduce(policy, std::forward<R>(r), std::move(init), std::plus<>{});
+}
+
+// sum(policy, range, mode) – `mode` selects the floating-point strategy
+template <execution_policy P, std::ranges::input_range R>
+auto sum(const P& policy, R&& r, SumMode mode = SumMode::Fast) {
+    using V = std::ranges::range_value_t<R>;
+
+    if constexpr (ranges_detail::contiguous_arithmetic_range<R>) {
+        return parallel_detail::sum_contiguous(
+            policy, std::ranges::data(r), std::ranges::size(r), mode);
+    } else if constexpr (std::is_floating_point_v<V>) {
+        if (mode != SumMode::Fast) {
+            auto tmp = to_vector(std::forward<R>(r));
+            return parallel_detail::sum_contiguous(policy, tmp.data(), tmp.size(), mode);
+        }
+        return reduce(policy, std::forward<R>(r), V{});
+    } else {
+        return reduce(policy, std::forward<R>(r), V{});
+    }
+}
+
 // ---------------------------------------------------------
 // ANY / ALL – Python-like any() / all()
 // ---------------------------------------------------------
@@ -98,6 +312,58 @@ auto sum(R&& r) {
 #define ALL(range, var, expr) \
     std::ranges::all_of((range), [&](const auto& var) { return (expr); })
 
+// ---------------------------------------------------------
+// any_of / all_of / none_of with an execution policy, PANY / PALL
+//
+//   bool bad = PANY(rows, r, !validate(r));   // parallel, stops early
+//   bool ok  = PALL(rows, r, validate(r));
+//
+// Parallel versions split random-access sized ranges over threads
+// that share one cancellation flag: as soon as a witness is found,
+// the other workers stop after their current element.
+// ---------------------------------------------------------
+
+template <execution_policy P, std::ranges::input_range R, class Pred>
+bool any_of(const P&, R&& r, Pred pred) {
+    if constexpr (is_parallel_policy_v<P> && ranges_detail::random_access_sized<R>) {
+        auto first = std::ranges::begin(r);
+        auto n = static_cast<std::size_t>(std::ranges::size(r));
+        std::atomic<bool> found{false};
+
+        parallel_detail::for_each_chunk(n, parallel_detail::balanced_grain(n),
+            [&](std::size_t, std::size_t b, std::size_t e) {
+                auto it = first + static_cast<std::ranges::range_difference_t<R>>(b);
+                for (std::size_t i = b; i < e; ++i, ++it) {
+                    if (found.load(std::memory_order_relaxed)) return;
+                    if (std::invoke(pred, *it)) {
+                        found.store(true, std::memory_order_relaxed);
+                        return;
+                    }
+                }
+            });
+        return found.load(std::memory_order_relaxed);
+    } else {
+        return std::ranges::any_of(r, std::move(pred));
+    }
+}
+
+template <execution_policy P, std::ranges::input_range R, class Pred>
+bool none_of(const P& policy, R&& r, Pred pred) {
+    return !any_of(policy, std::forward<R>(r), std::move(pred));
+}
+
+template <execution_policy P, std::ranges::input_range R, class Pred>
+bool all_of(const P& policy, R&& r, Pred pred) {
+    return !any_of(policy, std::forward<R>(r),
+                   [&pred](auto&& x) { return !std::invoke(pred, std::forward<decltype(x)>(x)); });
+}
+
+#define PANY(range, var, expr) \
+    pyl::any_of(pyl::par, (range), [&](const auto& var) { return (expr); })
+
+#define PALL(range, var, expr) \
+    pyl::all_of(pyl::par, (range), [&](const auto& var) { return (expr); })
+
 // ---------------------------------------------------------
 // IF – Python-style filtering
 //
@@ -142,28 +408,390 @@ auto sum(R&& r) {
 #define GET_MACRO_MAP(_1, _2, _3, NAME, ...) NAME
 #define MAP(...) GET_MACRO_MAP(__VA_ARGS__, MAP3, MAP2)(__VA_ARGS__)
 
+// ---------------------------------------------------------
+// enumerate_view – (index, element) pairs, index taken from the
+// iterator position
+//
+// Keeps the category of the underlying range up to random access
+// and stays sized, so it can be iterated twice, split into chunks or
+// handed to the parallel algorithms. Elements are
+// std::pair<std::size_t, range_reference_t<V>> (no copies, and
+// assigning through the second member writes to the source);
+// value_type holds a copy, so to_vector() owns its elements.
+// ---------------------------------------------------------
+
+template <std::ranges::view V>
+    requires std::ranges::input_range<V>
+class enumerate_view : public std::ranges::view_interface<enumerate_view<V>> {
+    template <bool Const>
+    using base_t = std::conditional_t<Const, const V, V>;
+
+    template <bool Const>
+    class sentinel;
+
+    template <bool Const>
+    class iterator {
+        using Base = base_t<Const>;
+        using base_iter = std::ranges::iterator_t<Base>;
+
+        base_iter current_{};
+        std::size_t index_ = 0;
+
+        template <bool> friend class sentinel;
+
+    public:
+        using iterator_concept =
+            std::conditional_t<std::ranges::random_access_range<Base>, std::random_access_iterator_tag,
+            std::conditional_t<std::ranges::bidirectional_range<Base>, std::bidirectional_iterator_tag,
+            std::conditional_t<std::ranges::forward_range<Base>, std::forward_iterator_tag,
+                               std::input_iterator_tag>>>;
+        using reference       = std::pair<std::size_t, std::ranges::range_reference_t<Base>>;
+        // materializing (to_vector, ranges::to) copies the elements
+        using value_type      = std::pair<std::size_t, std::ranges::range_value_t<Base>>;
+        using difference_type = std::ranges::range_difference_t<Base>;
+
+        iterator() requires std::default_initializable<base_iter> = default;
+        iterator(base_iter current, std::size_t index)
+            : current_(std::move(current)), index_(index) {}
+
+        const base_iter& base() const& noexcept { return current_; }
+        std::size_t index() const noexcept { return index_; }
+
+        reference operator*() const { return reference(index_, *current_); }
+        reference operator[](difference_type k) const
+            requires std::ranges::random_access_range<Base> {
+            return *(*this + k);
+        }
+
+        iterator& operator++() { ++current_; ++index_; return *this; }
+        void operator++(int) requires (!std::ranges::forward_range<Base>) { ++*this; }
+        iterator operator++(int) requires std::ranges::forward_range<Base> {
+            auto t = *this; ++*this; return t;
+        }
+
+        iterator& operator--() requires std::ranges::bidirectional_range<Base> {
+            --current_; --index_; return *this;
+        }
+        iterator operator--(int) requires std::ranges::bidirectional_range<Base> {
+            auto t = *this; --*this; return t;
+        }
+
+        iterator& operator+=(difference_type k) requires std::ranges::random_access_range<Base> {
+            current_ += k;
+            index_ = static_cast<std::size_t>(static_cast<difference_type>(index_) + k);
+            return *this;
+        }
+        iterator& operator-=(difference_type k) requires std::ranges::random_access_range<Base> {
+            return *this += -k;
+        }
+
+        friend iterator operator+(iterator it, difference_type k)
+            requires std::ranges::random_access_range<Base> { return it += k; }
+        friend iterator operator+(difference_type k, iterator it)
+            requires std::ranges::random_access_range<Base> { return it += k; }
+        friend iterator operator-(iterator it, difference_type k)
+            requires std::ranges::random_access_range<Base> { return it -= k; }
+        friend difference_type operator-(const iterator& a, const iterator& b)
+            requires std::ranges::random_access_range<Base> {
+            return a.current_ - b.current_;
+        }
+
+        friend bool operator==(const iterator& a, const iterator& b)
+            requires std::equality_comparable<base_iter> {
+            return a.current_ == b.current_;
+        }
+        friend auto operator<=>(const iterator& a, const iterator& b)
+            requires std::ranges::random_access_range<Base> {
+            return a.index_ <=> b.index_;
+        }
+    };
+
+    template <bool Const>
+    class sentinel {
+        using Base = base_t<Const>;
+
+        std::ranges::sentinel_t<Base> end_{};
+
+    public:
+        sentinel() = default;
+        explicit sentinel(std::ranges::sentinel_t<Base> end) : end_(std::move(end)) {}
+
+        friend bool operator==(const iterator<Const>& it, const sentinel& s) {
+            return it.base() == s.end_;
+        }
+    };
+
+    // An end iterator needs the element count as its index; without a
+    // size the view ends in a sentinel (so it is not common, and
+    // std::views::reverse walks forward to the end once to find it)
+    template <bool Const>
+    auto make_end(base_t<Const>& base) const {
+        if constexpr (std::ranges::common_range<base_t<Const>> &&
+                      std::ranges::sized_range<base_t<Const>>) {
+            return iterator<Const>(std::ranges::end(base),
+                                   static_cast<std::size_t>(std::ranges::size(base)));
+        } else {
+            return sentinel<Const>(std::ranges::end(base));
+        }
+    }
+
+    V base_ = V();
+
+public:
+    enumerate_view() requires std::default_initializable<V> = default;
+    explicit enumerate_view(V base) : base_(std::move(base)) {}
+
+    V base() const& requires std::copy_constructible<V> { return base_; }
+    V base() && { return std::move(base_); }
+
+    auto begin() { return iterator<false>(std::ranges::begin(base_), 0); }
+    auto begin() const requires std::ranges::input_range<const V> {
+        return iterator<true>(std::ranges::begin(base_), 0);
+    }
+
+    auto end() { return make_end<false>(base_); }
+    auto end() const requires std::ranges::input_range<const V> { return make_end<true>(base_); }
+
+    auto size() requires std::ranges::sized_range<V> { return std::ranges::size(base_); }
+    auto size() const requires std::ranges::sized_range<const V> { return std::ranges::size(base_); }
+};
+
+template <class R>
+enumerate_view(R&&) -> enumerate_view<std::views::all_t<R>>;
+
+namespace ranges_detail {
+
+struct enumerate_fn {
+    template <std::ranges::viewable_range R>
+    auto operator()(R&& r) const {
+        return enumerate_view(std::views::all(std::forward<R>(r)));
+    }
+
+    template <std::ranges::viewable_range R>
+    friend auto operator|(R&& r, const enumerate_fn& e) {
+        return e(std::forward<R>(r));
+    }
+};
+
+// range | enumerate, then (index, key, value) tuples for pair-like elements
+struct enumerate_kv_fn {
+    template <std::ranges::viewable_range R>
+    friend auto operator|(R&& r, const enumerate_kv_fn&) {
+        // (index, key, value) by value, so materialized tuples own their parts
+        return enumerate_view(std::views::all(std::forward<R>(r)))
+             | std::views::transform([](auto e) {
+                   auto&& kv = e.second;
+                   using K = std::remove_cvref_t<decltype(std::get<0>(kv))>;
+                   using V = std::remove_cvref_t<decltype(std::get<1>(kv))>;
+                   return std::tuple<std::size_t, K, V>(e.first, std::get<0>(kv), std::get<1>(kv));
+               });
+    }
+};
+
+} // namespace ranges_detail
+
+inline constexpr ranges_detail::enumerate_fn enumerate{};
+
 // ---------------------------------------------------------
 // ENUM – Python-style enumerate()
 //
 //   range | ENUM(i, x)       -> (index, value)
-//   range | ENUM(i, k, v)    -> (index, key, value) for pair-like
+//   range | ENUM(i, k, v)    -> (index, key, value) for pair-like,
+//                               copied out of the element
+//
+// The names only document intent; the view is enumerate_view, so
+// indices are stable across re-iteration and random access.
 // ---------------------------------------------------------
 
 // ENUM(i, x)
-#define ENUM2(i, x) \
-    std::views::transform([i = std::size_t{0}](auto&& x) mutable { \
-        return std::pair(i++, std::forward<decltype(x)>(x));       \
-    })
+#define ENUM2(i, x) pyl::enumerate
 
 // ENUM(i, k, v) – for pair-like
-#define ENUM3(i, k, v) \
-    std::views::transform([i = std::size_t{0}](auto&& __kv) mutable { \
-        auto&& k = std::get<0>(__kv);                                 \
-        auto&& v = std::get<1>(__kv);                                 \
-        return std::tuple(i++, k, v);                                 \
-    })
+#define ENUM3(i, k, v) pyl::ranges_detail::enumerate_kv_fn{}
 
 #define GET_MACRO_ENUM(_1, _2, _3, NAME, ...) NAME
 #define ENUM(...) GET_MACRO_ENUM(__VA_ARGS__, ENUM3, ENUM2)(__VA_ARGS__)
 
+// ---------------------------------------------------------
+// CHUNK – split a contiguous range into fixed-size spans
+//
+//   for (std::span<const float> block : samples | CHUNK(256)) { ... }
+//
+// Every block has n elements except possibly the last one. The view
+// is random access and sized.
+// ---------------------------------------------------------
+
+template <class T>
+class chunk_view : public std::ranges::view_interface<chunk_view<T>> {
+public:
+    class iterator {
+    public:
+        using iterator_concept  = std::random_access_iterator_tag;
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type        = std::span<T>;
+        using difference_type   = std::ptrdiff_t;
+
+        iterator() = default;
+        iterator(std::span<T> data, std::size_t n, std::size_t index) noexcept
+            : data_(data), n_(n), index_(index) {}
+
+        std::span<T> operator*() const noexcept {
+            std::size_t b = index_ * n_;
+            return data_.subspan(b, std::min(n_, data_.size() - b));
+        }
+        std::span<T> operator[](difference_type k) const noexcept { return *(*this + k); }
+
+        iterator& operator++() noexcept { ++index_; return *this; }
+        iterator operator++(int) noexcept { auto t = *this; ++index_; return t; }
+        iterator& operator--() noexcept { --index_; return *this; }
+        iterator operator--(int) noexcept { auto t = *this; --index_; return t; }
+
+        iterator& operator+=(difference_type k) noexcept {
+            index_ = static_cast<std::size_t>(static_cast<difference_type>(index_) + k);
+            return *this;
+        }
+        iterator& operator-=(difference_type k) noexcept { return *this += -k; }
+
+        friend iterator operator+(iterator it, difference_type k) noexcept { return it += k; }
+        friend iterator operator+(difference_type k, iterator it) noexcept { return it += k; }
+        friend iterator operator-(iterator it, difference_type k) noexcept { return it -= k; }
+        friend difference_type operator-(const iterator& a, const iterator& b) noexcept {
+            return static_cast<difference_type>(a.index_) - static_cast<difference_type>(b.index_);
+        }
+
+        friend bool operator==(const iterator& a, const iterator& b) noexcept { return a.index_ == b.index_; }
+        friend auto operator<=>(const iterator& a, const iterator& b) noexcept { return a.index_ <=> b.index_; }
+
+    private:
+        std::span<T> data_{};
+        std::size_t n_ = 1;
+        std::size_t index_ = 0;
+    };
+
+    chunk_view() = default;
+    chunk_view(std::span<T> data, std::size_t n) noexcept
+        : data_(data), n_(n == 0 ? 1 : n) {}
+
+    iterator begin() const noexcept { return iterator(data_, n_, 0); }
+    iterator end() const noexcept { return iterator(data_, n_, size()); }
+    std::size_t size() const noexcept { return (data_.size() + n_ - 1) / n_; }
+
+private:
+    std::span<T> data_{};
+    std::size_t n_ = 1;
+};
+
+namespace ranges_detail {
+
+struct chunk_fn {
+    std::size_t n;
+
+    template <std::ranges::contiguous_range R>
+        requires std::ranges::sized_range<R> && std::ranges::borrowed_range<R>
+    friend auto operator|(R&& r, const chunk_fn& c) {
+        using T = std::remove_reference_t<std::ranges::range_reference_t<R>>;
+        return chunk_view<T>(std::span<T>(std::ranges::data(r), std::ranges::size(r)), c.n);
+    }
+};
+
+// Predicates BIF evaluates into one mask before compacting
+inline constexpr std::size_t batch_block = 256;
+
+template <class F>
+struct batch_map_fn {
+    F f;
+
+    template <std::ranges::contiguous_range R>
+        requires std::ranges::sized_range<R>
+    friend auto operator|(R&& r, const batch_map_fn& m) {
+        const auto* p = std::ranges::data(r);
+        auto n = static_cast<std::size_t>(std::ranges::size(r));
+        using U = std::remove_cvref_t<std::invoke_result_t<const F&, decltype(*p)>>;
+
+        std::vector<U> out;
+        out.reserve(n);
+        for (std::size_t i = 0; i < n; ++i) out.push_back(m.f(p[i]));
+        return out;
+    }
+};
+
+template <class F>
+struct batch_filter_fn {
+    F f;
+
+    template <std::ranges::contiguous_range R>
+        requires std::ranges::sized_range<R>
+    friend auto operator|(R&& r, const batch_filter_fn& flt) {
+        const auto* p = std::ranges::data(r);
+        auto n = static_cast<std::size_t>(std::ranges::size(r));
+        using T = std::ranges::range_value_t<R>;
+
+        std::vector<T> out;
+        unsigned char mask[batch_block];
+        if constexpr (std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T>) {
+            // branch-free compaction: always store, advance by the mask
+            out.resize(n);
+            T* o = out.data();
+            std::size_t k = 0;
+            for (std::size_t b = 0; b < n; b += batch_block) {
+                std::size_t len = std::min(batch_block, n - b);
+                for (std::size_t i = 0; i < len; ++i) {
+                    mask[i] = flt.f(p[b + i]) ? 1 : 0;
+                }
+                for (std::size_t i = 0; i < len; ++i) {
+                    o[k] = p[b + i];
+                    k += mask[i];
+                }
+            }
+            out.resize(k);
+        } else {
+            for (std::size_t b = 0; b < n; b += batch_block) {
+                std::size_t len = std::min(batch_block, n - b);
+                for (std::size_t i = 0; i < len; ++i) {
+                    mask[i] = flt.f(p[b + i]) ? 1 : 0;
+                }
+                for (std::size_t i = 0; i < len; ++i) {
+                    if (mask[i]) out.push_back(p[b + i]);
+                }
+            }
+        }
+        return out;
+    }
+};
+
+} // namespace ranges_detail
+
+inline ranges_detail::chunk_fn chunk(std::size_t n) noexcept {
+    return ranges_detail::chunk_fn{n};
+}
+
+template <class F>
+ranges_detail::batch_map_fn<F> batch_map(F f) {
+    return {std::move(f)};
+}
+
+template <class F>
+ranges_detail::batch_filter_fn<F> batch_filter(F f) {
+    return {std::move(f)};
+}
+
+#define CHUNK(n) pyl::chunk(n)
+
+// ---------------------------------------------------------
+// BMAP / BIF – eager, block-wise MAP / IF for contiguous ranges
+//
+//   auto hot = samples | BMAP(x, x * scale) | BIF(y, y > limit);
+//
+// Both run plain loops over the array (no view iterator machinery)
+// and return a std::vector. BMAP is one pass into a reserved output;
+// BIF evaluates a block of predicates into a mask first, so that loop
+// has no branches, then compacts the block into the output.
+// ---------------------------------------------------------
+
+#define BMAP(var, expr) \
+    pyl::batch_map([&](const auto& var) { return (expr); })
+
+#define BIF(var, expr) \
+    pyl::batch_filter([&](const auto& var) -> bool { return (expr); })
+
 } // namespace pyl
@@ -0,0 +1,141 @@
+#include "pyl_rcu.h"
+
+#include <array>
+#include <cassert>
+#include <deque>
+#include <functional>
+#include <thread>
+#include <vector>
+
+namespace pyl {
+
+namespace rcu_detail {
+
+alignas(64) std::atomic<std::uint64_t> global_epoch{1};
+
+namespace {
+
+// Records are never freed: a thread that exits marks its record
+// unused and the next new thread takes it over.
+std::atomic<thread_record*> records{nullptr};
+
+struct thread_slot {
+    thread_record* record = nullptr;
+    ~thread_slot() {
+        if (!record) return;
+        record->epoch.store(0, std::memory_order_release);
+        record->in_use.store(false, std::memory_order_release);
+        tls_record = nullptr;
+    }
+};
+
+thread_local thread_slot slot;
+
+struct retired {
+    std::uint64_t epoch;
+    void* p;
+    void (*destroy)(void*);
+};
+
+struct retire_list {
+    std::mutex mutex;
+    std::deque<retired> items;   // epochs non-decreasing
+};
+
+retire_list& retired_objects() {
+    static auto* list = new retire_list;   // outlives other statics' destructors
+    return *list;
+}
+
+// Move the epoch from g to g + 1 if every reader has seen g
+bool try_advance(std::uint64_t g) noexcept {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    for (thread_record* r = records.load(std::memory_order_acquire); r; r = r->next) {
+        std::uint64_t e = r->epoch.load(std::memory_order_acquire);
+        if (e != 0 && e != g) return false;
+    }
+    return global_epoch.compare_exchange_strong(g, g + 1, std::memory_order_seq_cst);
+}
+
+// Pop everything retired two or more epochs ago (caller holds the mutex)
+std::vector<retired> collect(retire_list& list) {
+    std::vector<retired> ready;
+    std::uint64_t g = global_epoch.load(std::memory_order_seq_cst);
+    while (!list.items.empty() && list.items.front().epoch + 2 <= g) {
+        ready.push_back(list.items.front());
+        list.items.pop_front();
+    }
+    return ready;
+}
+
+void destroy_all(const std::vector<retired>& ready) {
+    for (const retired& r : ready) r.destroy(r.p);
+}
+
+} // namespace
+
+thread_record* register_thread() {
+    for (thread_record* r = records.load(std::memory_order_acquire); r; r = r->next) {
+        bool expected = false;
+        if (r->in_use.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+            r->nesting = 0;
+            slot.record = tls_record = r;
+            return r;
+        }
+    }
+    auto* r = new thread_record;
+    r->next = records.load(std::memory_order_relaxed);
+    while (!records.compare_exchange_weak(r->next, r, std::memory_order_release,
+                                          std::memory_order_relaxed)) {
+    }
+    slot.record = tls_record = r;
+    return r;
+}
+
+void retire(void* p, void (*destroy)(void*)) {
+    auto& list = retired_objects();
+    std::vector<retired> ready;
+    {
+        std::lock_guard<std::mutex> lk(list.mutex);
+        std::uint64_t g = global_epoch.load(std::memory_order_seq_cst);
+        list.items.push_back({g, p, destroy});
+        try_advance(g);
+        ready = collect(list);
+    }
+    destroy_all(ready);   // outside the lock: destructors may retire too
+}
+
+} // namespace rcu_detail
+
+void rcu_synchronize() {
+    using namespace rcu_detail;
+    assert((!tls_record || tls_record->nesting == 0) && "rcu_synchronize() inside a read section");
+
+    auto& list = retired_objects();
+    const std::uint64_t target = global_epoch.load(std::memory_order_seq_cst) + 2;
+    for (;;) {
+        std::uint64_t g = global_epoch.load(std::memory_order_seq_cst);
+        if (g >= target) break;
+        if (!try_advance(g)) std::this_thread::yield();
+    }
+    std::vector<retired> ready;
+    {
+        std::lock_guard<std::mutex> lk(list.mutex);
+        ready = collect(list);
+    }
+    destroy_all(ready);
+}
+
+std::size_t rcu_pending() {
+    auto& list = rcu_detail::retired_objects();
+    std::lock_guard<std::mutex> lk(list.mutex);
+    return list.items.size();
+}
+
+std::unique_lock<std::mutex> rcu_writer_lock(const void* key) {
+    static std::array<std::mutex, 64> stripes;
+    std::size_t h = std::hash<const void*>{}(key);
+    return std::unique_lock<std::mutex>(stripes[(h >> 3) % stripes.size()]);
+}
+
+} // namespace pyl
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+
+namespace pyl {
+
+// ---------------------------------------------------------
+// Epoch-based read-copy-update
+//
+// Readers enter a read section and load published pointers without
+// taking a lock or writing to any shared cache line. Writers build a
+// new version, publish it with one atomic exchange and retire the
+// old version; it is deleted once every reader that could still see
+// it has left its read section.
+//
+// Usage:
+//   pyl::rcu_ptr<const config> current;
+//
+//   {   // reader (any thread, any number of them)
+//       pyl::rcu_read_guard g;
+//       const config* c = current.load();
+//       use(c);                      // valid until g is destroyed
+//   }
+//
+//   {   // writer
+//       auto lk = pyl::rcu_writer_lock(&current);
+//       auto next = std::make_unique<config>(*current.load());
+//       next->limit = 10;
+//       current.store(next.release());   // old version retired
+//   }
+//
+// Read sections nest and are cheap (one thread-local store and a
+// fence). rcu_synchronize() waits until everything retired so far has
+// been deleted; it must not be called inside a read section.
+// ---------------------------------------------------------
+
+namespace rcu_detail {
+
+struct alignas(64) thread_record {
+    std::atomic<std::uint64_t> epoch{0};   // 0 = quiescent
+    std::atomic<bool> in_use{true};
+    unsigned nesting = 0;                  // owner thread only
+    thread_record* next = nullptr;         // immutable once linked
+};
+
+extern std::atomic<std::uint64_t> global_epoch;
+inline thread_local thread_record* tls_record = nullptr;
+
+thread_record* register_thread();
+void retire(void* p, void (*destroy)(void*));
+
+} // namespace rcu_detail
+
+inline void rcu_read_lock() noexcept {
+    rcu_detail::thread_record* r = rcu_detail::tls_record;
+    if (!r) r = rcu_detail::register_thread();
+    if (r->nesting++ == 0) {
+        r->epoch.store(rcu_detail::global_epoch.load(std::memory_order_relaxed),
+                       std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+}
+
+inline void rcu_read_unlock() noexcept {
+    rcu_detail::thread_record* r = rcu_detail::tls_record;
+    if (--r->nesting == 0) {
+        r->epoch.store(0, std::memory_order_release);
+    }
+}
+
+class rcu_read_guard {
+public:
+    rcu_read_guard() noexcept { rcu_read_lock(); }
+    ~rcu_read_guard() { rcu_read_unlock(); }
+
+    rcu_read_guard(const rcu_read_guard&)            = delete;
+    rcu_read_guard& operator=(const rcu_read_guard&) = delete;
+};
+
+// Delete p once all current readers are done with it
+template<typename T>
+void rcu_retire(T* p) {
+    if (!p) return;
+    rcu_detail::retire(const_cast<void*>(static_cast<const void*>(p)),
+                       [](void* q) { delete static_cast<T*>(q); });
+}
+
+// Block until every object retired before the call has been deleted
+void rcu_synchronize();
+
+// Number of retired objects not yet deleted (for tests and stats)
+std::size_t rcu_pending();
+
+// Serializes writers of one rcu_ptr (striped; no per-object mutex)
+[[nodiscard]] std::unique_lock<std::mutex> rcu_writer_lock(const void* key);
+
+// ---------------------------------------------------------
+// rcu_ptr<T> – owning pointer with RCU publication
+//
+// load() from a read section (or by a writer holding the writer
+// lock); store() publishes a new object and retires the old one.
+// Construction, moves and destruction need exclusive access, like
+// any other object.
+// ---------------------------------------------------------
+template<typename T>
+class rcu_ptr {
+public:
+    rcu_ptr() noexcept = default;
+    explicit rcu_ptr(T* p) noexcept : p_(p) {}
+
+    rcu_ptr(const rcu_ptr&)            = delete;
+    rcu_ptr& operator=(const rcu_ptr&) = delete;
+
+    rcu_ptr(rcu_ptr&& other) noexcept
+        : p_(other.p_.exchange(nullptr, std::memory_order_relaxed)) {}
+
+    rcu_ptr& operator=(rcu_ptr&& other) noexcept {
+        if (this != &other) {
+            delete p_.exchange(other.p_.exchange(nullptr, std::memory_order_relaxed),
+                               std::memory_order_relaxed);
+        }
+        return *this;
+    }
+
+    ~rcu_ptr() { delete p_.load(std::memory_order_relaxed); }
+
+    T* load() const noexcept { return p_.load(std::memory_order_acquire); }
+    explicit operator bool() const noexcept { return load() != nullptr; }
+
+    void store(T* p) {
+        rcu_retire(p_.exchange(p, std::memory_order_seq_cst));
+    }
+
+    // Install p only if nothing is published yet; false (and p is
+    // left to the caller) otherwise
+    bool publish_if_null(T* p) noexcept {
+        T* expected = nullptr;
+        return p_.compare_exchange_strong(expected, p, std::memory_order_acq_rel,
+                                          std::memory_order_acquire);
+    }
+
+    void swap(rcu_ptr& other) noexcept {
+        T* mine = p_.load(std::memory_order_relaxed);
+        p_.store(other.p_.exchange(mine, std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+
+    friend void swap(rcu_ptr& a, rcu_ptr& b) noexcept { a.swap(b); }
+
+private:
+    std::atomic<T*> p_{nullptr};
+};
+
+} // namespace pyl
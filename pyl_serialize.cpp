@@ -0,0 +1,276 @@
+#include "pyl_serialize.h"
+
+#include <algorithm>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+#include "pyl_hash.h"
+
+namespace pyl {
+
+// ===================== Field codec registry =====================
+
+namespace {
+
+struct field_codec_registry {
+    std::shared_mutex mutex;
+    std::unordered_map<std::type_index, field_codec> by_type;
+    std::unordered_map<std::uint64_t, field_codec> by_id;
+
+    void add(std::type_index type, std::string_view name, field_encoder enc, field_decoder dec) {
+        field_codec c{field_codec_id(name), type, enc, dec};
+        by_type.insert_or_assign(type, c);
+        by_id.insert_or_assign(c.id, c);
+    }
+
+    template <class T>
+    void add_builtin(std::string_view name) {
+        add(std::type_index(typeid(T)), name, &encode_field_as<T>, &decode_field_as<T>);
+    }
+
+    field_codec_registry() {
+        add_builtin<bool>("bool");
+        add_builtin<char>("char");
+        add_builtin<signed char>("signed char");
+        add_builtin<unsigned char>("unsigned char");
+        add_builtin<short>("short");
+        add_builtin<unsigned short>("unsigned short");
+        add_builtin<int>("int");
+        add_builtin<unsigned>("unsigned");
+        add_builtin<long>("long");
+        add_builtin<unsigned long>("unsigned long");
+        add_builtin<long long>("long long");
+        add_builtin<unsigned long long>("unsigned long long");
+        add_builtin<float>("float");
+        add_builtin<double>("double");
+        add_builtin<std::string>("std::string");
+    }
+};
+
+field_codec_registry& codec_registry() {
+    static field_codec_registry r;
+    return r;
+}
+
+} // namespace
+
+std::uint64_t field_codec_id(std::string_view name) noexcept {
+    return static_cast<std::uint64_t>(hash_string(name));
+}
+
+void register_field_codec(std::type_index type, std::string_view name,
+                          field_encoder encode, field_decoder decode) {
+    auto& r = codec_registry();
+    std::unique_lock<std::shared_mutex> lk(r.mutex);
+    r.add(type, name, encode, decode);
+}
+
+std::optional<field_codec> find_field_codec(std::type_index type) {
+    auto& r = codec_registry();
+    std::shared_lock<std::shared_mutex> lk(r.mutex);
+    auto it = r.by_type.find(type);
+    if (it == r.by_type.end()) return std::nullopt;
+    return it->second;
+}
+
+std::optional<field_codec> find_field_codec(std::uint64_t id) {
+    auto& r = codec_registry();
+    std::shared_lock<std::shared_mutex> lk(r.mutex);
+    auto it = r.by_id.find(id);
+    if (it == r.by_id.end()) return std::nullopt;
+    return it->second;
+}
+
+// ===================== image_builder =====================
+
+namespace serialize_detail {
+
+namespace {
+
+constexpr char magic[4] = {'P', 'Y', 'L', 'T'};
+
+std::uint32_t checked_u32(std::size_t n, const char* what) {
+    if (n > UINT32_MAX) throw serialize_error(std::string("save_tree: too many ") + what);
+    return static_cast<std::uint32_t>(n);
+}
+
+} // namespace
+
+std::uint32_t image_builder::begin_node(std::uint32_t parent, std::uint32_t slot) {
+    auto index = checked_u32(nodes_.size(), "nodes");
+    nodes_.push_back({parent, slot, checked_u32(fields_.size(), "fields"), 0, blob_.size(), 0});
+    return index;
+}
+
+void image_builder::end_payload() noexcept {
+    node_rec& n = nodes_.back();
+    n.payload_len = blob_.size() - n.payload_off;
+}
+
+void image_builder::add_field(std::string_view key, const std::any& value) {
+    auto codec = find_field_codec(std::type_index(value.type()));
+    if (!codec) {
+        throw serialize_error("save_tree: no codec registered for field " + std::string(key) +
+                              " (" + value.type().name() + ")");
+    }
+    field_rec f{};
+    f.codec = codec->id;
+    f.key_off = blob_.size();
+    f.key_len = checked_u32(key.size(), "key bytes");
+    blob_.insert(blob_.end(), reinterpret_cast<const std::byte*>(key.data()),
+                 reinterpret_cast<const std::byte*>(key.data()) + key.size());
+
+    f.value_off = blob_.size();
+    byte_writer w(blob_);
+    codec->encode(w, value);
+    f.value_len = checked_u32(blob_.size() - f.value_off, "value bytes");
+
+    fields_.push_back(f);
+    ++nodes_.back().fields_count;
+}
+
+void image_builder::finish(std::vector<std::byte>& out) {
+    const std::size_t n = nodes_.size();
+    const std::uint32_t none = tree_node_view::none;
+
+    // children in slot (= index) order: link back to front
+    std::vector<std::uint32_t> first_child(n, none), next_sibling(n, none);
+    for (std::size_t i = n; i-- > 1;) {
+        std::uint32_t p = nodes_[i].parent;
+        next_sibling[i] = first_child[p];
+        first_child[p] = static_cast<std::uint32_t>(i);
+    }
+
+    // fields sorted by key within each node (binary search in tree_image)
+    auto key_of = [&](const field_rec& f) {
+        return std::string_view(reinterpret_cast<const char*>(blob_.data() + f.key_off), f.key_len);
+    };
+    for (const node_rec& nr : nodes_) {
+        auto first = fields_.begin() + nr.fields_begin;
+        std::sort(first, first + nr.fields_count,
+                  [&](const field_rec& a, const field_rec& b) { return key_of(a) < key_of(b); });
+    }
+
+    const std::size_t nodes_off  = tree_image::header_size;
+    const std::size_t fields_off = nodes_off + n * tree_image::node_record;
+    const std::size_t blob_off   = fields_off + fields_.size() * tree_image::field_record;
+
+    out.assign(blob_off + blob_.size(), std::byte{0});
+    std::byte* p = out.data();
+
+    std::memcpy(p, magic, sizeof(magic));
+    store(p + 4, tree_image::version);
+    store(p + 8, static_cast<std::uint32_t>(n));
+    store(p + 12, static_cast<std::uint32_t>(fields_.size()));
+    store(p + 16, static_cast<std::uint64_t>(nodes_off));
+    store(p + 24, static_cast<std::uint64_t>(fields_off));
+    store(p + 32, static_cast<std::uint64_t>(blob_off));
+    store(p + 40, static_cast<std::uint64_t>(blob_.size()));
+
+    for (std::size_t i = 0; i < n; ++i) {
+        std::byte* r = p + nodes_off + i * tree_image::node_record;
+        const node_rec& nr = nodes_[i];
+        store(r + 0, nr.parent);
+        store(r + 4, first_child[i]);
+        store(r + 8, next_sibling[i]);
+        store(r + 12, nr.slot);
+        store(r + 16, nr.fields_begin);
+        store(r + 20, nr.fields_count);
+        store(r + 24, nr.payload_off);
+        store(r + 32, nr.payload_len);
+    }
+
+    for (std::size_t i = 0; i < fields_.size(); ++i) {
+        std::byte* r = p + fields_off + i * tree_image::field_record;
+        const field_rec& f = fields_[i];
+        store(r + 0, f.codec);
+        store(r + 8, f.key_off);
+        store(r + 16, f.key_len);
+        store(r + 20, f.value_len);
+        store(r + 24, f.value_off);
+    }
+
+    if (!blob_.empty()) std::memcpy(p + blob_off, blob_.data(), blob_.size());
+}
+
+} // namespace serialize_detail
+
+// ===================== tree_image =====================
+
+tree_image::tree_image(std::span<const std::byte> bytes) : bytes_(bytes) {
+    using serialize_detail::load;
+    auto fail = [](const char* why) { throw serialize_error(std::string("tree_image: ") + why); };
+
+    if (bytes.size() < header_size) fail("truncated header");
+    const std::byte* p = bytes.data();
+    if (std::memcmp(p, serialize_detail::magic, 4) != 0) fail("bad magic");
+    if (load<std::uint32_t>(p + 4) != version) fail("unsupported version");
+
+    node_count_  = load<std::uint32_t>(p + 8);
+    field_count_ = load<std::uint32_t>(p + 12);
+    auto nodes_off  = load<std::uint64_t>(p + 16);
+    auto fields_off = load<std::uint64_t>(p + 24);
+    auto blob_off   = load<std::uint64_t>(p + 32);
+    auto blob_size  = load<std::uint64_t>(p + 40);
+
+    // tables must be in order and inside the buffer
+    const std::uint64_t size = bytes.size();
+    if (nodes_off < header_size || nodes_off > size ||
+        std::uint64_t{node_count_} * node_record > size - nodes_off ||
+        fields_off != nodes_off + std::uint64_t{node_count_} * node_record ||
+        std::uint64_t{field_count_} * field_record > size - fields_off ||
+        blob_off != fields_off + std::uint64_t{field_count_} * field_record ||
+        blob_size > size - blob_off) {
+        fail("table out of bounds");
+    }
+    nodes_  = p + nodes_off;
+    fields_ = p + fields_off;
+    blob_   = p + blob_off;
+
+    auto in_blob = [&](std::uint64_t off, std::uint64_t len) {
+        return off <= blob_size && len <= blob_size - off;
+    };
+    for (std::uint32_t i = 0; i < node_count_; ++i) {
+        auto parent  = node_at<std::uint32_t>(i, n_parent);
+        auto first   = node_at<std::uint32_t>(i, n_first_child);
+        auto next    = node_at<std::uint32_t>(i, n_next_sibling);
+        auto fbegin  = node_at<std::uint32_t>(i, n_fields_begin);
+        auto fcount  = node_at<std::uint32_t>(i, n_fields_count);
+        if ((i == 0) != (parent == tree_node_view::none)) fail("bad root");
+        if (i != 0 && parent >= i) fail("parent after child");
+        if (first != tree_node_view::none && (first <= i || first >= node_count_)) fail("bad child index");
+        if (next != tree_node_view::none && (next <= i || next >= node_count_)) fail("bad sibling index");
+        if (fbegin > field_count_ || fcount > field_count_ - fbegin) fail("field range out of bounds");
+        if (!in_blob(node_at<std::uint64_t>(i, n_payload_off), node_at<std::uint64_t>(i, n_payload_len))) {
+            fail("payload out of bounds");
+        }
+    }
+    // Each node's child list holds exactly the nodes naming it as parent,
+    // in increasing slot order, so no (parent, slot) pair repeats. Every
+    // node has one parent, so the walks visit each node at most once.
+    std::uint32_t linked = 0;
+    for (std::uint32_t i = 0; i < node_count_; ++i) {
+        std::uint32_t prev_slot = 0;
+        bool first_child = true;
+        for (auto c = node_at<std::uint32_t>(i, n_first_child); c != tree_node_view::none;
+             c = node_at<std::uint32_t>(c, n_next_sibling)) {
+            if (node_at<std::uint32_t>(c, n_parent) != i) fail("child link disagrees with parent");
+            auto slot = node_at<std::uint32_t>(c, n_slot);
+            if (!first_child && slot <= prev_slot) fail("duplicate or unordered child slot");
+            prev_slot = slot;
+            first_child = false;
+            ++linked;
+        }
+    }
+    if (node_count_ != 0 && linked != node_count_ - 1) fail("node missing from its parent's child list");
+
+    for (std::uint32_t f = 0; f < field_count_; ++f) {
+        if (!in_blob(field_at<std::uint64_t>(f, f_key_off), field_at<std::uint32_t>(f, f_key_len)) ||
+            !in_blob(field_at<std::uint64_t>(f, f_value_off), field_at<std::uint32_t>(f, f_value_len))) {
+            fail("field out of bounds");
+        }
+    }
+}
+
+} // namespace pyl
@@ -0,0 +1,657 @@
+#pragma once
+
+#include <any>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory_resource>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <typeindex>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+#include "pyl_child_ptr.h"
+
+namespace pyl {
+
+// ---------------------------------------------------------
+// Binary trees of child_unique_ptr
+//
+// Usage:
+//   struct Node : pyl::Backtraceable<Node> {
+//       using child_ptr = pyl::child_unique_ptr<Node>;
+//       int value = 0;
+//       child_ptr left{this}, right{this};
+//
+//       explicit Node(pyl::byte_reader& r) : value(r.read<int>()) {}   // load
+//       void save(pyl::byte_writer& w) const { w.write(value); }       // store
+//       template <class F> void visit_children(F&& f) { f(left); f(right); }
+//       template <class F> void visit_children(F&& f) const { f(left); f(right); }
+//   };
+//
+//   std::vector<std::byte> bytes = pyl::save_tree(root);
+//   auto copy = pyl::load_tree<Node::child_ptr>(bytes);         // one pass
+//   auto fast = pyl::load_tree<ArenaPtr>(bytes, arena);         // into an arena
+//
+//   pyl::mapped_file f("tree.bin");
+//   pyl::tree_image img(f.bytes());                            // no parsing
+//   int v = img.root().payload().read<int>();
+//   auto name = img.root().field<std::string_view>("name");    // in place
+//
+// Node protocol: save(byte_writer&) writes the payload, a
+// T(byte_reader&) constructor reads it back, and visit_children(f)
+// calls f on every child slot (null or not) in a fixed order, both
+// const and non-const. Every child slot has the root's pointer type.
+//
+// Dynamic fields are stored through codecs registered per value type
+// (arithmetic types and std::string are built in). Dynamic functions
+// are not serialized.
+//
+// Layout (little-endian, offsets from the start of the image):
+//   header | node table | field table | blob
+// Nodes are in pre-order with parent / first-child / next-sibling
+// indices; payloads, keys and field values live in the blob. Parent
+// indices are always smaller than child indices, so loading is a
+// single forward pass.
+// ---------------------------------------------------------
+
+class serialize_error : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+namespace serialize_detail {
+
+template <class T>
+concept wire_scalar = std::is_arithmetic_v<T> || std::is_enum_v<T>;
+
+template <wire_scalar T>
+inline void store(std::byte* p, T v) noexcept {
+    std::memcpy(p, &v, sizeof(T));
+    if constexpr (std::endian::native == std::endian::big && sizeof(T) > 1) {
+        for (std::size_t i = 0; i < sizeof(T) / 2; ++i) std::swap(p[i], p[sizeof(T) - 1 - i]);
+    }
+}
+
+template <wire_scalar T>
+inline T load(const std::byte* p) noexcept {
+    std::byte tmp[sizeof(T)];
+    std::memcpy(tmp, p, sizeof(T));
+    if constexpr (std::endian::native == std::endian::big && sizeof(T) > 1) {
+        for (std::size_t i = 0; i < sizeof(T) / 2; ++i) std::swap(tmp[i], tmp[sizeof(T) - 1 - i]);
+    }
+    T v;
+    std::memcpy(&v, tmp, sizeof(T));
+    return v;
+}
+
+} // namespace serialize_detail
+
+// ---------------------------------------------------------
+// byte_writer / byte_reader – payload encoding
+// ---------------------------------------------------------
+
+class byte_writer {
+public:
+    explicit byte_writer(std::vector<std::byte>& out) noexcept : out_(&out) {}
+
+    template <serialize_detail::wire_scalar T>
+    void write(T v) {
+        std::size_t at = out_->size();
+        out_->resize(at + sizeof(T));
+        serialize_detail::store(out_->data() + at, v);
+    }
+
+    void write_bytes(const void* p, std::size_t n) {
+        const auto* b = static_cast<const std::byte*>(p);
+        out_->insert(out_->end(), b, b + n);
+    }
+
+    // u32 length + bytes
+    void write_string(std::string_view s) {
+        if (s.size() > UINT32_MAX) throw serialize_error("byte_writer: string too long");
+        write(static_cast<std::uint32_t>(s.size()));
+        write_bytes(s.data(), s.size());
+    }
+
+    std::size_t size() const noexcept { return out_->size(); }
+
+private:
+    std::vector<std::byte>* out_;
+};
+
+class byte_reader {
+public:
+    byte_reader() noexcept = default;
+    explicit byte_reader(std::span<const std::byte> bytes) noexcept : data_(bytes) {}
+
+    template <serialize_detail::wire_scalar T>
+    T read() {
+        need(sizeof(T));
+        T v = serialize_detail::load<T>(data_.data() + pos_);
+        pos_ += sizeof(T);
+        return v;
+    }
+
+    std::span<const std::byte> read_bytes(std::size_t n) {
+        need(n);
+        auto s = data_.subspan(pos_, n);
+        pos_ += n;
+        return s;
+    }
+
+    // Written by write_string(); the view points into the input
+    std::string_view read_string_view() {
+        auto n = read<std::uint32_t>();
+        auto s = read_bytes(n);
+        return {reinterpret_cast<const char*>(s.data()), s.size()};
+    }
+    std::string read_string() { return std::string(read_string_view()); }
+
+    std::size_t remaining() const noexcept { return data_.size() - pos_; }
+    bool empty() const noexcept { return remaining() == 0; }
+
+private:
+    void need(std::size_t n) const {
+        if (n > remaining()) throw serialize_error("byte_reader: truncated input");
+    }
+
+    std::span<const std::byte> data_;
+    std::size_t pos_ = 0;
+};
+
+// ---------------------------------------------------------
+// Dynamic-field codecs, keyed by std::type_index
+//
+//   pyl::register_field_codec<Color>("Color");   // scalar / enum: raw bytes
+//   pyl::register_field_codec<Point>("Point");   // save() + Point(byte_reader&)
+//
+// The name identifies the codec in the image (as a hash), so it must be
+// the same in the writing and the reading process.
+// ---------------------------------------------------------
+
+using field_encoder = void (*)(byte_writer& w, const std::any& value);
+using field_decoder = std::any (*)(byte_reader& r);   // reader spans one value
+
+struct field_codec {
+    std::uint64_t id = 0;
+    std::type_index type = typeid(void);
+    field_encoder encode = nullptr;
+    field_decoder decode = nullptr;
+};
+
+// Implemented in pyl_serialize.cpp
+void register_field_codec(std::type_index type, std::string_view name,
+                          field_encoder encode, field_decoder decode);
+std::optional<field_codec> find_field_codec(std::type_index type);
+std::optional<field_codec> find_field_codec(std::uint64_t id);
+std::uint64_t field_codec_id(std::string_view name) noexcept;
+
+template <class T>
+concept field_value_codable =
+    serialize_detail::wire_scalar<T> || std::is_same_v<T, std::string> ||
+    (std::constructible_from<T, byte_reader&> &&
+     requires(const T& v, byte_writer& w) { v.save(w); });
+
+template <field_value_codable T>
+void encode_field_as(byte_writer& w, const std::any& value) {
+    const T& v = std::any_cast<const T&>(value);
+    if constexpr (serialize_detail::wire_scalar<T>) {
+        w.write(v);
+    } else if constexpr (std::is_same_v<T, std::string>) {
+        w.write_bytes(v.data(), v.size());   // the value's size is recorded
+    } else {
+        v.save(w);
+    }
+}
+
+template <field_value_codable T>
+std::any decode_field_as(byte_reader& r) {
+    if constexpr (serialize_detail::wire_scalar<T>) {
+        return std::any(r.read<T>());
+    } else if constexpr (std::is_same_v<T, std::string>) {
+        auto b = r.read_bytes(r.remaining());
+        return std::any(std::string(reinterpret_cast<const char*>(b.data()), b.size()));
+    } else {
+        return std::any(T(r));
+    }
+}
+
+template <field_value_codable T>
+void register_field_codec(std::string_view name) {
+    register_field_codec(std::type_index(typeid(T)), name, &encode_field_as<T>, &decode_field_as<T>);
+}
+
+// ---------------------------------------------------------
+// Node protocol
+// ---------------------------------------------------------
+
+namespace serialize_detail {
+
+struct any_child {
+    template <class C>
+    void operator()(C&) const noexcept {}
+};
+
+} // namespace serialize_detail
+
+template <class T>
+concept serializable_node =
+    std::constructible_from<T, byte_reader&> &&
+    requires(T& t, const T& ct, byte_writer& w) {
+        ct.save(w);
+        t.visit_children(serialize_detail::any_child{});
+        ct.visit_children(serialize_detail::any_child{});
+    };
+
+// ---------------------------------------------------------
+// tree_image – validated, read-only view of a serialized tree
+//
+// Construction checks every offset once; afterwards navigation and
+// field lookup do no bounds checks and no allocation. The bytes are
+// not copied and must outlive the image (e.g. a mapped_file).
+// ---------------------------------------------------------
+
+class tree_image;
+
+class tree_node_view {
+public:
+    static constexpr std::uint32_t none = UINT32_MAX;
+
+    class child_iterator {
+    public:
+        using value_type      = tree_node_view;
+        using difference_type = std::ptrdiff_t;
+
+        child_iterator() = default;
+        child_iterator(const tree_image* img, std::uint32_t i) noexcept : img_(img), i_(i) {}
+
+        tree_node_view operator*() const noexcept { return tree_node_view(img_, i_); }
+        child_iterator& operator++() noexcept;
+        child_iterator operator++(int) noexcept {
+            auto t = *this;
+            ++*this;
+            return t;
+        }
+
+        friend bool operator==(const child_iterator& a, const child_iterator& b) noexcept { return a.i_ == b.i_; }
+
+    private:
+        const tree_image* img_ = nullptr;
+        std::uint32_t i_ = none;
+    };
+
+    struct child_range {
+        child_iterator first, last;
+        child_iterator begin() const noexcept { return first; }
+        child_iterator end() const noexcept { return last; }
+    };
+
+    tree_node_view() = default;
+    tree_node_view(const tree_image* img, std::uint32_t index) noexcept : img_(img), index_(index) {}
+
+    std::size_t index() const noexcept { return index_; }
+    bool has_parent() const noexcept { return parent_index() != none; }
+    tree_node_view parent() const noexcept { return tree_node_view(img_, parent_index()); }
+    std::size_t slot() const noexcept;                     // position among the parent's child slots
+    child_range children() const noexcept;                 // non-null children, in slot order
+
+    std::span<const std::byte> payload_bytes() const noexcept;
+    byte_reader payload() const noexcept { return byte_reader(payload_bytes()); }
+
+    // Dynamic fields (sorted by key, binary search)
+    std::size_t field_count() const noexcept;
+    bool has_field(std::string_view key) const noexcept { return find_field(key) != none; }
+    std::optional<std::span<const std::byte>> field_bytes(std::string_view key) const noexcept;
+
+    // Decoded value; std::string_view reads a std::string field in place.
+    // Throws serialize_error if the stored codec is not T's.
+    template <class T>
+    std::optional<T> field(std::string_view key) const;
+
+    // f(std::string_view key, std::uint64_t codec_id, std::span<const std::byte> value)
+    template <class F>
+    void for_each_field(F&& f) const;
+
+private:
+    friend class tree_image;
+
+    std::uint32_t parent_index() const noexcept;
+    std::uint32_t find_field(std::string_view key) const noexcept;
+    std::uint64_t field_codec_at(std::uint32_t f) const noexcept;
+    std::span<const std::byte> field_value_at(std::uint32_t f) const noexcept;
+
+    const tree_image* img_ = nullptr;
+    std::uint32_t index_ = 0;
+};
+
+class tree_image {
+public:
+    // Throws serialize_error on a malformed or truncated image
+    explicit tree_image(std::span<const std::byte> bytes);
+    explicit tree_image(std::string_view bytes)
+        : tree_image(std::as_bytes(std::span<const char>(bytes.data(), bytes.size()))) {}
+
+    std::size_t size() const noexcept { return node_count_; }
+    bool empty() const noexcept { return node_count_ == 0; }
+
+    tree_node_view root() const noexcept { return tree_node_view(this, 0); }
+    tree_node_view node(std::size_t i) const noexcept { return tree_node_view(this, static_cast<std::uint32_t>(i)); }
+
+    std::span<const std::byte> bytes() const noexcept { return bytes_; }
+
+private:
+    friend class tree_node_view;
+
+    // node record fields (u32 unless noted)
+    enum node_field : std::size_t {
+        n_parent = 0, n_first_child = 4, n_next_sibling = 8, n_slot = 12,
+        n_fields_begin = 16, n_fields_count = 20,
+        n_payload_off = 24,   // u64, into the blob
+        n_payload_len = 32,   // u64
+    };
+    // field record fields
+    enum field_field : std::size_t {
+        f_codec = 0,          // u64
+        f_key_off = 8,        // u64, into the blob
+        f_key_len = 16,
+        f_value_len = 20,
+        f_value_off = 24,     // u64, into the blob
+    };
+
+    template <serialize_detail::wire_scalar T>
+    T node_at(std::uint32_t i, std::size_t field) const noexcept {
+        return serialize_detail::load<T>(nodes_ + std::size_t{i} * node_record + field);
+    }
+    template <serialize_detail::wire_scalar T>
+    T field_at(std::uint32_t f, std::size_t field) const noexcept {
+        return serialize_detail::load<T>(fields_ + std::size_t{f} * field_record + field);
+    }
+    std::span<const std::byte> blob(std::uint64_t off, std::uint64_t len) const noexcept {
+        return std::span<const std::byte>(blob_ + off, static_cast<std::size_t>(len));
+    }
+
+public:
+    static constexpr std::size_t header_size  = 48;
+    static constexpr std::size_t node_record  = 40;
+    static constexpr std::size_t field_record = 32;
+    static constexpr std::uint32_t version    = 1;
+
+private:
+    std::span<const std::byte> bytes_;
+    const std::byte* nodes_  = nullptr;
+    const std::byte* fields_ = nullptr;
+    const std::byte* blob_   = nullptr;
+    std::uint32_t node_count_  = 0;
+    std::uint32_t field_count_ = 0;
+};
+
+inline tree_node_view::child_iterator& tree_node_view::child_iterator::operator++() noexcept {
+    i_ = img_->node_at<std::uint32_t>(i_, tree_image::n_next_sibling);
+    return *this;
+}
+
+inline std::uint32_t tree_node_view::parent_index() const noexcept {
+    return img_->node_at<std::uint32_t>(index_, tree_image::n_parent);
+}
+
+inline std::size_t tree_node_view::slot() const noexcept {
+    return img_->node_at<std::uint32_t>(index_, tree_image::n_slot);
+}
+
+inline tree_node_view::child_range tree_node_view::children() const noexcept {
+    auto first = img_->node_at<std::uint32_t>(index_, tree_image::n_first_child);
+    return {child_iterator(img_, first), child_iterator(img_, none)};
+}
+
+inline std::span<const std::byte> tree_node_view::payload_bytes() const noexcept {
+    return img_->blob(img_->node_at<std::uint64_t>(index_, tree_image::n_payload_off),
+                      img_->node_at<std::uint64_t>(index_, tree_image::n_payload_len));
+}
+
+inline std::size_t tree_node_view::field_count() const noexcept {
+    return img_->node_at<std::uint32_t>(index_, tree_image::n_fields_count);
+}
+
+inline std::uint32_t tree_node_view::find_field(std::string_view key) const noexcept {
+    auto lo = img_->node_at<std::uint32_t>(index_, tree_image::n_fields_begin);
+    auto hi = lo + img_->node_at<std::uint32_t>(index_, tree_image::n_fields_count);
+    auto key_at = [&](std::uint32_t f) {
+        auto b = img_->blob(img_->field_at<std::uint64_t>(f, tree_image::f_key_off),
+                            img_->field_at<std::uint32_t>(f, tree_image::f_key_len));
+        return std::string_view(reinterpret_cast<const char*>(b.data()), b.size());
+    };
+    while (lo < hi) {
+        auto mid = lo + (hi - lo) / 2;
+        if (key_at(mid) < key) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    auto end = img_->node_at<std::uint32_t>(index_, tree_image::n_fields_begin) + field_count();
+    return lo < end && key_at(lo) == key ? lo : none;
+}
+
+inline std::uint64_t tree_node_view::field_codec_at(std::uint32_t f) const noexcept {
+    return img_->field_at<std::uint64_t>(f, tree_image::f_codec);
+}
+
+inline std::span<const std::byte> tree_node_view::field_value_at(std::uint32_t f) const noexcept {
+    return img_->blob(img_->field_at<std::uint64_t>(f, tree_image::f_value_off),
+                      img_->field_at<std::uint32_t>(f, tree_image::f_value_len));
+}
+
+inline std::optional<std::span<const std::byte>> tree_node_view::field_bytes(std::string_view key) const noexcept {
+    auto f = find_field(key);
+    if (f == none) return std::nullopt;
+    return field_value_at(f);
+}
+
+template <class F>
+void tree_node_view::for_each_field(F&& f) const {
+    auto first = img_->node_at<std::uint32_t>(index_, tree_image::n_fields_begin);
+    for (std::uint32_t i = first, e = first + static_cast<std::uint32_t>(field_count()); i < e; ++i) {
+        auto k = img_->blob(img_->field_at<std::uint64_t>(i, tree_image::f_key_off),
+                            img_->field_at<std::uint32_t>(i, tree_image::f_key_len));
+        f(std::string_view(reinterpret_cast<const char*>(k.data()), k.size()),
+          field_codec_at(i), field_value_at(i));
+    }
+}
+
+template <class T>
+std::optional<T> tree_node_view::field(std::string_view key) const {
+    auto f = find_field(key);
+    if (f == none) return std::nullopt;
+
+    using Stored = std::conditional_t<std::is_same_v<T, std::string_view>, std::string, T>;
+    auto codec = find_field_codec(std::type_index(typeid(Stored)));
+    if (!codec || codec->id != field_codec_at(f)) {
+        throw serialize_error("tree_image: field type mismatch for " + std::string(key));
+    }
+
+    auto value = field_value_at(f);
+    if constexpr (std::is_same_v<T, std::string_view>) {
+        return std::string_view(reinterpret_cast<const char*>(value.data()), value.size());
+    } else if constexpr (serialize_detail::wire_scalar<T>) {
+        return byte_reader(value).read<T>();
+    } else {
+        byte_reader r(value);
+        return std::any_cast<T>(codec->decode(r));
+    }
+}
+
+// ---------------------------------------------------------
+// save_tree / load_tree
+// ---------------------------------------------------------
+
+namespace serialize_detail {
+
+// Accumulates nodes, payloads and fields, then lays out the image.
+// Implemented in pyl_serialize.cpp.
+class image_builder {
+public:
+    // Start node (pre-order); its payload goes to payload()
+    std::uint32_t begin_node(std::uint32_t parent, std::uint32_t slot);
+    byte_writer payload() noexcept { return byte_writer(blob_); }
+    void end_payload() noexcept;
+
+    // Field of the current node; throws if no codec is registered
+    void add_field(std::string_view key, const std::any& value);
+
+    void finish(std::vector<std::byte>& out);
+
+private:
+    struct node_rec {
+        std::uint32_t parent, slot, fields_begin, fields_count;
+        std::uint64_t payload_off, payload_len;
+    };
+    struct field_rec {
+        std::uint64_t codec, key_off;
+        std::uint32_t key_len, value_len;
+        std::uint64_t value_off;
+    };
+
+    std::vector<node_rec> nodes_;
+    std::vector<field_rec> fields_;
+    std::vector<std::byte> blob_;
+};
+
+template <class Ptr, class C>
+constexpr void check_child_type() {
+    static_assert(std::is_same_v<std::remove_const_t<C>, Ptr>,
+                  "save_tree/load_tree: every child slot must have the root's pointer type");
+}
+
+template <class Ptr>
+void save_fields(image_builder& b, const Ptr& p) {
+    if (const auto* fs = p.fields()) {
+        fs->for_each([&](std::string_view key, const std::any& value) { b.add_field(key, value); });
+    }
+}
+
+} // namespace serialize_detail
+
+// Serialize the tree under `root` (empty image for a null root)
+template <class Ptr>
+    requires serializable_node<typename Ptr::element_type>
+void save_tree(const Ptr& root, std::vector<std::byte>& out) {
+    serialize_detail::image_builder b;
+
+    struct pending {
+        const Ptr* ptr;
+        std::uint32_t parent, slot;
+    };
+    std::vector<pending> stack;
+    if (root) stack.push_back({&root, tree_node_view::none, 0});
+
+    std::vector<pending> kids;
+    while (!stack.empty()) {
+        pending cur = stack.back();
+        stack.pop_back();
+
+        std::uint32_t index = b.begin_node(cur.parent, cur.slot);
+        byte_writer w = b.payload();
+        cur.ptr->get()->save(w);
+        b.end_payload();
+        serialize_detail::save_fields(b, *cur.ptr);
+
+        kids.clear();
+        std::uint32_t slot = 0;
+        std::as_const(*cur.ptr->get()).visit_children([&]<class C>(C& child) {
+            serialize_detail::check_child_type<Ptr, C>();
+            if (child) kids.push_back({&child, index, slot});
+            ++slot;
+        });
+        // reversed, so the first slot is visited next (pre-order)
+        stack.insert(stack.end(), kids.rbegin(), kids.rend());
+    }
+    b.finish(out);
+}
+
+template <class Ptr>
+    requires serializable_node<typename Ptr::element_type>
+std::vector<std::byte> save_tree(const Ptr& root) {
+    std::vector<std::byte> out;
+    save_tree(root, out);
+    return out;
+}
+
+namespace serialize_detail {
+
+template <class Ptr>
+void load_fields(Ptr& p, const tree_node_view& v) {
+    v.for_each_field([&](std::string_view key, std::uint64_t codec_id, std::span<const std::byte> value) {
+        auto codec = find_field_codec(codec_id);
+        if (!codec) throw serialize_error("load_tree: no codec registered for field " + std::string(key));
+        byte_reader r(value);
+        p[key] = codec->decode(r);
+    });
+}
+
+} // namespace serialize_detail
+
+// Rebuild a tree in one forward pass over the node table. `root` is the
+// (empty) pointer to fill; children are emplaced into their slots, so
+// pmr_deleter pointers allocate from the root's resource.
+template <class Ptr>
+    requires serializable_node<typename Ptr::element_type>
+void load_tree(const tree_image& img, Ptr& root) {
+    root.reset();
+    if (img.empty()) return;
+
+    std::vector<Ptr*> loaded(img.size(), nullptr);
+    for (std::size_t i = 0; i < img.size(); ++i) {
+        tree_node_view v = img.node(i);
+        Ptr* target = &root;
+        if (i != 0) {
+            std::size_t slot = v.slot(), k = 0;
+            target = nullptr;
+            loaded[v.parent().index()]->get()->visit_children([&]<class C>(C& child) {
+                serialize_detail::check_child_type<Ptr, C>();
+                if (k++ == slot) target = &child;
+            });
+            if (!target) throw serialize_error("load_tree: child slot out of range");
+            if (*target) throw serialize_error("load_tree: child slot filled twice");
+        }
+        byte_reader r = v.payload();
+        target->emplace(r);
+        serialize_detail::load_fields(*target, v);
+        loaded[i] = target;
+    }
+}
+
+template <class Ptr>
+    requires serializable_node<typename Ptr::element_type>
+Ptr load_tree(const tree_image& img) {
+    Ptr root;
+    load_tree(img, root);
+    return root;
+}
+
+template <class Ptr>
+    requires serializable_node<typename Ptr::element_type>
+Ptr load_tree(std::span<const std::byte> bytes) {
+    return load_tree<Ptr>(tree_image(bytes));
+}
+
+// Every node allocated from `resource` (Ptr's deleter must take a
+// memory_resource*, e.g. pmr_deleter over a child_arena)
+template <class Ptr>
+    requires serializable_node<typename Ptr::element_type> &&
+             std::constructible_from<typename Ptr::deleter_type, std::pmr::memory_resource*>
+Ptr load_tree(std::span<const std::byte> bytes, std::pmr::memory_resource& resource) {
+    Ptr root(nullptr, nullptr, typename Ptr::deleter_type(&resource));
+    load_tree(tree_image(bytes), root);
+    return root;
+}
+
+} // namespace pyl
@@ -0,0 +1,345 @@
+#include "pyl_sink.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace pyl {
+
+// ===================== Default / global sink =====================
+
+void StderrSink::write(std::string_view s) {
+    std::cerr.write(s.data(), static_cast<std::streamsize>(s.size()));
+}
+
+void StderrSink::flush() {
+    std::cerr.flush();
+}
+
+namespace {
+
+StderrSink& default_sink() {
+    static StderrSink sink;
+    return sink;
+}
+
+std::atomic<Sink*> g_sink{nullptr};
+
+} // namespace
+
+Sink& current_sink() noexcept {
+    Sink* s = g_sink.load(std::memory_order_acquire);
+    return s ? *s : default_sink();
+}
+
+Sink* set_sink(Sink* sink) noexcept {
+    return g_sink.exchange(sink, std::memory_order_acq_rel);
+}
+
+// ===================== AsyncSink =====================
+
+namespace {
+
+using sink_clock = std::chrono::steady_clock;
+
+std::size_t round_up_pow2(std::size_t n) {
+    std::size_t p = 2;
+    while (p < n)
+        p <<= 1;
+    return p;
+}
+
+// Bounded MPSC ring (Vyukov-style sequence numbers per cell).
+// Chunks are swapped in and out so string capacity is recycled.
+class chunk_ring {
+public:
+    explicit chunk_ring(std::size_t capacity)
+        : mask_(round_up_pow2(capacity) - 1),
+          cells_(new cell[mask_ + 1]) {
+        for (std::size_t i = 0; i <= mask_; ++i)
+            cells_[i].seq.store(i, std::memory_order_relaxed);
+    }
+
+    // producers: on success `chunk` receives a recycled (empty) buffer
+    bool try_push(std::string& chunk) noexcept {
+        std::size_t pos = head_.load(std::memory_order_relaxed);
+        for (;;) {
+            cell& c = cells_[pos & mask_];
+            std::size_t seq = c.seq.load(std::memory_order_acquire);
+            auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+            if (diff == 0) {
+                if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    c.data.swap(chunk);
+                    c.seq.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;  // full
+            } else {
+                pos = head_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // consumer only: `out` must be empty; its capacity goes back to the ring
+    bool try_pop(std::string& out) noexcept {
+        cell& c = cells_[tail_ & mask_];
+        if (c.seq.load(std::memory_order_acquire) != tail_ + 1)
+            return false;
+        c.data.swap(out);
+        c.seq.store(tail_ + mask_ + 1, std::memory_order_release);
+        ++tail_;
+        return true;
+    }
+
+    std::size_t claimed() const noexcept { return head_.load(std::memory_order_acquire); }
+    std::size_t consumed() const noexcept { return tail_; }
+
+private:
+    struct cell {
+        std::atomic<std::size_t> seq{0};
+        std::string data;
+    };
+
+    std::size_t mask_;
+    std::unique_ptr<cell[]> cells_;
+    alignas(64) std::atomic<std::size_t> head_{0};
+    alignas(64) std::size_t tail_ = 0;
+};
+
+// Per-thread buffer. The owner thread and the writer thread's idle
+// sweep are the only parties touching it, so the spin lock is
+// uncontended in the common case.
+struct thread_buffer {
+    std::atomic<bool> busy{false};
+    std::atomic<bool> orphaned{false};  // owning sink is gone
+    std::string data;
+    sink_clock::time_point since{};
+
+    void lock() noexcept {
+        while (busy.exchange(true, std::memory_order_acquire))
+            std::this_thread::yield();
+    }
+    bool try_lock() noexcept { return !busy.exchange(true, std::memory_order_acquire); }
+    void unlock() noexcept { busy.store(false, std::memory_order_release); }
+};
+
+std::atomic<std::uint64_t> g_next_sink_id{1};
+
+struct thread_buffer_cache {
+    std::vector<std::pair<std::uint64_t, std::shared_ptr<thread_buffer>>> entries;
+};
+
+thread_local thread_buffer_cache t_buffers;
+
+} // namespace
+
+struct AsyncSink::Impl {
+    Sink& target;
+    AsyncSinkOptions options;
+    std::uint64_t id = g_next_sink_id.fetch_add(1, std::memory_order_relaxed);
+
+    chunk_ring ring;
+    std::atomic<std::size_t> dropped{0};
+
+    std::mutex registry_mutex;
+    std::vector<std::shared_ptr<thread_buffer>> registry;
+
+    std::mutex wake_mutex;
+    std::condition_variable wake;
+    std::condition_variable drained;
+    std::uint64_t flush_requested = 0;  // guarded by wake_mutex
+    std::uint64_t flush_completed = 0;  // guarded by wake_mutex
+    bool stop = false;                  // guarded by wake_mutex
+
+    std::thread writer;
+
+    Impl(Sink& t, AsyncSinkOptions o)
+        : target(t), options(o), ring(o.ring_capacity) {
+        writer = std::thread([this] { run(); });
+    }
+
+    thread_buffer& local_buffer() {
+        auto& entries = t_buffers.entries;
+        for (auto& [sink_id, buf] : entries) {
+            if (sink_id == id)
+                return *buf;
+        }
+        // forget buffers of sinks that no longer exist
+        std::erase_if(entries, [](const auto& e) {
+            return e.second->orphaned.load(std::memory_order_relaxed);
+        });
+
+        auto buf = std::make_shared<thread_buffer>();
+        {
+            std::lock_guard<std::mutex> lk(registry_mutex);
+            registry.push_back(buf);
+        }
+        entries.emplace_back(id, buf);
+        return *buf;
+    }
+
+    // caller holds buf's lock
+    void hand_off(thread_buffer& buf) {
+        while (!ring.try_push(buf.data)) {
+            if (options.drop_on_overflow) {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                break;
+            }
+            wake.notify_one();
+            std::this_thread::yield();
+        }
+        buf.data.clear();
+        wake.notify_one();
+    }
+
+    void write(std::string_view s) {
+        thread_buffer& buf = local_buffer();
+        buf.lock();
+        auto now = sink_clock::now();
+        if (buf.data.empty()) {
+            buf.since = now;
+        }
+        buf.data.append(s);
+        if (buf.data.size() >= options.thread_buffer_bytes ||
+            now - buf.since >= options.flush_interval) {
+            hand_off(buf);
+        }
+        buf.unlock();
+    }
+
+    void flush() {
+        thread_buffer& buf = local_buffer();
+        buf.lock();
+        if (!buf.data.empty()) {
+            hand_off(buf);
+        }
+        buf.unlock();
+
+        std::unique_lock<std::mutex> lk(wake_mutex);
+        std::uint64_t ticket = ++flush_requested;
+        wake.notify_one();
+        drained.wait(lk, [&] { return flush_completed >= ticket || stop; });
+    }
+
+    // ---- writer thread ----
+
+    void drain_ring(std::string& batch, std::string& scratch, std::size_t until) {
+        while (ring.consumed() < until) {
+            if (ring.try_pop(scratch)) {
+                batch.append(scratch);
+                scratch.clear();
+            } else {
+                std::this_thread::yield();  // slot claimed but not yet published
+            }
+        }
+        while (ring.try_pop(scratch)) {
+            batch.append(scratch);
+            scratch.clear();
+        }
+    }
+
+    // A thread's ring chunks are older than its buffered text. Holding
+    // the buffer's lock, every chunk the thread handed off is already
+    // claimed, so draining up to claimed() first keeps its order.
+    void sweep_buffers(std::string& batch, std::string& scratch, bool all) {
+        auto now = sink_clock::now();
+        std::lock_guard<std::mutex> lk(registry_mutex);
+        for (auto& buf : registry) {
+            if (!buf->try_lock())
+                continue;
+            if (!buf->data.empty() &&
+                (all || now - buf->since >= options.flush_interval)) {
+                drain_ring(batch, scratch, ring.claimed());
+                batch.append(buf->data);
+                buf->data.clear();
+            }
+            buf->unlock();
+        }
+        // buffers whose thread exited and that hold nothing
+        std::erase_if(registry, [](const auto& b) {
+            return b.use_count() == 1 && b->data.empty();
+        });
+    }
+
+    void run() {
+        std::string batch;
+        std::string scratch;
+        for (;;) {
+            std::uint64_t requested;
+            bool stopping;
+            bool forced;
+            {
+                std::unique_lock<std::mutex> lk(wake_mutex);
+                wake.wait_for(lk, options.flush_interval, [&] {
+                    return stop || flush_requested != flush_completed ||
+                           ring.claimed() != ring.consumed();
+                });
+                requested = flush_requested;
+                stopping  = stop;
+                forced    = stop || flush_requested != flush_completed;
+            }
+
+            drain_ring(batch, scratch, ring.claimed());
+            sweep_buffers(batch, scratch, forced);
+
+            if (!batch.empty()) {
+                target.write(batch);
+                batch.clear();
+            }
+            if (forced) {
+                target.flush();
+            }
+            {
+                std::lock_guard<std::mutex> lk(wake_mutex);
+                flush_completed = requested;
+            }
+            drained.notify_all();
+
+            if (stopping)
+                break;
+        }
+    }
+
+    ~Impl() {
+        {
+            std::lock_guard<std::mutex> lk(wake_mutex);
+            stop = true;
+        }
+        wake.notify_one();
+        writer.join();
+
+        std::lock_guard<std::mutex> lk(registry_mutex);
+        for (auto& buf : registry) {
+            buf->orphaned.store(true, std::memory_order_relaxed);
+        }
+    }
+};
+
+AsyncSink::AsyncSink()
+    : AsyncSink(default_sink()) {}
+
+AsyncSink::AsyncSink(Sink& target, AsyncSinkOptions options)
+    : impl_(std::make_unique<Impl>(target, options)) {}
+
+AsyncSink::~AsyncSink() = default;
+
+void AsyncSink::write(std::string_view s) {
+    impl_->write(s);
+}
+
+void AsyncSink::flush() {
+    impl_->flush();
+}
+
+std::size_t AsyncSink::dropped() const noexcept {
+    return impl_->dropped.load(std::memory_order_relaxed);
+}
+
+} // namespace pyl
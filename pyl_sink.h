@@ -0,0 +1,85 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <string_view>
+
+namespace pyl {
+
+// ---------------------------------------------------------
+// Sink – destination for F() / __F() output
+//
+// Usage:
+//   pyl::AsyncSink async;               // background writer to stderr
+//   pyl::set_sink(&async);
+//   F("x={x}\n", x);                    // appends to a per-thread buffer
+//   pyl::set_sink(nullptr);             // back to synchronous stderr
+//
+// The sink passed to set_sink() is not owned and must outlive its use.
+// ---------------------------------------------------------
+
+class Sink {
+public:
+    virtual ~Sink() = default;
+
+    virtual void write(std::string_view s) = 0;
+    virtual void flush() {}
+};
+
+// StderrSink – synchronous, unbuffered std::cerr (the default sink)
+class StderrSink final : public Sink {
+public:
+    void write(std::string_view s) override;
+    void flush() override;
+};
+
+// Sink used by F(); never null (falls back to a StderrSink)
+Sink& current_sink() noexcept;
+
+// Install a sink (nullptr restores the default); returns the previous one
+Sink* set_sink(Sink* sink) noexcept;
+
+// ---------------------------------------------------------
+// AsyncSink – non-blocking sink drained by a background thread
+//
+// - write() appends to a per-thread buffer (no lock shared with
+//   other writers, no syscall)
+// - a full buffer, or one older than flush_interval, is handed to
+//   a lock-free MPSC ring buffer
+// - the writer thread drains the ring into `target` in batches and
+//   also collects buffers from idle threads every flush_interval
+// - flush() blocks until everything written so far reached `target`
+//
+// `target` is only called from the writer thread, so it does not
+// need to be thread-safe.
+// ---------------------------------------------------------
+
+struct AsyncSinkOptions {
+    std::size_t thread_buffer_bytes = 4096;          // hand-off threshold
+    std::size_t ring_capacity       = 1024;          // chunks, rounded up to 2^n
+    std::chrono::milliseconds flush_interval{50};    // max latency of buffered text
+    bool drop_on_overflow           = false;         // drop instead of spinning when full
+};
+
+class AsyncSink final : public Sink {
+public:
+    AsyncSink();
+    explicit AsyncSink(Sink& target, AsyncSinkOptions options = {});
+    ~AsyncSink() override;
+
+    AsyncSink(const AsyncSink&)            = delete;
+    AsyncSink& operator=(const AsyncSink&) = delete;
+
+    void write(std::string_view s) override;
+    void flush() override;
+
+    // Chunks discarded because the ring was full (drop_on_overflow only)
+    std::size_t dropped() const noexcept;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+} // namespace pyl
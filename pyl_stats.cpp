@@ -0,0 +1,289 @@
+#include "pyl_stats.h"
+
+#include <algorithm>
+#include <cmath>
+#include <ostream>
+
+#ifdef PYL_ENABLE_STATS
+#include <mutex>
+#include <vector>
+#endif
+
+namespace pyl {
+
+std::string_view stat_name(stat_counter c) noexcept {
+    switch (c) {
+    case stat_counter::any_box:            return "any_box";
+    case stat_counter::any_format:         return "any_format";
+    case stat_counter::any_format_unknown: return "any_format_unknown";
+    case stat_counter::runtime_format:     return "runtime_format";
+    case stat_counter::hash_to_string:     return "hash_to_string";
+    case stat_counter::to_text_typeid:     return "to_text_typeid";
+    case stat_counter::cycle_check:        return "cycle_check";
+    case stat_counter::count_:             break;
+    }
+    return "?";
+}
+
+std::string_view stat_name(stat_histogram h) noexcept {
+    switch (h) {
+    case stat_histogram::cycle_walk_depth:  return "cycle_walk_depth";
+    case stat_histogram::runtime_format_ns: return "runtime_format_ns";
+    case stat_histogram::count_:            break;
+    }
+    return "?";
+}
+
+std::uint64_t histogram_snapshot::percentile(double p) const noexcept {
+    if (count == 0) return 0;
+    p = std::clamp(p, 0.0, 1.0);
+    auto target = static_cast<std::uint64_t>(std::ceil(p * static_cast<double>(count)));
+    target = std::max<std::uint64_t>(target, 1);
+    std::uint64_t seen = 0;
+    for (std::size_t b = 0; b < stat_buckets; ++b) {
+        seen += buckets[b];
+        if (seen >= target) {
+            std::uint64_t upper = b == 0 ? 0 : b >= 64 ? UINT64_MAX : (std::uint64_t{1} << b) - 1;
+            return std::min(upper, max);
+        }
+    }
+    return max;
+}
+
+void stats_snapshot::write_json(std::ostream& out) const {
+    out << "{\"enabled\": " << (enabled ? "true" : "false") << ", \"counters\": {";
+    for (std::size_t i = 0; i < stat_counter_count; ++i) {
+        out << (i ? ", " : "") << '"' << stat_name(static_cast<stat_counter>(i)) << "\": " << counters[i];
+    }
+    out << "}, \"histograms\": {";
+    for (std::size_t i = 0; i < stat_histogram_count; ++i) {
+        const histogram_snapshot& h = histograms[i];
+        out << (i ? ", " : "") << '"' << stat_name(static_cast<stat_histogram>(i)) << "\": {"
+            << "\"count\": " << h.count << ", \"sum\": " << h.sum
+            << ", \"min\": " << h.min << ", \"max\": " << h.max
+            << ", \"mean\": " << h.mean()
+            << ", \"p50\": " << h.percentile(0.5) << ", \"p99\": " << h.percentile(0.99) << "}";
+    }
+    out << "}}";
+}
+
+void write_chrome_trace(std::ostream&& out) {
+    write_chrome_trace(out);
+}
+
+#ifdef PYL_ENABLE_STATS
+
+namespace stats_detail {
+
+std::atomic<bool> tracing_on{false};
+
+namespace {
+
+struct trace_event {
+    const char* name;
+    std::uint64_t begin_ns;
+    std::uint64_t end_ns;
+};
+
+constexpr std::size_t max_events_per_thread = std::size_t{1} << 20;
+
+struct thread_slot {
+    thread_stats stats;
+    std::uint32_t tid = 0;
+    std::mutex trace_mutex;
+    std::vector<trace_event> events;
+};
+
+struct stats_registry {
+    std::mutex mutex;
+    std::vector<thread_slot*> live;
+    thread_slot retired;                       // totals of exited threads
+    std::vector<std::pair<std::uint32_t, trace_event>> retired_events;
+    std::uint32_t next_tid = 1;
+};
+
+stats_registry& registry() {
+    static auto* r = new stats_registry;       // used by thread exits after main
+    return *r;
+}
+
+void fold(thread_stats& into, const thread_stats& from) {
+    for (std::size_t i = 0; i < stat_counter_count; ++i) {
+        into.counters[i].fetch_add(from.counters[i].load(std::memory_order_relaxed),
+                                   std::memory_order_relaxed);
+    }
+    for (std::size_t h = 0; h < stat_histogram_count; ++h) {
+        const histogram_cells& f = from.histograms[h];
+        histogram_cells& t = into.histograms[h];
+        t.count.fetch_add(f.count.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        t.sum.fetch_add(f.sum.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        t.min.store(std::min(t.min.load(std::memory_order_relaxed), f.min.load(std::memory_order_relaxed)),
+                    std::memory_order_relaxed);
+        t.max.store(std::max(t.max.load(std::memory_order_relaxed), f.max.load(std::memory_order_relaxed)),
+                    std::memory_order_relaxed);
+        for (std::size_t b = 0; b < stat_buckets; ++b) {
+            t.buckets[b].fetch_add(f.buckets[b].load(std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+    }
+}
+
+void clear(thread_stats& s) {
+    for (auto& c : s.counters) c.store(0, std::memory_order_relaxed);
+    for (auto& h : s.histograms) {
+        h.count.store(0, std::memory_order_relaxed);
+        h.sum.store(0, std::memory_order_relaxed);
+        h.min.store(UINT64_MAX, std::memory_order_relaxed);
+        h.max.store(0, std::memory_order_relaxed);
+        for (auto& b : h.buckets) b.store(0, std::memory_order_relaxed);
+    }
+}
+
+struct thread_owner {
+    thread_slot* slot = nullptr;
+    ~thread_owner() {
+        if (!slot) return;
+        auto& r = registry();
+        std::lock_guard<std::mutex> lk(r.mutex);
+        fold(r.retired.stats, slot->stats);
+        {
+            std::lock_guard<std::mutex> tl(slot->trace_mutex);
+            for (const trace_event& e : slot->events) r.retired_events.emplace_back(slot->tid, e);
+        }
+        r.live.erase(std::find(r.live.begin(), r.live.end(), slot));
+        tls_stats = nullptr;
+        delete slot;
+    }
+};
+
+thread_local thread_owner owner;
+
+const auto process_start = std::chrono::steady_clock::now();
+
+} // namespace
+
+thread_stats& register_thread() {
+    auto* slot = new thread_slot;
+    auto& r = registry();
+    {
+        std::lock_guard<std::mutex> lk(r.mutex);
+        slot->tid = r.next_tid++;
+        r.live.push_back(slot);
+    }
+    clear(slot->stats);
+    owner.slot = slot;
+    tls_stats = &slot->stats;
+    return slot->stats;
+}
+
+std::uint64_t now_ns() noexcept {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - process_start).count());
+}
+
+void emit_span(const char* name, std::uint64_t begin_ns, std::uint64_t end_ns) {
+    local();
+    thread_slot* slot = owner.slot;
+    std::lock_guard<std::mutex> lk(slot->trace_mutex);   // uncontended except while writing out
+    if (slot->events.size() < max_events_per_thread) {
+        slot->events.push_back({name, begin_ns, end_ns});
+    }
+}
+
+} // namespace stats_detail
+
+stats_snapshot stats() {
+    using namespace stats_detail;
+    thread_stats total;
+    clear(total);
+    {
+        auto& r = registry();
+        std::lock_guard<std::mutex> lk(r.mutex);
+        fold(total, r.retired.stats);
+        for (thread_slot* s : r.live) fold(total, s->stats);
+    }
+
+    stats_snapshot out;
+    for (std::size_t i = 0; i < stat_counter_count; ++i) {
+        out.counters[i] = total.counters[i].load(std::memory_order_relaxed);
+    }
+    for (std::size_t h = 0; h < stat_histogram_count; ++h) {
+        const histogram_cells& c = total.histograms[h];
+        histogram_snapshot& o = out.histograms[h];
+        o.count = c.count.load(std::memory_order_relaxed);
+        o.sum   = c.sum.load(std::memory_order_relaxed);
+        o.min   = o.count ? c.min.load(std::memory_order_relaxed) : 0;
+        o.max   = c.max.load(std::memory_order_relaxed);
+        for (std::size_t b = 0; b < stat_buckets; ++b) {
+            o.buckets[b] = c.buckets[b].load(std::memory_order_relaxed);
+        }
+    }
+    return out;
+}
+
+void reset_stats() {
+    using namespace stats_detail;
+    auto& r = registry();
+    std::lock_guard<std::mutex> lk(r.mutex);
+    clear(r.retired.stats);
+    for (thread_slot* s : r.live) clear(s->stats);
+}
+
+void set_tracing(bool on) noexcept {
+    stats_detail::tracing_on.store(on, std::memory_order_relaxed);
+}
+
+bool tracing() noexcept {
+    return stats_detail::tracing_on.load(std::memory_order_relaxed);
+}
+
+void write_chrome_trace(std::ostream& out) {
+    using namespace stats_detail;
+    std::vector<std::pair<std::uint32_t, trace_event>> events;
+    {
+        auto& r = registry();
+        std::lock_guard<std::mutex> lk(r.mutex);
+        events.swap(r.retired_events);
+        for (thread_slot* s : r.live) {
+            std::lock_guard<std::mutex> tl(s->trace_mutex);
+            for (const trace_event& e : s->events) events.emplace_back(s->tid, e);
+            s->events.clear();
+        }
+    }
+    std::sort(events.begin(), events.end(),
+              [](const auto& a, const auto& b) { return a.second.begin_ns < b.second.begin_ns; });
+
+    auto micros = [&](std::uint64_t ns) {
+        out << ns / 1000 << '.' << static_cast<char>('0' + ns / 100 % 10)
+            << static_cast<char>('0' + ns / 10 % 10) << static_cast<char>('0' + ns % 10);
+    };
+    out << "{\"traceEvents\": [";
+    for (std::size_t i = 0; i < events.size(); ++i) {
+        const auto& [tid, e] = events[i];
+        out << (i ? ",\n" : "\n") << "{\"name\": \"";
+        for (const char* p = e.name; *p; ++p) {
+            if (*p == '"' || *p == '\\') out << '\\';
+            out << *p;
+        }
+        out << "\", \"ph\": \"X\", \"pid\": 1, \"tid\": " << tid << ", \"ts\": ";
+        micros(e.begin_ns);
+        out << ", \"dur\": ";
+        micros(e.end_ns - e.begin_ns);
+        out << '}';
+    }
+    out << "\n], \"displayTimeUnit\": \"ns\"}\n";
+}
+
+#else
+
+stats_snapshot stats() { return {}; }
+void reset_stats() {}
+void set_tracing(bool) noexcept {}
+bool tracing() noexcept { return false; }
+
+void write_chrome_trace(std::ostream& out) {
+    out << "{\"traceEvents\": [], \"displayTimeUnit\": \"ns\"}\n";
+}
+
+#endif
+
+} // namespace pyl
@@ -0,0 +1,198 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string_view>
+
+#ifdef PYL_ENABLE_STATS
+#include <atomic>
+#include <chrono>
+#endif
+
+namespace pyl {
+
+// ---------------------------------------------------------
+// Hot-path instrumentation (opt-in: build with PYL_ENABLE_STATS)
+//
+// Counters and log2 histograms are kept per thread, so recording
+// never touches another core's cache line; pyl::stats() sums all
+// threads, including ones that have exited. Spans are also written
+// as Chrome trace events (chrome://tracing, ui.perfetto.dev) while
+// tracing is on.
+//
+// Usage:
+//   pyl::set_tracing(true);
+//   run_workload();
+//   auto s = pyl::stats();
+//   s.counter(pyl::stat_counter::hash_to_string);
+//   s.histogram(pyl::stat_histogram::cycle_walk_depth).percentile(0.99);
+//   pyl::write_chrome_trace(std::ofstream("trace.json"));
+//
+// Without PYL_ENABLE_STATS the PYL_STATS_* macros expand to nothing
+// and their arguments are not evaluated; stats() returns zeros with
+// enabled == false.
+// ---------------------------------------------------------
+
+enum class stat_counter : unsigned {
+    any_box,              // values boxed into std::any for __F / MAKE_FIELD
+    any_format,           // std::any values formatted at run time
+    any_format_unknown,   // ... with no registered formatter
+    runtime_format,       // __F calls (parse + FieldMap lookups)
+    hash_to_string,       // pyl::hash fell back to hashing to_string()
+    to_text_typeid,       // to_text fell back to type name + address
+    cycle_check,          // child_unique_ptr ancestor walks
+    count_
+};
+
+enum class stat_histogram : unsigned {
+    cycle_walk_depth,     // ancestors visited per cycle check
+    runtime_format_ns,    // __F latency
+    count_
+};
+
+inline constexpr std::size_t stat_counter_count   = static_cast<std::size_t>(stat_counter::count_);
+inline constexpr std::size_t stat_histogram_count = static_cast<std::size_t>(stat_histogram::count_);
+inline constexpr std::size_t stat_buckets         = 65;   // bucket b: values with bit width b
+
+#ifdef PYL_ENABLE_STATS
+inline constexpr bool stats_enabled = true;
+#else
+inline constexpr bool stats_enabled = false;
+#endif
+
+std::string_view stat_name(stat_counter c) noexcept;
+std::string_view stat_name(stat_histogram h) noexcept;
+
+struct histogram_snapshot {
+    std::uint64_t count = 0;
+    std::uint64_t sum   = 0;
+    std::uint64_t min   = 0;
+    std::uint64_t max   = 0;
+    std::array<std::uint64_t, stat_buckets> buckets{};
+
+    double mean() const noexcept {
+        return count ? static_cast<double>(sum) / static_cast<double>(count) : 0.0;
+    }
+
+    // Upper bound of the bucket holding the p-quantile (p in [0, 1])
+    std::uint64_t percentile(double p) const noexcept;
+};
+
+struct stats_snapshot {
+    bool enabled = stats_enabled;
+    std::array<std::uint64_t, stat_counter_count> counters{};
+    std::array<histogram_snapshot, stat_histogram_count> histograms{};
+
+    std::uint64_t counter(stat_counter c) const noexcept {
+        return counters[static_cast<std::size_t>(c)];
+    }
+    const histogram_snapshot& histogram(stat_histogram h) const noexcept {
+        return histograms[static_cast<std::size_t>(h)];
+    }
+
+    // {"counters": {...}, "histograms": {...}}
+    void write_json(std::ostream& out) const;
+};
+
+stats_snapshot stats();
+void reset_stats();
+
+// Spans are buffered per thread while tracing is on
+void set_tracing(bool on) noexcept;
+bool tracing() noexcept;
+
+// Writes and clears the buffered spans as {"traceEvents": [...]}
+void write_chrome_trace(std::ostream& out);
+void write_chrome_trace(std::ostream&& out);
+
+#ifdef PYL_ENABLE_STATS
+
+namespace stats_detail {
+
+struct histogram_cells {
+    std::atomic<std::uint64_t> count{0};
+    std::atomic<std::uint64_t> sum{0};
+    std::atomic<std::uint64_t> min{UINT64_MAX};
+    std::atomic<std::uint64_t> max{0};
+    std::array<std::atomic<std::uint64_t>, stat_buckets> buckets{};
+};
+
+struct alignas(64) thread_stats {
+    std::array<std::atomic<std::uint64_t>, stat_counter_count> counters{};
+    std::array<histogram_cells, stat_histogram_count> histograms{};
+};
+
+inline thread_local thread_stats* tls_stats = nullptr;
+thread_stats& register_thread();
+
+inline thread_stats& local() {
+    thread_stats* s = tls_stats;
+    return s ? *s : register_thread();
+}
+
+// Only the owning thread writes its cells; relaxed RMWs stay on the
+// thread's own cache line
+inline void add(stat_counter c, std::uint64_t n) {
+    local().counters[static_cast<std::size_t>(c)].fetch_add(n, std::memory_order_relaxed);
+}
+
+inline void record(stat_histogram h, std::uint64_t v) {
+    histogram_cells& cells = local().histograms[static_cast<std::size_t>(h)];
+    cells.count.fetch_add(1, std::memory_order_relaxed);
+    cells.sum.fetch_add(v, std::memory_order_relaxed);
+    if (v < cells.min.load(std::memory_order_relaxed)) cells.min.store(v, std::memory_order_relaxed);
+    if (v > cells.max.load(std::memory_order_relaxed)) cells.max.store(v, std::memory_order_relaxed);
+    cells.buckets[static_cast<std::size_t>(std::bit_width(v))].fetch_add(1, std::memory_order_relaxed);
+}
+
+extern std::atomic<bool> tracing_on;
+
+std::uint64_t now_ns() noexcept;
+void emit_span(const char* name, std::uint64_t begin_ns, std::uint64_t end_ns);
+
+// Times a scope into a histogram (and the trace, while tracing)
+class scoped_span {
+public:
+    scoped_span(stat_histogram h, const char* name) noexcept
+        : h_(h), name_(name), begin_(now_ns()) {}
+
+    ~scoped_span() {
+        std::uint64_t end = now_ns();
+        record(h_, end - begin_);
+        if (tracing_on.load(std::memory_order_relaxed)) emit_span(name_, begin_, end);
+    }
+
+    scoped_span(const scoped_span&)            = delete;
+    scoped_span& operator=(const scoped_span&) = delete;
+
+private:
+    stat_histogram h_;
+    const char* name_;   // string literal
+    std::uint64_t begin_;
+};
+
+} // namespace stats_detail
+
+#define PYL_STATS_CAT_(a, b) a##b
+#define PYL_STATS_CAT(a, b) PYL_STATS_CAT_(a, b)
+
+#define PYL_STATS_INC(c)     ::pyl::stats_detail::add(::pyl::stat_counter::c, 1)
+#define PYL_STATS_ADD(c, n)  ::pyl::stats_detail::add(::pyl::stat_counter::c, static_cast<std::uint64_t>(n))
+#define PYL_STATS_RECORD(h, v) \
+    ::pyl::stats_detail::record(::pyl::stat_histogram::h, static_cast<std::uint64_t>(v))
+#define PYL_STATS_SPAN(h, name) \
+    const ::pyl::stats_detail::scoped_span PYL_STATS_CAT(pyl_stats_span_, __LINE__)(::pyl::stat_histogram::h, name)
+
+#else
+
+#define PYL_STATS_INC(c)        static_cast<void>(0)
+#define PYL_STATS_ADD(c, n)     static_cast<void>(0)
+#define PYL_STATS_RECORD(h, v)  static_cast<void>(0)
+#define PYL_STATS_SPAN(h, name) static_cast<void>(0)
+
+#endif
+
+} // namespace pyl
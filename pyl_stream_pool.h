@@ -0,0 +1,98 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <ios>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+namespace pyl {
+
+// ---------------------------------------------------------
+// stream_lease – a reusable per-thread std::ostringstream
+//
+//   pyl::stream_lease s;
+//   s.stream() << value;
+//   return Text{s.str()};
+//
+// Constructing an ostringstream dominates small operator<< formatting
+// (ios_base init, locale copy, buffer allocation). Each thread keeps
+// one stream per nesting level, so an operator<< that itself calls
+// to_text() gets its own stream; deeper nesting falls back to a fresh
+// stream. On release the stream is emptied (keeping its buffer unless
+// it grew past max_retained) and its format flags, precision, width
+// and fill are restored, so a leaked std::hex never reaches the next
+// user. An imbued locale is not reset.
+// ---------------------------------------------------------
+
+namespace stream_pool_detail {
+
+inline constexpr std::size_t max_depth    = 8;
+inline constexpr std::size_t max_retained = 64 * 1024;   // buffer bytes kept per stream
+
+struct pool {
+    std::array<std::unique_ptr<std::ostringstream>, max_depth> streams;
+    std::size_t depth = 0;
+};
+
+inline thread_local pool tls_pool;
+
+inline void reset(std::ostringstream& os) {
+    std::string buf = std::move(os).str();
+    if (buf.capacity() > max_retained) {
+        buf = std::string();
+    } else {
+        buf.clear();
+    }
+    os.str(std::move(buf));
+    os.clear();
+    os.flags(std::ios_base::skipws | std::ios_base::dec);
+    os.precision(6);
+    os.width(0);
+    os.fill(os.widen(' '));
+}
+
+} // namespace stream_pool_detail
+
+class stream_lease {
+public:
+    stream_lease() {
+        auto& p = stream_pool_detail::tls_pool;
+        if (p.depth < stream_pool_detail::max_depth) {
+            auto& slot = p.streams[p.depth];
+            if (!slot) slot = std::make_unique<std::ostringstream>();
+            os_ = slot.get();
+        } else {
+            overflow_ = std::make_unique<std::ostringstream>();
+            os_ = overflow_.get();
+        }
+        ++p.depth;
+    }
+
+    ~stream_lease() {
+        --stream_pool_detail::tls_pool.depth;
+        if (!overflow_) stream_pool_detail::reset(*os_);
+    }
+
+    stream_lease(const stream_lease&)            = delete;
+    stream_lease& operator=(const stream_lease&) = delete;
+
+    std::ostream& stream() noexcept { return *os_; }
+
+    // Valid until the next write or the end of the lease
+    std::string_view view() const noexcept { return os_->view(); }
+    std::string str() const { return std::string(view()); }
+
+private:
+    std::ostringstream* os_ = nullptr;
+    std::unique_ptr<std::ostringstream> overflow_;
+};
+
+// Nesting depth of live leases on this thread (for tests)
+inline std::size_t stream_lease_depth() noexcept {
+    return stream_pool_detail::tls_pool.depth;
+}
+
+} // namespace pyl
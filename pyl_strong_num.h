@@ -2,8 +2,15 @@
 
 #include <cstdint>
 #include <cstddef>
+#include <cstring>
+#include <string_view>
 #include <type_traits>
 #include <ostream>
+#include <stdexcept>
+#include <string>
+
+#include "pyl_chars.h"
+#include "pyl_type_name.h"
 
 namespace pyl {
 
@@ -74,6 +81,39 @@ using NumTypeT = typename NumType<K, B>::type;
 
 namespace strong_num_detail {
 
+// std::is_integral / std::numeric_limits do not cover __int128 in
+// strict (-std=c++20) mode, so the 128-bit kinds get their own traits.
+using chars_detail::is_int128_v;
+
+template <typename T>
+inline constexpr bool is_integer_v =
+    (std::is_integral_v<T> && !std::is_same_v<std::remove_cv_t<T>, bool>) ||
+    is_int128_v<T>;
+
+template <typename T>
+inline constexpr bool is_signed_integer_v = [] {
+    if constexpr (is_integer_v<T>) {
+        return T(-1) < T(0);
+    } else {
+        return false;
+    }
+}();
+
+template <typename T>
+struct int_limits {
+    static_assert(is_integer_v<T>, "int_limits<T> requires an integer T");
+    static constexpr std::size_t bits = sizeof(T) * 8;
+
+    static constexpr T min() noexcept {
+        if constexpr (is_signed_integer_v<T>) {
+            return static_cast<T>(T(1) << (bits - 1));
+        } else {
+            return T(0);
+        }
+    }
+    static constexpr T max() noexcept { return static_cast<T>(~min()); }
+};
+
 template <typename From, typename To>
 struct is_widening_type {
     static constexpr bool value = [] {
@@ -82,8 +122,8 @@ struct is_widening_type {
             return true;
         }
         // integral -> integral, same signedness, sizeof(To) >= sizeof(From)
-        else if constexpr (std::is_integral_v<From> && std::is_integral_v<To> &&
-                           std::is_signed_v<From> == std::is_signed_v<To>) {
+        else if constexpr (is_integer_v<From> && is_integer_v<To> &&
+                           is_signed_integer_v<From> == is_signed_integer_v<To>) {
             return sizeof(To) >= sizeof(From);
         }
         // float -> float, sizeof(To) >= sizeof(From)
@@ -104,43 +144,229 @@ inline constexpr bool is_widening_type_v = is_widening_type<From, To>::value;
 } // namespace strong_num_detail
 
 // =========================
-// 4. StrongNumber<T, Tag>
+// 4. Overflow policies
+// =========================
+//
+// What integer +, -, *, / and unary - do when the exact result does
+// not fit in T:
+//   Native   – plain C++ arithmetic (default; signed overflow is UB)
+//   Wrap     – two's-complement wrap-around, for signed types too
+//   Saturate – clamp to the type's min / max
+//   Checked  – throw std::overflow_error
+// Floating-point StrongNumbers ignore the policy. A tag opts in with
+// a static member (or use STRONG_NUM_OVERFLOW below):
+//
+//   struct CountTag { static constexpr pyl::Overflow overflow = pyl::Overflow::Saturate; };
+//   using Count = pyl::StrongNumber<std::uint32_t, CountTag>;
+
+enum class Overflow { Native, Wrap, Saturate, Checked };
+
+template <typename Tag>
+inline constexpr Overflow overflow_policy_v = [] {
+    if constexpr (requires { Tag::overflow; }) {
+        return static_cast<Overflow>(Tag::overflow);
+    } else {
+        return Overflow::Native;
+    }
+}();
+
+namespace strong_num_detail {
+
+#if defined(__GNUC__) || defined(__clang__)
+#define PYL_HAS_OVERFLOW_BUILTINS 1
+#else
+#define PYL_HAS_OVERFLOW_BUILTINS 0
+#endif
+
+[[noreturn]] inline void throw_overflow(const char* op) {
+    throw std::overflow_error(std::string("StrongNumber: integer overflow in operator") + op);
+}
+
+// Each op computes a OP b, sets `overflowed` when the exact result does
+// not fit in T and returns the wrapped value (the clamped one under
+// Saturate). No branches on the hot path: the builtins compile to the
+// flag-setting instruction and saturation to a conditional select.
+// Non-integer T and the Native policy use plain arithmetic.
+
+struct add_op {
+    static constexpr const char* name = "+";
+
+    template <Overflow P, typename T>
+    static constexpr T eval(T a, T b, bool& overflowed) noexcept {
+        if constexpr (P == Overflow::Native || !is_integer_v<T>) {
+            return static_cast<T>(a + b);
+        } else {
+            T r{};
+#if PYL_HAS_OVERFLOW_BUILTINS
+            overflowed = __builtin_add_overflow(a, b, &r);
+#else
+            using U = std::make_unsigned_t<T>;
+            r = static_cast<T>(static_cast<U>(static_cast<U>(a) + static_cast<U>(b)));
+            if constexpr (is_signed_integer_v<T>) {
+                overflowed = (b < 0) ? (r > a) : (r < a);
+            } else {
+                overflowed = r < a;
+            }
+#endif
+            if constexpr (P == Overflow::Saturate) {
+                T bound = int_limits<T>::max();
+                if constexpr (is_signed_integer_v<T>) {
+                    bound = b < 0 ? int_limits<T>::min() : int_limits<T>::max();
+                }
+                r = overflowed ? bound : r;
+            }
+            return r;
+        }
+    }
+};
+
+struct sub_op {
+    static constexpr const char* name = "-";
+
+    template <Overflow P, typename T>
+    static constexpr T eval(T a, T b, bool& overflowed) noexcept {
+        if constexpr (P == Overflow::Native || !is_integer_v<T>) {
+            return static_cast<T>(a - b);
+        } else {
+            T r{};
+#if PYL_HAS_OVERFLOW_BUILTINS
+            overflowed = __builtin_sub_overflow(a, b, &r);
+#else
+            using U = std::make_unsigned_t<T>;
+            r = static_cast<T>(static_cast<U>(static_cast<U>(a) - static_cast<U>(b)));
+            if constexpr (is_signed_integer_v<T>) {
+                overflowed = (b < 0) ? (r < a) : (r > a);
+            } else {
+                overflowed = b > a;
+            }
+#endif
+            if constexpr (P == Overflow::Saturate) {
+                T bound = int_limits<T>::min();
+                if constexpr (is_signed_integer_v<T>) {
+                    bound = b < 0 ? int_limits<T>::max() : int_limits<T>::min();
+                }
+                r = overflowed ? bound : r;
+            }
+            return r;
+        }
+    }
+};
+
+struct mul_op {
+    static constexpr const char* name = "*";
+
+    template <Overflow P, typename T>
+    static constexpr T eval(T a, T b, bool& overflowed) noexcept {
+        if constexpr (P == Overflow::Native || !is_integer_v<T>) {
+            return static_cast<T>(a * b);
+        } else {
+            T r{};
+#if PYL_HAS_OVERFLOW_BUILTINS
+            overflowed = __builtin_mul_overflow(a, b, &r);
+#else
+            using U = std::make_unsigned_t<T>;
+            r = static_cast<T>(static_cast<U>(
+                static_cast<unsigned long long>(static_cast<U>(a)) *
+                static_cast<unsigned long long>(static_cast<U>(b))));
+            if constexpr (is_signed_integer_v<T>) {
+                constexpr T lo = int_limits<T>::min();
+                overflowed = (a == T(-1) && b == lo) || (b == T(-1) && a == lo) ||
+                             (a != 0 && !(a == T(-1)) && r / a != b);
+            } else {
+                overflowed = a != 0 && r / a != b;
+            }
+#endif
+            if constexpr (P == Overflow::Saturate) {
+                T bound = int_limits<T>::max();
+                if constexpr (is_signed_integer_v<T>) {
+                    bound = ((a < 0) != (b < 0)) ? int_limits<T>::min() : int_limits<T>::max();
+                }
+                r = overflowed ? bound : r;
+            }
+            return r;
+        }
+    }
+};
+
+// Only min / -1 overflows; division by zero stays undefined as for T.
+struct div_op {
+    static constexpr const char* name = "/";
+
+    template <Overflow P, typename T>
+    static constexpr T eval(T a, T b, bool& overflowed) noexcept {
+        if constexpr (P == Overflow::Native || !is_signed_integer_v<T>) {
+            return static_cast<T>(a / b);
+        } else {
+            overflowed = a == int_limits<T>::min() && b == T(-1);
+            if (overflowed) {
+                return P == Overflow::Saturate ? int_limits<T>::max() : int_limits<T>::min();
+            }
+            return static_cast<T>(a / b);
+        }
+    }
+};
+
+// One policy-checked operation (throws under Checked)
+template <Overflow P, typename Op, typename T>
+constexpr T apply(T a, T b) noexcept(P != Overflow::Checked) {
+    bool overflowed = false;
+    T r = Op::template eval<P>(a, b, overflowed);
+    if constexpr (P == Overflow::Checked) {
+        if (overflowed) throw_overflow(Op::name);
+    }
+    return r;
+}
+
+} // namespace strong_num_detail
+
+// =========================
+// 5. StrongNumber<T, Tag>
 // =========================
 
 template <typename T, typename Tag>
 class StrongNumber {
-    static_assert(std::is_arithmetic_v<T>,
+    static_assert(std::is_arithmetic_v<T> || strong_num_detail::is_int128_v<T>,
                   "StrongNumber<T, Tag> requires arithmetic T");
 
 public:
     using value_type = T;
     using tag_type   = Tag;
 
+    static constexpr Overflow overflow_policy = overflow_policy_v<Tag>;
+    static constexpr bool nothrow_arithmetic = overflow_policy != Overflow::Checked;
+
     // constructors
     constexpr StrongNumber() = default;
-    explicit constexpr StrongNumber(T v) : value_(v) {}
+    explicit constexpr StrongNumber(T v) noexcept : value_(v) {}
 
     // access
     constexpr T value() const noexcept { return value_; }
 
     // arithmetic (same T, same Tag)
     constexpr StrongNumber operator+() const noexcept { return *this; }
-    constexpr StrongNumber operator-() const noexcept { return StrongNumber(-value_); }
+    constexpr StrongNumber operator-() const noexcept(nothrow_arithmetic) {
+        if constexpr (overflow_policy == Overflow::Native || !strong_num_detail::is_integer_v<T>) {
+            return StrongNumber(-value_);
+        } else {
+            return StrongNumber(strong_num_detail::apply<overflow_policy, strong_num_detail::sub_op>(
+                T{}, value_));
+        }
+    }
 
-    constexpr StrongNumber& operator+=(const StrongNumber& other) noexcept {
-        value_ += other.value_;
+    constexpr StrongNumber& operator+=(const StrongNumber& other) noexcept(nothrow_arithmetic) {
+        value_ = strong_num_detail::apply<overflow_policy, strong_num_detail::add_op>(value_, other.value_);
         return *this;
     }
-    constexpr StrongNumber& operator-=(const StrongNumber& other) noexcept {
-        value_ -= other.value_;
+    constexpr StrongNumber& operator-=(const StrongNumber& other) noexcept(nothrow_arithmetic) {
+        value_ = strong_num_detail::apply<overflow_policy, strong_num_detail::sub_op>(value_, other.value_);
         return *this;
     }
-    constexpr StrongNumber& operator*=(const StrongNumber& other) noexcept {
-        value_ *= other.value_;
+    constexpr StrongNumber& operator*=(const StrongNumber& other) noexcept(nothrow_arithmetic) {
+        value_ = strong_num_detail::apply<overflow_policy, strong_num_detail::mul_op>(value_, other.value_);
         return *this;
     }
     constexpr StrongNumber& operator/=(const StrongNumber& other) {
-        value_ /= other.value_;
+        value_ = strong_num_detail::apply<overflow_policy, strong_num_detail::div_op>(value_, other.value_);
         return *this;
     }
 
@@ -189,12 +415,34 @@ public:
     // ObjInterface methods
     // ------------------------
 
+    // Allocation-free formatting (same text as std::to_string(value())).
+    // format_to() needs room for max_chars characters.
+    static constexpr std::size_t max_chars = pyl::max_chars<T>;
+
+    char* to_chars(char* first, char* last) const noexcept {
+        return pyl::to_chars(first, last, value_);
+    }
+
+    char* format_to(char* buf) const noexcept {
+        return pyl::to_chars(buf, buf + max_chars, value_);
+    }
+
     std::string to_string() const {
-        return std::to_string(value_);
+        char buf[max_chars];
+        return std::string(buf, format_to(buf));
     }
 
+    // "[pyl::StrongNumber<T, Tag> value=...]", built in one stack buffer
     std::string to_full_string() const {
-        return "[StrongNumber value=" + std::to_string(value_) + "]";
+        constexpr std::string_view name = type_name<StrongNumber>();
+        constexpr std::string_view label = " value=";
+        char buf[1 + name.size() + label.size() + max_chars + 1];
+        buf[0] = '[';
+        std::memcpy(buf + 1, name.data(), name.size());
+        std::memcpy(buf + 1 + name.size(), label.data(), label.size());
+        char* end = format_to(buf + 1 + name.size() + label.size());
+        *end++ = ']';
+        return std::string(buf, end);
     }
 
     // Text conversion methods - declared after including pyl_text.h
@@ -204,7 +452,14 @@ public:
     }
 
     constexpr std::size_t hash() const noexcept {
-        return std::hash<T>{}(value_);
+        if constexpr (strong_num_detail::is_int128_v<T>) {
+            // no std::hash for __int128 in strict mode: fold the halves
+            auto lo = static_cast<std::uint64_t>(value_);
+            auto hi = static_cast<std::uint64_t>(value_ >> 64);
+            return std::hash<std::uint64_t>{}(lo ^ (hi * 0x9e3779b97f4a7c15ULL));
+        } else {
+            return std::hash<T>{}(value_);
+        }
     }
 
     // ------------------------
@@ -227,6 +482,19 @@ private:
     T value_{};
 };
 
+// StrongNumber is a zero-overhead wrapper: same size, alignment and
+// copy semantics as T (pyl_strong_span.h relies on this)
+static_assert(std::is_standard_layout_v<StrongNumber<int, void>> &&
+              std::is_trivially_copyable_v<StrongNumber<int, void>> &&
+              sizeof(StrongNumber<double, void>) == sizeof(double) &&
+              alignof(StrongNumber<double, void>) == alignof(double),
+              "StrongNumber must be layout-compatible with its value_type");
+
+// Unit tags (pyl_units.h) define their own * and / (dimension algebra);
+// the same-tag overloads below skip them.
+template <typename Tag>
+inline constexpr bool is_unit_tag_v = requires { typename Tag::unit_dimension; };
+
 // common-type helper
 template <typename T, typename U, typename Tag>
 using StrongCommon = StrongNumber<std::common_type_t<T, U>, Tag>;
@@ -234,34 +502,39 @@ using StrongCommon = StrongNumber<std::common_type_t<T, U>, Tag>;
 // arithmetic (same Tag, any T/U)
 template <typename T, typename U, typename Tag>
 constexpr StrongCommon<T, U, Tag>
-operator+(const StrongNumber<T, Tag>& a, const StrongNumber<U, Tag>& b) {
+operator+(const StrongNumber<T, Tag>& a, const StrongNumber<U, Tag>& b)
+    noexcept(overflow_policy_v<Tag> != Overflow::Checked) {
     using R = std::common_type_t<T, U>;
-    return StrongCommon<T, U, Tag>(
-        static_cast<R>(a.value()) + static_cast<R>(b.value()));
+    return StrongCommon<T, U, Tag>(strong_num_detail::apply<overflow_policy_v<Tag>, strong_num_detail::add_op>(
+        static_cast<R>(a.value()), static_cast<R>(b.value())));
 }
 
 template <typename T, typename U, typename Tag>
 constexpr StrongCommon<T, U, Tag>
-operator-(const StrongNumber<T, Tag>& a, const StrongNumber<U, Tag>& b) {
+operator-(const StrongNumber<T, Tag>& a, const StrongNumber<U, Tag>& b)
+    noexcept(overflow_policy_v<Tag> != Overflow::Checked) {
     using R = std::common_type_t<T, U>;
-    return StrongCommon<T, U, Tag>(
-        static_cast<R>(a.value()) - static_cast<R>(b.value()));
+    return StrongCommon<T, U, Tag>(strong_num_detail::apply<overflow_policy_v<Tag>, strong_num_detail::sub_op>(
+        static_cast<R>(a.value()), static_cast<R>(b.value())));
 }
 
 template <typename T, typename U, typename Tag>
+    requires (!is_unit_tag_v<Tag>)
 constexpr StrongCommon<T, U, Tag>
-operator*(const StrongNumber<T, Tag>& a, const StrongNumber<U, Tag>& b) {
+operator*(const StrongNumber<T, Tag>& a, const StrongNumber<U, Tag>& b)
+    noexcept(overflow_policy_v<Tag> != Overflow::Checked) {
     using R = std::common_type_t<T, U>;
-    return StrongCommon<T, U, Tag>(
-        static_cast<R>(a.value()) * static_cast<R>(b.value()));
+    return StrongCommon<T, U, Tag>(strong_num_detail::apply<overflow_policy_v<Tag>, strong_num_detail::mul_op>(
+        static_cast<R>(a.value()), static_cast<R>(b.value())));
 }
 
 template <typename T, typename U, typename Tag>
+    requires (!is_unit_tag_v<Tag>)
 constexpr StrongCommon<T, U, Tag>
 operator/(const StrongNumber<T, Tag>& a, const StrongNumber<U, Tag>& b) {
     using R = std::common_type_t<T, U>;
-    return StrongCommon<T, U, Tag>(
-        static_cast<R>(a.value()) / static_cast<R>(b.value()));
+    return StrongCommon<T, U, Tag>(strong_num_detail::apply<overflow_policy_v<Tag>, strong_num_detail::div_op>(
+        static_cast<R>(a.value()), static_cast<R>(b.value())));
 }
 
 // comparisons (same Tag, any T/U)
@@ -303,20 +576,36 @@ constexpr bool operator>=(const StrongNumber<T, Tag>& a,
     return !(a < b);
 }
 
+// to_chars / max_chars hooks (pyl_chars.h): append_chars, to_text and
+// F write strong values straight into their output buffer
+template <typename T, typename Tag>
+inline constexpr std::size_t max_chars<StrongNumber<T, Tag>> = max_chars<T>;
+
+template <typename T, typename Tag>
+inline char* to_chars(char* first, char* last, const StrongNumber<T, Tag>& v) noexcept {
+    return v.to_chars(first, last);
+}
+
 // ostream
 template <typename T, typename Tag>
 inline std::ostream& operator<<(std::ostream& os,
                                 const StrongNumber<T, Tag>& v) {
-    return os << v.value();
+    if constexpr (strong_num_detail::is_int128_v<T>) {
+        char buf[max_chars<T>];
+        return os.write(buf, v.format_to(buf) - buf);
+    } else {
+        return os << v.value();
+    }
 }
 
 } // namespace pyl
 
 // =========================
-// 5. STRONG_NUM macro
+// 6. STRONG_NUM macro
 //    STRONG_NUM(Name)
 //    STRONG_NUM(Name, Kind)
 //    STRONG_NUM(Name, Kind, Bits)
+//    STRONG_NUM_OVERFLOW(Name, Kind, Bits, Policy)
 // =========================
 
 #define STRONG_NUM_IMPL(BaseName, Kind, Bits)                                   \
@@ -344,5 +633,15 @@ inline std::ostream& operator<<(std::ostream& os,
 // public macro
 #define STRONG_NUM(...) STRONG_NUM_DISPATCH(__VA_ARGS__)(__VA_ARGS__)
 
+// with an overflow policy, e.g.
+//   STRONG_NUM_OVERFLOW(Ticks, pyl::NumKind::Size, pyl::NumBits::B64, pyl::Overflow::Saturate);
+#define STRONG_NUM_OVERFLOW(BaseName, Kind, Bits, Policy)                       \
+    struct BaseName##Tag {                                                      \
+        static constexpr pyl::Overflow overflow = Policy;                       \
+    };                                                                          \
+    using BaseName =                                                            \
+        pyl::StrongNumber<pyl::NumTypeT<Kind, Bits>, BaseName##Tag>
+
 // Note: to_text() and to_full_text() for StrongNumber are provided by
-// the generic implementations in pyl_text.h which call to_string()
+// the generic implementations in pyl_text.h, which write through the
+// to_chars() hook above
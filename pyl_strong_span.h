@@ -0,0 +1,333 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include "pyl_strong_num.h"
+
+namespace pyl {
+
+// ---------------------------------------------------------
+// strong_span – contiguous arrays of StrongNumber with bulk kernels
+//
+// StrongNumber<T, Tag> is layout-compatible with T (checked below),
+// so a span of strong values can be viewed as a span of T for
+// vectorized loops while the public API keeps the tag:
+//
+//   std::vector<Price> prices = ...;
+//   pyl::bulk::scale(prices, 1.2);                  // Price stays Price
+//   Price hi = pyl::bulk::max(prices);
+//   std::span<double> raw = pyl::reinterpret_as_underlying(std::span(prices));
+// ---------------------------------------------------------
+
+template <typename S>
+struct is_strong_number : std::false_type {};
+
+template <typename T, typename Tag>
+struct is_strong_number<StrongNumber<T, Tag>> : std::true_type {};
+
+template <typename S>
+concept strong_number = is_strong_number<std::remove_cv_t<S>>::value;
+
+// Layout guarantees the span reinterpretation relies on
+template <strong_number S>
+inline constexpr bool is_layout_compatible_strong_v =
+    std::is_standard_layout_v<std::remove_cv_t<S>> &&
+    std::is_trivially_copyable_v<std::remove_cv_t<S>> &&
+    sizeof(S) == sizeof(typename S::value_type) &&
+    alignof(S) == alignof(typename S::value_type);
+
+template <strong_number S, std::size_t Extent = std::dynamic_extent>
+using strong_span = std::span<S, Extent>;
+
+namespace strong_span_detail {
+
+template <typename S>
+using underlying_t = std::conditional_t<std::is_const_v<S>,
+                                        const typename S::value_type,
+                                        typename S::value_type>;
+
+template <typename A, typename B>
+void require_same_size(std::span<A> a, std::span<B> b, const char* what) {
+    if (a.size() != b.size()) {
+        throw std::invalid_argument(std::string(what) + ": span sizes differ");
+    }
+}
+
+// ---- overflow-policy kernels (integer tags with a non-Native policy) ----
+
+template <typename T>
+constexpr T operand(const T* y, std::size_t i) noexcept { return y[i]; }
+
+template <typename T>
+constexpr T operand(T y, std::size_t) noexcept { return y; }
+
+// o[i] = x[i] OP y (y is a second array or a scalar) under policy P.
+// Up to 32 bits the exact result is formed in 64 bits and clamped, which
+// vectorizes to plain min/max; wider types use the overflow builtins with
+// a select. Overflow flags are OR-ed across the loop and Checked throws
+// once at the end, after `o` has been written with wrapped values.
+template <Overflow P, typename Op, typename T, typename Y>
+void policy_kernel(const T* x, Y y, T* o, std::size_t n) {
+    using strong_num_detail::int_limits;
+    bool overflowed = false;
+    if constexpr (sizeof(T) <= 4) {
+        using W = std::conditional_t<strong_num_detail::is_signed_integer_v<T>,
+                                     std::int64_t, std::uint64_t>;
+        constexpr W hi = static_cast<W>(int_limits<T>::max());
+        constexpr W lo = static_cast<W>(int_limits<T>::min());
+        for (std::size_t i = 0; i < n; ++i) {
+            W a = static_cast<W>(x[i]);
+            W b = static_cast<W>(operand(y, i));
+            W r{};
+            if constexpr (std::is_same_v<Op, strong_num_detail::add_op>) {
+                r = a + b;
+            } else {
+                r = a * b;
+            }
+            bool out_of_range = r > hi;
+            if constexpr (strong_num_detail::is_signed_integer_v<T>) {
+                out_of_range = out_of_range || r < lo;
+            }
+            overflowed = overflowed || out_of_range;
+            if constexpr (P == Overflow::Saturate) {
+                r = r > hi ? hi : r;
+                if constexpr (strong_num_detail::is_signed_integer_v<T>) r = r < lo ? lo : r;
+            }
+            o[i] = static_cast<T>(r);
+        }
+    } else {
+        constexpr Overflow eval_policy = P == Overflow::Saturate ? P : Overflow::Wrap;
+        for (std::size_t i = 0; i < n; ++i) {
+            bool of = false;
+            o[i] = Op::template eval<eval_policy>(x[i], operand(y, i), of);
+            overflowed = overflowed || of;
+        }
+    }
+    if constexpr (P == Overflow::Checked) {
+        if (overflowed) strong_num_detail::throw_overflow(Op::name);
+    }
+}
+
+template <typename S>
+inline constexpr bool uses_policy_kernel_v =
+    strong_num_detail::is_integer_v<typename S::value_type> &&
+    overflow_policy_v<typename S::tag_type> != Overflow::Native;
+
+} // namespace strong_span_detail
+
+// View strong values as their underlying representation
+template <strong_number S, std::size_t Extent>
+std::span<strong_span_detail::underlying_t<S>, Extent>
+reinterpret_as_underlying(std::span<S, Extent> s) noexcept {
+    static_assert(is_layout_compatible_strong_v<S>,
+                  "StrongNumber must be layout-compatible with its value_type");
+    using U = strong_span_detail::underlying_t<S>;
+    return std::span<U, Extent>(reinterpret_cast<U*>(s.data()), s.size());
+}
+
+// View raw values as strong values of type S
+template <strong_number S, typename U, std::size_t Extent>
+    requires std::is_same_v<std::remove_cv_t<U>, typename std::remove_cv_t<S>::value_type>
+std::span<std::conditional_t<std::is_const_v<U>, const std::remove_cv_t<S>, S>, Extent>
+as_strong(std::span<U, Extent> s) noexcept {
+    static_assert(is_layout_compatible_strong_v<S>,
+                  "StrongNumber must be layout-compatible with its value_type");
+    using R = std::conditional_t<std::is_const_v<U>, const std::remove_cv_t<S>, S>;
+    return std::span<R, Extent>(reinterpret_cast<R*>(s.data()), s.size());
+}
+
+// ---------------------------------------------------------
+// bulk – element-wise kernels; the inner loops run on plain T
+//
+// add, scale and prefix_sum follow the tag's overflow policy
+// (pyl_strong_num.h). Under Checked the whole output is written before
+// std::overflow_error is thrown.
+// ---------------------------------------------------------
+namespace bulk {
+
+// out[i] = a[i] + b[i]
+template <strong_number S>
+void add(std::span<const S> a, std::span<const S> b, std::span<S> out) {
+    strong_span_detail::require_same_size(a, b, "bulk::add");
+    strong_span_detail::require_same_size(a, out, "bulk::add");
+    auto x = reinterpret_as_underlying(a);
+    auto y = reinterpret_as_underlying(b);
+    auto o = reinterpret_as_underlying(out);
+    using T = typename S::value_type;
+    if constexpr (strong_span_detail::uses_policy_kernel_v<S>) {
+        strong_span_detail::policy_kernel<overflow_policy_v<typename S::tag_type>, strong_num_detail::add_op>(
+            x.data(), y.data(), o.data(), o.size());
+    } else {
+        for (std::size_t i = 0; i < o.size(); ++i) o[i] = static_cast<T>(x[i] + y[i]);
+    }
+}
+
+// a[i] += b[i]
+template <strong_number S>
+void add(std::span<S> a, std::span<const S> b) {
+    add<S>(std::span<const S>(a), b, a);
+}
+
+// v[i] *= factor (factor is a plain scalar: scaling keeps the tag)
+template <strong_number S>
+void scale(std::span<S> v, typename S::value_type factor) noexcept(S::nothrow_arithmetic) {
+    auto o = reinterpret_as_underlying(v);
+    using T = typename S::value_type;
+    if constexpr (strong_span_detail::uses_policy_kernel_v<S>) {
+        strong_span_detail::policy_kernel<overflow_policy_v<typename S::tag_type>, strong_num_detail::mul_op>(
+            o.data(), factor, o.data(), o.size());
+    } else {
+        for (std::size_t i = 0; i < o.size(); ++i) o[i] = static_cast<T>(o[i] * factor);
+    }
+}
+
+// mask[i] = a[i] < limit; returns the number of set entries
+template <strong_number S>
+std::size_t less(std::span<const S> a, S limit, std::span<bool> mask) {
+    strong_span_detail::require_same_size(a, mask, "bulk::less");
+    auto x = reinterpret_as_underlying(a);
+    const auto l = limit.value();
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < x.size(); ++i) {
+        bool m = x[i] < l;
+        mask[i] = m;
+        count += m;
+    }
+    return count;
+}
+
+// mask[i] = a[i] < b[i]; returns the number of set entries
+template <strong_number S>
+std::size_t less(std::span<const S> a, std::span<const S> b, std::span<bool> mask) {
+    strong_span_detail::require_same_size(a, b, "bulk::less");
+    strong_span_detail::require_same_size(a, mask, "bulk::less");
+    auto x = reinterpret_as_underlying(a);
+    auto y = reinterpret_as_underlying(b);
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < x.size(); ++i) {
+        bool m = x[i] < y[i];
+        mask[i] = m;
+        count += m;
+    }
+    return count;
+}
+
+namespace detail {
+
+// Branch-free reduction with independent lanes
+template <typename T, typename Pick>
+T reduce_lanes(std::span<const T> x, Pick pick) {
+    if (x.empty()) {
+        throw std::invalid_argument("bulk::min/max: empty span");
+    }
+    constexpr std::size_t lanes = 8;
+    T acc[lanes];
+    for (std::size_t l = 0; l < lanes; ++l) acc[l] = x[0];
+
+    std::size_t i = 0;
+    for (; i + lanes <= x.size(); i += lanes) {
+        for (std::size_t l = 0; l < lanes; ++l) acc[l] = pick(acc[l], x[i + l]);
+    }
+    T r = acc[0];
+    for (std::size_t l = 1; l < lanes; ++l) r = pick(r, acc[l]);
+    for (; i < x.size(); ++i) r = pick(r, x[i]);
+    return r;
+}
+
+} // namespace detail
+
+// Smallest / largest element (throws std::invalid_argument on empty input)
+template <strong_number S>
+std::remove_cv_t<S> min(std::span<const S> a) {
+    using T = typename S::value_type;
+    return std::remove_cv_t<S>(detail::reduce_lanes<T>(
+        reinterpret_as_underlying(a), [](T p, T q) { return q < p ? q : p; }));
+}
+
+template <strong_number S>
+std::remove_cv_t<S> max(std::span<const S> a) {
+    using T = typename S::value_type;
+    return std::remove_cv_t<S>(detail::reduce_lanes<T>(
+        reinterpret_as_underlying(a), [](T p, T q) { return p < q ? q : p; }));
+}
+
+// Inclusive prefix sum: out[i] = a[0] + ... + a[i] (out may alias a)
+template <strong_number S>
+void prefix_sum(std::span<const S> a, std::span<S> out) {
+    strong_span_detail::require_same_size(a, out, "bulk::prefix_sum");
+    auto x = reinterpret_as_underlying(a);
+    auto o = reinterpret_as_underlying(out);
+    using T = typename S::value_type;
+    constexpr Overflow P = strong_span_detail::uses_policy_kernel_v<S>
+                               ? overflow_policy_v<typename S::tag_type>
+                               : Overflow::Native;
+    constexpr Overflow step_policy = P == Overflow::Checked ? Overflow::Wrap : P;
+    T running{};
+    bool overflowed = false;
+    for (std::size_t i = 0; i < x.size(); ++i) {
+        bool of = false;
+        running = strong_num_detail::add_op::eval<step_policy>(running, x[i], of);
+        overflowed = overflowed || of;
+        o[i] = running;
+    }
+    if constexpr (P == Overflow::Checked) {
+        if (overflowed) strong_num_detail::throw_overflow(strong_num_detail::add_op::name);
+    }
+}
+
+template <strong_number S>
+void prefix_sum(std::span<S> v) {
+    prefix_sum<S>(std::span<const S>(v), v);
+}
+
+// Convenience overloads for containers (std::vector<Price>, arrays, ...)
+template <typename A, typename B, typename O>
+    requires strong_number<std::ranges::range_value_t<O>> && std::ranges::contiguous_range<O> &&
+             std::ranges::contiguous_range<A> && std::ranges::contiguous_range<B> &&
+             std::is_same_v<std::ranges::range_value_t<A>, std::ranges::range_value_t<O>> &&
+             std::is_same_v<std::ranges::range_value_t<B>, std::ranges::range_value_t<O>>
+void add(const A& a, const B& b, O& out) {
+    using S = std::ranges::range_value_t<O>;
+    add(std::span<const S>(std::ranges::data(a), std::ranges::size(a)),
+        std::span<const S>(std::ranges::data(b), std::ranges::size(b)),
+        std::span<S>(std::ranges::data(out), std::ranges::size(out)));
+}
+
+template <typename C>
+    requires strong_number<std::ranges::range_value_t<C>> && std::ranges::contiguous_range<C>
+void scale(C& c, typename std::ranges::range_value_t<C>::value_type factor)
+    noexcept(std::ranges::range_value_t<C>::nothrow_arithmetic) {
+    scale(std::span<std::ranges::range_value_t<C>>(std::ranges::data(c), std::ranges::size(c)), factor);
+}
+
+template <typename C>
+    requires strong_number<std::ranges::range_value_t<C>> && std::ranges::contiguous_range<C>
+auto min(const C& c) {
+    using S = std::ranges::range_value_t<C>;
+    return min(std::span<const S>(std::ranges::data(c), std::ranges::size(c)));
+}
+
+template <typename C>
+    requires strong_number<std::ranges::range_value_t<C>> && std::ranges::contiguous_range<C>
+auto max(const C& c) {
+    using S = std::ranges::range_value_t<C>;
+    return max(std::span<const S>(std::ranges::data(c), std::ranges::size(c)));
+}
+
+template <typename C>
+    requires strong_number<std::ranges::range_value_t<C>> && std::ranges::contiguous_range<C>
+void prefix_sum(C& c) {
+    using S = std::ranges::range_value_t<C>;
+    prefix_sum(std::span<S>(std::ranges::data(c), std::ranges::size(c)));
+}
+
+} // namespace bulk
+
+} // namespace pyl
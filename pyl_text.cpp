@@ -1,26 +1,141 @@
 #include "pyl_text.h"
 
+#include <array>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_set>
+
 namespace pyl {
 
 void add_field(FieldMap& m, std::string name, std::any value) {
     m.emplace(std::move(name), std::move(value));
 }
 
+namespace {
+
+struct any_formatter_registry {
+    std::shared_mutex mutex;
+    std::unordered_map<std::type_index, any_formatter> table;
+
+    template <class... Ts>
+    void add_builtin() {
+        (table.emplace(std::type_index(typeid(Ts)), &format_any_as<Ts>), ...);
+    }
+
+    any_formatter_registry() {
+        add_builtin<bool,
+                    short, unsigned short, int, unsigned, long, unsigned long,
+                    long long, unsigned long long, signed char, unsigned char,
+                    float, double, long double,
+                    std::string, std::string_view, const char*, char*,
+                    Text, TextView, InternedText>();
+    }
+};
+
+any_formatter_registry& formatter_registry() {
+    static any_formatter_registry r;
+    return r;
+}
+
+} // namespace
+
+void register_any_formatter(std::type_index type, any_formatter fn) {
+    auto& r = formatter_registry();
+    std::unique_lock<std::shared_mutex> lk(r.mutex);
+    r.table.insert_or_assign(type, fn);
+}
+
+void append_any(std::string& out, const std::any& a) {
+    PYL_STATS_INC(any_format);
+    if (!a.has_value()) {
+        out.append("<null>");
+        return;
+    }
+
+    auto& r = formatter_registry();
+    any_formatter fn = nullptr;
+    {
+        std::shared_lock<std::shared_mutex> lk(r.mutex);
+        auto it = r.table.find(std::type_index(a.type()));
+        if (it != r.table.end()) fn = it->second;
+    }
+
+    if (fn) {
+        fn(out, a);
+    } else {
+        PYL_STATS_INC(any_format_unknown);
+        out.append("<unknown>");
+    }
+}
+
 std::string any_to_string(const std::any& a) {
-    if (!a.has_value()) return "<null>";
-
-    const std::type_info& t = a.type();
-    if (t == typeid(int))         return std::to_string(std::any_cast<int>(a));
-    if (t == typeid(double))      return std::to_string(std::any_cast<double>(a));
-    if (t == typeid(float))       return std::to_string(std::any_cast<float>(a));
-    if (t == typeid(long))        return std::to_string(std::any_cast<long>(a));
-    if (t == typeid(unsigned))    return std::to_string(std::any_cast<unsigned>(a));
-    if (t == typeid(std::string)) return std::any_cast<std::string>(a);
-    if (t == typeid(const char*)) return std::string(std::any_cast<const char*>(a));
-    if (t == typeid(char*))       return std::string(std::any_cast<char*>(a));
-    if (t == typeid(bool))        return std::any_cast<bool>(a) ? "true" : "false";
-
-    return "<unknown>";
+    std::string out;
+    append_any(out, a);
+    return out;
+}
+
+// ===================== Intern pool =====================
+
+namespace {
+
+// Entries are hashed once; lookups by string_view use the same function
+struct entry_hash {
+    using is_transparent = void;
+    std::size_t operator()(std::string_view s) const noexcept { return hash_string(s); }
+    std::size_t operator()(const text_detail::interned_entry& e) const noexcept { return e.hash; }
+};
+
+struct entry_equal {
+    using is_transparent = void;
+    static std::string_view key(std::string_view s) noexcept { return s; }
+    static std::string_view key(const text_detail::interned_entry& e) noexcept { return e.text; }
+
+    template <class A, class B>
+    bool operator()(const A& a, const B& b) const noexcept { return key(a) == key(b); }
+};
+
+// Sharded so concurrent interning of different strings rarely contends.
+// Node-based sets keep element addresses stable; nothing is ever erased.
+struct intern_pool {
+    static constexpr std::size_t shard_count = 16;
+
+    struct shard {
+        std::mutex mutex;
+        std::unordered_set<text_detail::interned_entry, entry_hash, entry_equal> strings;
+    };
+
+    std::array<shard, shard_count> shards;
+};
+
+intern_pool& pool() {
+    static intern_pool* p = new intern_pool;  // leaked: handles may outlive statics
+    return *p;
+}
+
+} // namespace
+
+InternedText intern(std::string_view s) {
+    if (s.empty())
+        return InternedText{};
+
+    std::size_t h = hash_string(s);
+    auto& sh = pool().shards[(h >> 32) % intern_pool::shard_count];
+
+    std::lock_guard<std::mutex> lk(sh.mutex);
+    auto it = sh.strings.find(s);
+    if (it == sh.strings.end())
+        it = sh.strings.insert(text_detail::interned_entry{std::string(s), h}).first;
+    return InternedText{&*it};
+}
+
+std::size_t interned_count() {
+    std::size_t n = 0;
+    for (auto& sh : pool().shards) {
+        std::lock_guard<std::mutex> lk(sh.mutex);
+        n += sh.strings.size();
+    }
+    return n;
 }
 
 } // namespace pyl
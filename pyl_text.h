@@ -6,15 +6,29 @@
 #include <sstream>
 #include <typeinfo>
 #include <concepts>
+#include <cstring>
 #include <ostream>
+#include <ranges>
 #include <array>
 #include <any>
 #include <iostream>
 #include <string_view>
 #include <unordered_map>
+#include <tuple>
+#include <typeindex>
+
+#include "pyl_chars.h"
+#include "pyl_field_storage.h"
+#include "pyl_stats.h"
+#include "pyl_stream_pool.h"
+#include "pyl_type_name.h"
+#include "pyl_hash.h"
+#include "pyl_sink.h"
 
 namespace pyl {
 
+class TextView;
+
 // ---------------------------------------------------------
 // Text – Python-like string concatenation with automatic type conversion
 //
@@ -69,8 +83,11 @@ public:
     Text to_text() const { return *this; }
     Text to_full_text() const { return Text{to_full_string()}; }
 
-    std::size_t hash() const {
-        return std::hash<std::string>{}(data_);
+    // Non-owning view of the contents (valid until the Text changes)
+    TextView view() const noexcept;
+
+    std::size_t hash() const noexcept {
+        return hash_string(data_);
     }
 
     // ObjTemplateInterface methods
@@ -92,15 +109,154 @@ public:
     }
 };
 
+// ---------------------------------------------------------
+// TextView – non-owning, read-only Text (backed by std::string_view)
+//
+// Usage:
+//   void log_label(pyl::TextView label);   // no copy for Text/string/literal
+//   TextView v = text;                     // or text.view()
+//   Text t = v + ": " + 42;                // concatenation yields Text
+//
+// Hashes and compares like the Text with the same contents.
+// ---------------------------------------------------------
+
+class TextView {
+private:
+    std::string_view data_;
+
+public:
+    constexpr TextView() noexcept = default;
+    constexpr TextView(std::string_view s) noexcept : data_(s) {}
+    constexpr TextView(const char* s) : data_(s) {}
+    TextView(const std::string& s) noexcept : data_(s) {}
+    TextView(const Text& t) noexcept : data_(t.str()) {}
+
+    constexpr std::string_view view() const noexcept { return data_; }
+    constexpr operator std::string_view() const noexcept { return data_; }
+
+    constexpr const char* data() const noexcept { return data_.data(); }
+    constexpr std::size_t size() const noexcept { return data_.size(); }
+    constexpr std::size_t length() const noexcept { return data_.size(); }
+    constexpr bool empty() const noexcept { return data_.empty(); }
+
+    // Comparisons (Text, std::string and literals convert implicitly)
+    friend constexpr bool operator==(TextView a, TextView b) noexcept { return a.data_ == b.data_; }
+    friend constexpr auto operator<=>(TextView a, TextView b) noexcept { return a.data_ <=> b.data_; }
+
+    // ObjInterface methods
+    std::string to_string() const { return std::string(data_); }
+    std::string to_full_string() const {
+        return "[TextView value=\"" + to_string() + "\"]";
+    }
+
+    Text to_text() const { return Text{to_string()}; }
+    Text to_full_text() const { return Text{to_full_string()}; }
+
+    std::size_t hash() const noexcept {
+        return hash_string(data_);
+    }
+
+    // ObjTemplateInterface methods
+    constexpr bool equals(const TextView& other) const noexcept { return data_ == other.data_; }
+    constexpr bool full_equals(const TextView& other) const noexcept { return equals(other); }
+    constexpr TextView full_copy() const noexcept { return *this; }
+
+    friend std::ostream& operator<<(std::ostream& os, TextView t) {
+        return os << t.data_;
+    }
+};
+
+inline TextView Text::view() const noexcept {
+    return TextView{data_};
+}
+
+// ---------------------------------------------------------
+// InternedText – handle to a string in a global, append-only pool
+//
+// Usage:
+//   InternedText a = pyl::intern("latency_ms");
+//   InternedText b = pyl::intern(std::string("latency_ms"));
+//   a == b;          // pointer compare
+//   a.hash();        // content hash, computed once at interning
+//
+// Interning takes a (sharded) lock; copies, comparisons and hashing
+// never do. Interned strings live until program exit. The hash equals
+// Text/TextView::hash() of the same contents, so interned keys can
+// probe Text-keyed pyl::flat_map / flat_set.
+// ---------------------------------------------------------
+
+namespace text_detail {
+
+struct interned_entry {
+    std::string text;
+    std::size_t hash;
+};
+
+} // namespace text_detail
+
+class InternedText {
+private:
+    const text_detail::interned_entry* entry_ = nullptr;  // nullptr == ""
+
+    explicit InternedText(const text_detail::interned_entry* e) noexcept : entry_(e) {}
+    friend InternedText intern(std::string_view s);
+
+public:
+    InternedText() noexcept = default;
+
+    std::string_view view() const noexcept {
+        return entry_ ? std::string_view(entry_->text) : std::string_view();
+    }
+    operator TextView() const noexcept { return TextView{view()}; }
+
+    const char* c_str() const noexcept { return entry_ ? entry_->text.c_str() : ""; }
+    std::size_t size() const noexcept { return view().size(); }
+    std::size_t length() const noexcept { return view().size(); }
+    bool empty() const noexcept { return entry_ == nullptr; }
+
+    // Equal contents <=> same pool entry
+    bool operator==(const InternedText& other) const noexcept { return entry_ == other.entry_; }
+    bool operator!=(const InternedText& other) const noexcept { return entry_ != other.entry_; }
+    bool operator<(const InternedText& other) const noexcept { return view() < other.view(); }
+
+    // ObjInterface methods
+    std::string to_string() const { return std::string(view()); }
+    std::string to_full_string() const {
+        return "[InternedText value=\"" + to_string() + "\"]";
+    }
+
+    Text to_text() const { return Text{to_string()}; }
+    Text to_full_text() const { return Text{to_full_string()}; }
+
+    std::size_t hash() const noexcept {
+        return entry_ ? entry_->hash : hash_string({});
+    }
+
+    // ObjTemplateInterface methods
+    bool equals(const InternedText& other) const noexcept { return entry_ == other.entry_; }
+    bool full_equals(const InternedText& other) const noexcept { return equals(other); }
+    InternedText full_copy() const noexcept { return *this; }
+
+    friend std::ostream& operator<<(std::ostream& os, const InternedText& t) {
+        return os << t.view();
+    }
+};
+
+// Implemented in pyl_text.cpp
+InternedText intern(std::string_view s);
+std::size_t interned_count();   // number of distinct strings in the pool
+
 // ---------------------------------------------------------
 // to_text – Convert various types to Text
 // ---------------------------------------------------------
 
-// Arithmetic types (int, double, float, etc.)
+// Arithmetic types (int, double, float, __int128, etc.), via to_chars
 template <typename T,
-          typename = std::enable_if_t<std::is_arithmetic_v<std::decay_t<T>>>>
+          typename = std::enable_if_t<chars_number<std::decay_t<T>>>>
 inline Text to_text(T value) {
-    return Text{std::to_string(value)};
+    std::string s;
+    append_chars(s, value);
+    return Text{std::move(s)};
 }
 
 // String types
@@ -129,6 +285,7 @@ inline Text to_text(Text&& t) {
 // to_text – Generic conversion using multiple strategies (C++20)
 //
 // Priority order:
+//   0. If to_chars() can write T (see pyl_chars.h) → use it
 //   1. If T has to_string() method → use it
 //   2. If T has operator<< → use stringstream
 //   3. Fallback → type name + address
@@ -136,14 +293,20 @@ inline Text to_text(Text&& t) {
 
 // Generic to_text for any type T (uses C++20 requires)
 template <typename T>
-    requires (!std::is_arithmetic_v<std::decay_t<T>> &&
+    requires (!chars_number<std::decay_t<T>> &&
               !std::is_same_v<std::decay_t<T>, std::string> &&
               !std::is_same_v<std::decay_t<T>, Text> &&
               !std::is_same_v<std::decay_t<T>, const char*> &&
               !std::is_same_v<std::decay_t<T>, char*>)
 inline Text to_text(const T& value) {
+    // Strategy 0: to_chars() hook (StrongNumber, ...), no temporaries
+    if constexpr (chars_writable<T>) {
+        std::string s;
+        append_chars(s, value);
+        return Text{std::move(s)};
+    }
     // Strategy 1: T::to_string()
-    if constexpr (requires(const T& v) {
+    else if constexpr (requires(const T& v) {
         { v.to_string() } -> std::convertible_to<std::string>;
     }) {
         return Text{value.to_string()};
@@ -152,16 +315,19 @@ inline Text to_text(const T& value) {
     else if constexpr (requires(std::ostream& os, const T& v) {
         { os << v } -> std::same_as<std::ostream&>;
     }) {
-        std::ostringstream oss;
-        oss << value;
-        return Text{oss.str()};
+        stream_lease s;
+        s.stream() << value;
+        return Text{s.str()};
     }
     // Strategy 3: Fallback to type name + address
     else {
-        std::ostringstream oss;
-        oss << "<" << typeid(T).name()
-            << " @" << static_cast<const void*>(&value) << ">";
-        return Text{oss.str()};
+        PYL_STATS_INC(to_text_typeid);
+        std::string s = "<";
+        s += type_name<T>();
+        s += " @";
+        append_address(s, &value);
+        s += '>';
+        return Text{std::move(s)};
     }
 }
 
@@ -182,15 +348,19 @@ inline Text to_text(T* ptr) {
     else if constexpr (requires(std::ostream& os, const T& v) {
         { os << v } -> std::same_as<std::ostream&>;
     }) {
-        std::ostringstream oss;
-        oss << *ptr;
-        return Text{oss.str()};
+        stream_lease s;
+        s.stream() << *ptr;
+        return Text{s.str()};
     }
     // Fallback: show pointer address
     else {
-        std::ostringstream oss;
-        oss << "<" << typeid(T).name() << " @" << static_cast<const void*>(ptr) << ">";
-        return Text{oss.str()};
+        PYL_STATS_INC(to_text_typeid);
+        std::string s = "<";
+        s += type_name<T>();
+        s += " @";
+        append_address(s, ptr);
+        s += '>';
+        return Text{std::move(s)};
     }
 }
 
@@ -202,35 +372,42 @@ inline Text to_text(T* ptr) {
 // ---------------------------------------------------------
 
 template <typename T>
-    requires (!std::is_arithmetic_v<std::decay_t<T>> &&
+    requires (!chars_number<std::decay_t<T>> &&
               !std::is_same_v<std::decay_t<T>, std::string> &&
               !std::is_same_v<std::decay_t<T>, Text> &&
               !std::is_same_v<std::decay_t<T>, const char*> &&
               !std::is_same_v<std::decay_t<T>, char*>)
 inline Text to_text_full(const T& value) {
-    std::ostringstream oss;
-    oss << "[" << typeid(T).name() << " value=";
-
-    // Get string representation using to_text
-    oss << to_text(value).str();
-
-    oss << "]";
-    return Text{oss.str()};
+    Text repr = to_text(value);
+    constexpr std::string_view name = type_name<T>();
+    std::string s;
+    s.reserve(1 + name.size() + 7 + repr.size() + 1);
+    s += '[';
+    s += name;
+    s += " value=";
+    s += repr.str();
+    s += ']';
+    return Text{std::move(s)};
 }
 
 // Pointer overload for to_text_full
 template <typename T>
 inline Text to_text_full(T* ptr) {
     if (!ptr) {
-        return Text{"[" + std::string(typeid(T*).name()) + " value=<null>]"};
+        std::string s = "[";
+        s += type_name<T*>();
+        s += " value=<null>]";
+        return Text{std::move(s)};
     }
 
-    std::ostringstream oss;
-    oss << "[" << typeid(T).name() << "* ";
-    oss << "value=" << to_text(*ptr).str();
-    oss << " @" << static_cast<const void*>(ptr);
-    oss << "]";
-    return Text{oss.str()};
+    std::string s = "[";
+    s += type_name<T>();
+    s += "* value=";
+    s += to_text(*ptr).str();
+    s += " @";
+    append_address(s, ptr);
+    s += ']';
+    return Text{std::move(s)};
 }
 
 // Text specializations for to_text_full
@@ -238,6 +415,14 @@ inline Text to_text_full(const Text& t) {
     return Text{"[Text value=\"" + t.str() + "\"]"};
 }
 
+inline Text to_text_full(TextView v) {
+    return Text{v.to_full_string()};
+}
+
+inline Text to_text_full(const InternedText& t) {
+    return Text{t.to_full_string()};
+}
+
 inline Text to_text_full(const std::string& s) {
     return Text{"[std::string value=\"" + s + "\"]"};
 }
@@ -251,11 +436,14 @@ inline Text to_text_full(const char* s) {
 
 // Arithmetic types for to_text_full
 template <typename T>
-    requires std::is_arithmetic_v<std::decay_t<T>>
+    requires chars_number<std::decay_t<T>>
 inline Text to_text_full(T value) {
-    std::ostringstream oss;
-    oss << "[" << typeid(T).name() << " value=" << std::to_string(value) << "]";
-    return Text{oss.str()};
+    std::string s = "[";
+    s += type_name<T>();
+    s += " value=";
+    append_chars(s, value);
+    s += ']';
+    return Text{std::move(s)};
 }
 
 // ---------------------------------------------------------
@@ -264,21 +452,125 @@ inline Text to_text_full(T value) {
 // ---------------------------------------------------------
 
 // Forward declaration
-template<typename Parent, typename T, typename Deleter>
+template<typename Parent, typename T, typename Deleter, field_storage FieldStorage>
 class child_unique_ptr;
 
 // to_text for child_unique_ptr - uses the pointer's to_string() method
-template <typename Parent, typename T, typename Deleter>
-inline Text to_text(const child_unique_ptr<Parent, T, Deleter>& ptr) {
+template <typename Parent, typename T, typename Deleter, typename FieldStorage>
+inline Text to_text(const child_unique_ptr<Parent, T, Deleter, FieldStorage>& ptr) {
     return Text{ptr.to_string()};
 }
 
 // to_text_full for child_unique_ptr - uses the pointer's to_full_string() method
-template <typename Parent, typename T, typename Deleter>
-inline Text to_text_full(const child_unique_ptr<Parent, T, Deleter>& ptr) {
+template <typename Parent, typename T, typename Deleter, typename FieldStorage>
+inline Text to_text_full(const child_unique_ptr<Parent, T, Deleter, FieldStorage>& ptr) {
     return Text{ptr.to_full_string()};
 }
 
+// ---------------------------------------------------------
+// append_text – append the to_text() form of a value to a string
+//
+// Arithmetic values and strings are written in place (no temporary
+// Text); everything else goes through to_text().
+// ---------------------------------------------------------
+
+namespace text_detail {
+
+template <typename T>
+inline constexpr bool is_text_v = std::is_same_v<std::remove_cvref_t<T>, Text>;
+
+template <typename T>
+inline constexpr bool is_text_view_v = std::is_same_v<std::remove_cvref_t<T>, TextView>;
+
+template <typename T>
+inline constexpr bool is_char_ptr_v =
+    std::is_pointer_v<T> &&
+    std::is_same_v<std::remove_cv_t<std::remove_pointer_t<T>>, char>;
+
+template <typename T>
+void append_text(std::string& out, const T& value) {
+    if constexpr (chars_writable<T>) {
+        append_chars(out, value);
+    } else if constexpr (std::is_same_v<T, Text>) {
+        out.append(value.str());
+    } else if constexpr (std::is_same_v<T, TextView> || std::is_same_v<T, InternedText>) {
+        out.append(value.view());
+    } else if constexpr (std::is_same_v<T, std::string> ||
+                         std::is_same_v<T, std::string_view> ||
+                         is_char_ptr_v<std::decay_t<T>>) {
+        out.append(value);
+    } else {
+        out.append(to_text(value).str());
+    }
+}
+
+// concat() parts: strings become views, numbers stay numbers,
+// everything else is converted to Text once
+template <typename T>
+auto concat_part(const T& value) {
+    if constexpr (chars_writable<T>) {
+        return value;
+    } else if constexpr (std::is_same_v<T, Text>) {
+        return std::string_view(value.str());
+    } else if constexpr (std::is_same_v<T, TextView> || std::is_same_v<T, InternedText>) {
+        return value.view();
+    } else if constexpr (std::is_same_v<T, std::string> ||
+                         std::is_same_v<T, std::string_view>) {
+        return std::string_view(value);
+    } else if constexpr (is_char_ptr_v<std::decay_t<T>>) {
+        return std::string_view(value);
+    } else {
+        return to_text(value);
+    }
+}
+
+template <typename P>
+std::size_t concat_size(const P& part) {
+    if constexpr (chars_writable<P>) {
+        return max_chars<P>;
+    } else {
+        return part.size();
+    }
+}
+
+template <typename P>
+void concat_append(std::string& out, const P& part) {
+    if constexpr (chars_writable<P>) {
+        append_chars(out, part);
+    } else if constexpr (std::is_same_v<P, Text>) {
+        out.append(part.str());
+    } else {
+        out.append(part);
+    }
+}
+
+} // namespace text_detail
+
+// ---------------------------------------------------------
+// concat – build a Text from many parts with a single allocation
+//
+//   Text t = pyl::concat("rows=", n, ", name=", name, ", at=", point);
+//
+// Measures the total length first, reserves once, then appends.
+// Same result as chaining operator+.
+// ---------------------------------------------------------
+
+template <typename... Parts>
+Text concat(const Parts&... parts) {
+    auto prepared = std::tuple{text_detail::concat_part(parts)...};
+
+    std::size_t total = std::apply([](const auto&... p) {
+        return (std::size_t{0} + ... + text_detail::concat_size(p));
+    }, prepared);
+
+    std::string out;
+    out.reserve(total);
+    std::apply([&out](const auto&... p) {
+        (text_detail::concat_append(out, p), ...);
+    }, prepared);
+    return Text{std::move(out)};
+}
+
 // ---------------------------------------------------------
 // operator+ – Text concatenation with automatic conversion
 //
@@ -287,6 +579,10 @@ inline Text to_text_full(const child_unique_ptr<Parent, T, Deleter>& ptr) {
 //   - Text + any_type  (converts any_type to Text)
 //   - any_type + Text  (converts any_type to Text)
 //
+// A temporary Text on the left is extended in place, so a chain like
+//   a + " " + b + 42 + " items"
+// allocates only when the buffer has to grow (amortized linear).
+//
 // Example:
 //   Text a = "value: ";
 //   auto b = a + 42;        // "value: 42"
@@ -295,21 +591,90 @@ inline Text to_text_full(const child_unique_ptr<Parent, T, Deleter>& ptr) {
 
 // Text + Text
 inline Text operator+(const Text& lhs, const Text& rhs) {
-    return Text{lhs.str() + rhs.str()};
+    std::string out;
+    out.reserve(lhs.size() + rhs.size());
+    out.append(lhs.str()).append(rhs.str());
+    return Text{std::move(out)};
+}
+
+inline Text operator+(Text&& lhs, const Text& rhs) {
+    lhs.str().append(rhs.str());
+    return std::move(lhs);
+}
+
+inline Text operator+(const Text& lhs, Text&& rhs) {
+    rhs.str().insert(0, lhs.str());
+    return std::move(rhs);
+}
+
+inline Text operator+(Text&& lhs, Text&& rhs) {
+    lhs.str().append(rhs.str());
+    return std::move(lhs);
 }
 
 // Text + T (where T is not Text)
-template <typename T,
-          typename = std::enable_if_t<!std::is_same_v<std::decay_t<T>, Text>>>
-inline Text operator+(const Text& lhs, T&& rhs) {
-    return lhs + to_text(std::forward<T>(rhs));
+// The Text side is deduced, never converted, so e.g. "lit" + std::string
+// still resolves to std::operator+.
+template <typename L, typename T>
+    requires (text_detail::is_text_v<L> && !text_detail::is_text_v<T>)
+inline Text operator+(L&& lhs, T&& rhs) {
+    if constexpr (std::is_lvalue_reference_v<L> || std::is_const_v<std::remove_reference_t<L>>) {
+        Text out{lhs};
+        text_detail::append_text(out.str(), rhs);
+        return out;
+    } else {
+        text_detail::append_text(lhs.str(), rhs);
+        return std::move(lhs);
+    }
 }
 
 // T + Text (where T is not Text)
+template <typename T, typename R>
+    requires (!text_detail::is_text_v<T> && text_detail::is_text_v<R>)
+inline Text operator+(T&& lhs, R&& rhs) {
+    if constexpr (std::is_lvalue_reference_v<R> || std::is_const_v<std::remove_reference_t<R>>) {
+        Text out = to_text(std::forward<T>(lhs));
+        out.str().append(rhs.str());
+        return out;
+    } else {
+        rhs.str().insert(0, to_text(std::forward<T>(lhs)).str());
+        return std::move(rhs);
+    }
+}
+
+// TextView + T / T + TextView (T is neither Text nor TextView on the
+// other side of the first overload) – one allocation for the result
+template <typename L, typename T>
+    requires (text_detail::is_text_view_v<L> && !text_detail::is_text_v<T>)
+inline Text operator+(L&& lhs, const T& rhs) {
+    std::string out;
+    out.reserve(lhs.size() + 16);
+    out.append(lhs.view());
+    text_detail::append_text(out, rhs);
+    return Text{std::move(out)};
+}
+
+template <typename T, typename R>
+    requires (!text_detail::is_text_v<T> && !text_detail::is_text_view_v<T> &&
+              text_detail::is_text_view_v<R>)
+inline Text operator+(const T& lhs, R&& rhs) {
+    std::string out;
+    text_detail::append_text(out, lhs);
+    out.append(rhs.view());
+    return Text{std::move(out)};
+}
+
+// operator+= – append in place (for building Text in loops)
+inline Text& operator+=(Text& lhs, const Text& rhs) {
+    lhs.str().append(rhs.str());
+    return lhs;
+}
+
 template <typename T,
           typename = std::enable_if_t<!std::is_same_v<std::decay_t<T>, Text>>>
-inline Text operator+(T&& lhs, const Text& rhs) {
-    return to_text(std::forward<T>(lhs)) + rhs;
+inline Text& operator+=(Text& lhs, const T& rhs) {
+    text_detail::append_text(lhs.str(), rhs);
+    return lhs;
 }
 
 // =========================================================================
@@ -342,7 +707,7 @@ struct ParsedFormat {
 // ===================== Format parser =====================
 
 template <std::size_t N>
-inline ParsedFormat<N> parse_format(const char (&fmt)[N]) {
+constexpr ParsedFormat<N> parse_format(const char (&fmt)[N]) {
     ParsedFormat<N> pf{};
     std::size_t i   = 0;
     std::size_t tok = 0;
@@ -386,14 +751,161 @@ inline ParsedFormat<N> parse_format(const char (&fmt)[N]) {
     return pf;
 }
 
+// ===================== Field rendering =====================
+
+// Append one value the way placeholders render it:
+//   bool → "true"/"false", numbers and StrongNumbers → to_chars (same
+//   text as std::to_string),
+//   strings and Text verbatim, anything else through to_text()
+template <class T>
+void append_field(std::string& out, const T& value) {
+    if constexpr (std::is_same_v<T, bool>) {
+        out.append(value ? "true" : "false");
+    } else if constexpr (chars_writable<T>) {
+        append_chars(out, value);
+    } else if constexpr (std::is_same_v<T, Text>) {
+        out.append(value.str());
+    } else if constexpr (std::is_pointer_v<T> &&
+                         std::is_same_v<std::remove_cv_t<std::remove_pointer_t<T>>, char>) {
+        out.append(value ? value : "<null>");
+    } else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+        out.append(std::string_view(value));
+    } else {
+        out.append(to_text(value).str());
+    }
+}
+
+// ---------------------------------------------------------
+// join / to_text_all – one string for a whole range
+//
+//   pyl::join(std::vector<int>{1, 2, 3}, ", ")   // "1, 2, 3"
+//   pyl::to_text_all(prices)                     // "[1.500000, 2.000000]"
+//
+// Elements render like F() placeholders (append_field). Numbers and
+// StrongNumbers in a sized range take the batch path: the output is
+// sized once from max_chars<T> and every element is written by
+// to_chars straight into it, with no per-element temporaries.
+// Ranges of strings are measured first and reserved exactly.
+// ---------------------------------------------------------
+
+namespace text_detail {
+
+template <class T>
+concept batch_number = chars_writable<T> && !std::is_same_v<T, bool>;
+
+// Widest per-element bound worth reserving in full (floating point
+// bounds run to hundreds of chars; those reserve a typical width)
+inline constexpr std::size_t batch_bound_limit = 64;
+inline constexpr std::size_t batch_typical_width = 16;
+
+template <class R>
+void append_numbers(std::string& out, R&& r, std::string_view sep) {
+    using T = std::ranges::range_value_t<R>;
+    const auto n = static_cast<std::size_t>(std::ranges::size(r));
+    if (n == 0) return;
+
+    if constexpr (max_chars<T> <= batch_bound_limit) {
+        const std::size_t start = out.size();
+        out.resize(start + n * max_chars<T> + (n - 1) * sep.size());
+        char* p = out.data() + start;
+        bool first = true;
+        for (auto&& v : r) {
+            if (!first) {
+                std::memcpy(p, sep.data(), sep.size());
+                p += sep.size();
+            }
+            first = false;
+            p = to_chars(p, p + max_chars<T>, static_cast<const T&>(v));
+        }
+        out.resize(static_cast<std::size_t>(p - out.data()));
+    } else {
+        out.reserve(out.size() + n * (batch_typical_width + sep.size()));
+        bool first = true;
+        for (auto&& v : r) {
+            if (!first) out.append(sep);
+            first = false;
+            append_chars(out, static_cast<const T&>(v));
+        }
+    }
+}
+
+} // namespace text_detail
+
+// Append the elements of `r` to `out`, separated by `sep`
+template <std::ranges::input_range R>
+void append_join(std::string& out, R&& r, std::string_view sep) {
+    using T = std::ranges::range_value_t<R>;
+    if constexpr (std::ranges::sized_range<R> && text_detail::batch_number<T>) {
+        text_detail::append_numbers(out, r, sep);
+    } else {
+        if constexpr (std::ranges::forward_range<R> &&
+                      std::is_convertible_v<std::ranges::range_reference_t<R>, std::string_view>) {
+            std::size_t total = 0, count = 0;
+            for (auto&& v : r) {
+                total += std::string_view(v).size();
+                ++count;
+            }
+            out.reserve(out.size() + total + (count ? count - 1 : 0) * sep.size());
+        }
+        bool first = true;
+        for (auto&& v : r) {
+            if (!first) out.append(sep);
+            first = false;
+            append_field(out, static_cast<const T&>(v));
+        }
+    }
+}
+
+template <std::ranges::input_range R>
+Text join(R&& r, std::string_view sep) {
+    std::string out;
+    append_join(out, std::forward<R>(r), sep);
+    return Text{std::move(out)};
+}
+
+// "[a, b, c]"
+template <std::ranges::input_range R>
+Text to_text_all(R&& r) {
+    std::string out(1, '[');
+    append_join(out, std::forward<R>(r), ", ");
+    out.push_back(']');
+    return Text{std::move(out)};
+}
+
 // ===================== Runtime formatting =====================
 
 using FieldMap = std::unordered_map<std::string, std::any>;
 
+// any_to_string() dispatch: one formatter per dynamic type, looked up by
+// std::type_index in O(1). Arithmetic types, strings and Text are built in;
+// make_field() (and so MAKE_FIELD) registers the type of every value it boxes.
+using any_formatter = void (*)(std::string& out, const std::any& a);
+
 // Implemented in pyl_text.cpp
 void add_field(FieldMap& m, std::string name, std::any value);
+void register_any_formatter(std::type_index type, any_formatter fn);
+void append_any(std::string& out, const std::any& a);   // appends to `out`
 std::string any_to_string(const std::any& a);
 
+template <class T>
+void format_any_as(std::string& out, const std::any& a) {
+    append_field(out, std::any_cast<const T&>(a));
+}
+
+template <class T>
+void register_any_formatter() {
+    register_any_formatter(std::type_index(typeid(T)), &format_any_as<T>);
+}
+
+// ("name", std::any(value)), registering the formatter for value's type
+template <class T>
+std::pair<std::string, std::any> make_field(std::string name, T&& value) {
+    static const bool registered = (register_any_formatter<std::decay_t<T>>(), true);
+    (void)registered;
+    PYL_STATS_INC(any_box);
+    return {std::move(name), std::any(std::forward<T>(value))};
+}
+
 template <class... Pairs>
 FieldMap make_field_map(Pairs&&... pairs) {
     FieldMap m;
@@ -414,7 +926,7 @@ std::string format_with_parsed(const ParsedFormat<N>& pf,
         } else { // Placeholder
             auto it = fields.find(std::string(t.sv));
             if (it != fields.end()) {
-                out += any_to_string(it->second);
+                append_any(out, it->second);
             } else {
                 // keep unknown placeholder as-is
                 out.push_back('{');
@@ -430,14 +942,118 @@ std::string format_with_parsed(const ParsedFormat<N>& pf,
 
 template <std::size_t N>
 void __F(const char (&fmt)[N], const FieldMap& fields) {
+    PYL_STATS_INC(runtime_format);
+    PYL_STATS_SPAN(runtime_format_ns, "pyl::__F");
     // Parse format string
     auto parsed = parse_format(fmt);
 
     // Format using pre-parsed tokens
     auto result = format_with_parsed(parsed, fields);
-    std::cerr << result;
+    current_sink().write(result);
 }
 
+// ===================== Compile-time formatting =====================
+//
+// F() binds every placeholder to an argument index at compile time:
+//   - the format literal and the stringified argument names are passed
+//     as fixed_string template arguments
+//   - parse_format() runs during constant evaluation
+//   - formatting is a fixed series of appends (no FieldMap, no std::any)
+//
+// A placeholder without a matching argument is a compile error.
+// ===================================================================
+
+// String literal usable as a template argument
+template <std::size_t N>
+struct fixed_string {
+    char data[N]{};
+
+    constexpr fixed_string(const char (&s)[N]) {
+        for (std::size_t i = 0; i < N; ++i)
+            data[i] = s[i];
+    }
+
+    constexpr std::size_t size() const noexcept { return N - 1; }
+    constexpr std::string_view view() const noexcept { return {data, N - 1}; }
+};
+
+template <fixed_string Fmt, fixed_string... Names>
+struct compiled_format {
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    static constexpr auto parsed = parse_format(Fmt.data);
+
+    // bindings[i] = argument index for placeholder token i (npos for text)
+    static constexpr auto bindings = [] {
+        constexpr std::array<std::string_view, sizeof...(Names)> names{Names.view()...};
+        std::array<std::size_t, parsed.tokens.size()> b{};
+        for (std::size_t i = 0; i < parsed.count; ++i) {
+            b[i] = npos;
+            if (parsed.tokens[i].kind != TokenKind::Placeholder)
+                continue;
+            for (std::size_t a = 0; a < names.size(); ++a) {
+                if (names[a] == parsed.tokens[i].sv) {
+                    b[i] = a;
+                    break;
+                }
+            }
+        }
+        return b;
+    }();
+
+    static constexpr bool all_bound = [] {
+        for (std::size_t i = 0; i < parsed.count; ++i) {
+            if (parsed.tokens[i].kind == TokenKind::Placeholder && bindings[i] == npos)
+                return false;
+        }
+        return true;
+    }();
+
+    // Total length of literal text, used to reserve the output once
+    static constexpr std::size_t literal_size = [] {
+        std::size_t n = 0;
+        for (std::size_t i = 0; i < parsed.count; ++i) {
+            if (parsed.tokens[i].kind == TokenKind::Text)
+                n += parsed.tokens[i].sv.size();
+        }
+        return n;
+    }();
+
+    template <class... Args>
+    static std::string format(const Args&... args) {
+        static_assert(sizeof...(Args) == sizeof...(Names),
+                      "F: argument count does not match argument names");
+        static_assert(all_bound, "F: placeholder has no matching argument");
+
+        std::string out;
+        out.reserve(literal_size);
+        auto refs = std::forward_as_tuple(args...);
+        append_tokens(out, refs, std::make_index_sequence<parsed.count>{});
+        return out;
+    }
+
+    template <class... Args>
+    static void print(const Args&... args) {
+        current_sink().write(format(args...));
+    }
+
+private:
+    template <class Refs, std::size_t... I>
+    static void append_tokens(std::string& out, const Refs& refs,
+                              std::index_sequence<I...>) {
+        (append_token<I>(out, refs), ...);
+    }
+
+    template <std::size_t I, class Refs>
+    static void append_token(std::string& out, const Refs& refs) {
+        if constexpr (parsed.tokens[I].kind == TokenKind::Text) {
+            out.append(parsed.tokens[I].sv);
+        } else {
+            append_field(out, std::get<bindings[I]>(refs));
+        }
+    }
+};
+
 } // namespace pyl
 
 // ===================== Macro layer: args → ("name", value) =====================
@@ -448,7 +1064,7 @@ void __F(const char (&fmt)[N], const FieldMap& fields) {
 #define EXPAND(x) x
 
 // Map one identifier to ("name", std::any(value))
-#define MAKE_FIELD(x) std::make_pair(std::string(#x), std::any(x))
+#define MAKE_FIELD(x) pyl::make_field(#x, x)
 
 // ---- argument counting up to 8 ----
 #define PP_RSEQ_N() 8,7,6,5,4,3,2,1,0
@@ -474,12 +1090,14 @@ void __F(const char (&fmt)[N], const FieldMap& fields) {
 
 // ===================== Public F macro =====================
 
-// internal helper: build map and call __F
-#define F_IMPL(line, fmt, ...)                                                   \
-    auto CAT(__fmap_, line) = pyl::make_field_map(MAKE_FIELD_ARGS(__VA_ARGS__)); \
-    pyl::__F(fmt, CAT(__fmap_, line))
+// x -> "x" (argument name as a fixed_string template argument)
+#define F_NAME(x) #x
+
+// x, y, z → "x", "y", "z"
+#define F_NAME_ARGS(...) FOR_EACH(F_NAME, __VA_ARGS__)
 
 // Public API:
 //   F("x={x}, y={y}", x, y);
-// (requires at least one variable after fmt)
-#define F(fmt, ...) F_IMPL(__LINE__, fmt, __VA_ARGS__)
+// (requires at least one variable after fmt; fmt must be a string literal)
+#define F(fmt, ...) \
+    pyl::compiled_format<fmt, F_NAME_ARGS(__VA_ARGS__)>::print(__VA_ARGS__)
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace pyl {
+
+// ---------------------------------------------------------
+// type_name<T>() – readable type name, computed at compile time
+//
+//   pyl::type_name<int>()                 // "int"
+//   pyl::type_name<std::vector<Point>>()  // "std::vector<Point>" (spelling
+//                                         //  follows the compiler)
+//
+// The name is cut out of the compiler's pretty function signature, so
+// it is already demangled and lives in static storage: no typeid,
+// no allocation, no per-call work. The exact spelling is compiler
+// specific (GCC writes "long int", Clang "long"); compare against
+// type_name<T>() rather than literals.
+//
+// to_text_full, child_unique_ptr::to_full_string and
+// StrongNumber::to_full_string all take their type names from here.
+// ---------------------------------------------------------
+
+namespace type_name_detail {
+
+template <typename T>
+constexpr std::string_view signature() noexcept {
+#if defined(__clang__) || defined(__GNUC__)
+    return __PRETTY_FUNCTION__;
+#elif defined(_MSC_VER)
+    return __FUNCSIG__;
+#else
+#error "pyl::type_name needs __PRETTY_FUNCTION__ or __FUNCSIG__"
+#endif
+}
+
+// Locate T inside the signature by probing with a known type
+inline constexpr std::string_view probe = signature<int>();
+inline constexpr std::size_t prefix = probe.find("int");
+inline constexpr std::size_t suffix = probe.size() - prefix - 3;
+
+static_assert(prefix != std::string_view::npos, "unrecognized signature format");
+
+} // namespace type_name_detail
+
+template <typename T>
+constexpr std::string_view type_name() noexcept {
+    constexpr std::string_view sig = type_name_detail::signature<T>();
+    return sig.substr(type_name_detail::prefix,
+                      sig.size() - type_name_detail::prefix - type_name_detail::suffix);
+}
+
+// Same text as `os << p` for a non-null pointer ("0x7ffd5c1e2a40")
+inline void append_address(std::string& out, const void* p) {
+    char buf[2 + 2 * sizeof(void*)] = {'0', 'x'};
+    auto v = reinterpret_cast<std::uintptr_t>(p);
+    char* end = std::to_chars(buf + 2, buf + sizeof(buf), v, 16).ptr;
+    out.append(buf, end);
+}
+
+} // namespace pyl
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <cstdint>
+#include <ratio>
+#include <type_traits>
+
+#include "pyl_strong_num.h"
+
+namespace pyl {
+
+// ---------------------------------------------------------
+// Units – compile-time dimension algebra for StrongNumber
+//
+// A unit tag carries a dimension (exponents of the SI base
+// quantities) and a ratio to the coherent SI unit. StrongNumbers
+// tagged with units multiply and divide into new units; the result
+// type is computed entirely by templates.
+//
+//   quantity<meters> d{100.0};
+//   quantity<seconds> t{9.58};
+//   auto v = d / t;                                  // quantity<meters_per_second>
+//   auto kmh = unit_cast<kilometers_per_hour>(v);    // constexpr factor
+//
+// + and - still require the same unit; convert with unit_cast first.
+// ---------------------------------------------------------
+
+template <int Length, int Mass, int Time,
+          int Current = 0, int Temperature = 0, int Amount = 0, int Luminosity = 0>
+struct dimension {
+    static constexpr int length      = Length;
+    static constexpr int mass        = Mass;
+    static constexpr int time        = Time;
+    static constexpr int current     = Current;
+    static constexpr int temperature = Temperature;
+    static constexpr int amount      = Amount;
+    static constexpr int luminosity  = Luminosity;
+};
+
+namespace units_detail {
+
+template <typename A, typename B, int Sign>
+using dim_combine = dimension<
+    A::length      + Sign * B::length,
+    A::mass        + Sign * B::mass,
+    A::time        + Sign * B::time,
+    A::current     + Sign * B::current,
+    A::temperature + Sign * B::temperature,
+    A::amount      + Sign * B::amount,
+    A::luminosity  + Sign * B::luminosity>;
+
+} // namespace units_detail
+
+template <typename A, typename B>
+using dim_multiply = units_detail::dim_combine<A, B, 1>;
+
+template <typename A, typename B>
+using dim_divide = units_detail::dim_combine<A, B, -1>;
+
+// Base and common derived dimensions
+using dimensionless_dim = dimension<0, 0, 0>;
+using length_dim        = dimension<1, 0, 0>;
+using mass_dim          = dimension<0, 1, 0>;
+using time_dim          = dimension<0, 0, 1>;
+using area_dim          = dimension<2, 0, 0>;
+using velocity_dim      = dimension<1, 0, -1>;
+using acceleration_dim  = dimension<1, 0, -2>;
+using force_dim         = dimension<1, 1, -2>;
+
+// unit<Dim, Ratio>: Ratio converts one of this unit to the SI unit.
+// The ratio is reduced, so equal units are the same type.
+template <typename Dim, typename Ratio>
+struct basic_unit {
+    using unit_dimension = Dim;
+    using unit_ratio     = Ratio;
+};
+
+template <typename Dim, typename Ratio = std::ratio<1>>
+using unit = basic_unit<Dim, typename Ratio::type>;
+
+template <typename U1, typename U2>
+using unit_multiply = unit<dim_multiply<typename U1::unit_dimension, typename U2::unit_dimension>,
+                           std::ratio_multiply<typename U1::unit_ratio, typename U2::unit_ratio>>;
+
+template <typename U1, typename U2>
+using unit_divide = unit<dim_divide<typename U1::unit_dimension, typename U2::unit_dimension>,
+                         std::ratio_divide<typename U1::unit_ratio, typename U2::unit_ratio>>;
+
+template <typename U1, typename U2>
+inline constexpr bool same_dimension_v =
+    std::is_same_v<typename U1::unit_dimension, typename U2::unit_dimension>;
+
+// Common units
+using scalar_unit         = unit<dimensionless_dim>;
+using meters              = unit<length_dim>;
+using kilometers          = unit<length_dim, std::kilo>;
+using millimeters         = unit<length_dim, std::milli>;
+using kilograms           = unit<mass_dim>;
+using grams               = unit<mass_dim, std::milli>;
+using seconds             = unit<time_dim>;
+using milliseconds        = unit<time_dim, std::milli>;
+using minutes             = unit<time_dim, std::ratio<60>>;
+using hours               = unit<time_dim, std::ratio<3600>>;
+using square_meters       = unit<area_dim>;
+using meters_per_second   = unit<velocity_dim>;
+using kilometers_per_hour = unit<velocity_dim, std::ratio<1000, 3600>>;
+using meters_per_second2  = unit<acceleration_dim>;
+using newtons             = unit<force_dim>;
+
+// quantity<Unit, T>: StrongNumber tagged with a unit
+template <typename Unit, typename T = double>
+using quantity = StrongNumber<T, Unit>;
+
+// Multiplication / division compose units (any T/U, common result type)
+template <typename T, typename U, typename U1, typename U2>
+    requires (is_unit_tag_v<U1> && is_unit_tag_v<U2>)
+constexpr StrongNumber<std::common_type_t<T, U>, unit_multiply<U1, U2>>
+operator*(const StrongNumber<T, U1>& a, const StrongNumber<U, U2>& b) noexcept {
+    using R = std::common_type_t<T, U>;
+    return StrongNumber<R, unit_multiply<U1, U2>>(
+        static_cast<R>(static_cast<R>(a.value()) * static_cast<R>(b.value())));
+}
+
+template <typename T, typename U, typename U1, typename U2>
+    requires (is_unit_tag_v<U1> && is_unit_tag_v<U2>)
+constexpr StrongNumber<std::common_type_t<T, U>, unit_divide<U1, U2>>
+operator/(const StrongNumber<T, U1>& a, const StrongNumber<U, U2>& b) {
+    using R = std::common_type_t<T, U>;
+    return StrongNumber<R, unit_divide<U1, U2>>(
+        static_cast<R>(static_cast<R>(a.value()) / static_cast<R>(b.value())));
+}
+
+// Convert between units of the same dimension; the factor is a
+// compile-time ratio (integral T: multiply first, then divide)
+template <typename To, typename T, typename From>
+    requires (is_unit_tag_v<From> && is_unit_tag_v<To> && same_dimension_v<From, To>)
+constexpr StrongNumber<T, To> unit_cast(const StrongNumber<T, From>& q) noexcept {
+    using factor = std::ratio_divide<typename From::unit_ratio, typename To::unit_ratio>;
+    if constexpr (std::is_floating_point_v<T>) {
+        constexpr T f = static_cast<T>(factor::num) / static_cast<T>(factor::den);
+        return StrongNumber<T, To>(q.value() * f);
+    } else {
+        return StrongNumber<T, To>(static_cast<T>(
+            static_cast<std::intmax_t>(q.value()) * factor::num / factor::den));
+    }
+}
+
+} // namespace pyl
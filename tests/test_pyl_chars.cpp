@@ -0,0 +1,77 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include "pyl_chars.h"
+
+using namespace pyl;
+
+template <typename T>
+static std::string chars_of(T v) {
+    char buf[max_chars<T>];
+    char* end = pyl::to_chars(buf, buf + sizeof(buf), v);
+    return std::string(buf, end);
+}
+
+TEST_CASE("to_chars matches std::to_string for integers", "[pyl_chars]") {
+    REQUIRE(chars_of(0) == "0");
+    REQUIRE(chars_of(-42) == "-42");
+    REQUIRE(chars_of(std::numeric_limits<std::int64_t>::min()) ==
+            std::to_string(std::numeric_limits<std::int64_t>::min()));
+    REQUIRE(chars_of(std::numeric_limits<std::uint64_t>::max()) ==
+            std::to_string(std::numeric_limits<std::uint64_t>::max()));
+}
+
+TEST_CASE("to_chars matches std::to_string for floating point", "[pyl_chars]") {
+    REQUIRE(chars_of(3.14) == std::to_string(3.14));
+    REQUIRE(chars_of(-2.5f) == std::to_string(-2.5f));
+    REQUIRE(chars_of(std::numeric_limits<double>::max()) ==
+            std::to_string(std::numeric_limits<double>::max()));
+}
+
+TEST_CASE("to_chars renders bool as an integer", "[pyl_chars]") {
+    REQUIRE(chars_of(true) == "1");
+    REQUIRE(chars_of(false) == "0");
+}
+
+TEST_CASE("to_chars returns nullptr when the buffer is too small", "[pyl_chars]") {
+    char buf[2];
+
+    REQUIRE(pyl::to_chars(buf, buf + sizeof(buf), 12345) == nullptr);
+}
+
+TEST_CASE("append_chars appends without clearing", "[pyl_chars]") {
+    std::string out = "n=";
+    append_chars(out, 7);
+    append_chars(out, 0.5);
+
+    REQUIRE(out == "n=70.500000");
+}
+
+TEST_CASE("to_chars formats long double like std::to_string", "[pyl_chars]") {
+    REQUIRE(chars_of(1.25L) == std::to_string(1.25L));
+    REQUIRE(chars_of(-1e20L) == std::to_string(-1e20L));
+}
+
+#ifdef __SIZEOF_INT128__
+TEST_CASE("to_chars formats 128-bit integers", "[pyl_chars]") {
+    using U = chars_detail::uint128_t;
+    using I = chars_detail::int128_t;
+    STATIC_REQUIRE(chars_number<U>);
+    STATIC_REQUIRE(max_chars<I> == 40);
+
+    U umax = ~U{0};
+    REQUIRE(chars_of(umax) == "340282366920938463463374607431768211455");
+    REQUIRE(chars_of(U{0}) == "0");
+    REQUIRE(chars_of(static_cast<U>(std::numeric_limits<std::uint64_t>::max()) + 1) ==
+            "18446744073709551616");
+
+    I imin = static_cast<I>(U{1} << 127);
+    REQUIRE(chars_of(imin) == "-170141183460469231731687303715884105728");
+    REQUIRE(chars_of(static_cast<I>(-42)) == "-42");
+    REQUIRE(chars_of(static_cast<I>(10000000000000000000ULL)) == "10000000000000000000");
+
+    char small[10];
+    REQUIRE(pyl::to_chars(small, small + sizeof(small), umax) == nullptr);
+}
+#endif
@@ -1,4 +1,5 @@
 #include <catch2/catch_test_macros.hpp>
+#include <memory_resource>
 #include "pyl_child_ptr.h"
 #include "pyl_text.h"
 
@@ -21,6 +22,11 @@ struct Node : Backtraceable<Node> {
     bool operator==(const Node& other) const {
         return value == other.value;
     }
+
+    // consistent with operator== (pyl::hash needs one when == is user-defined)
+    std::size_t hash() const {
+        return pyl::hash_int(static_cast<std::uint64_t>(value));
+    }
 };
 
 TEST_CASE("child_unique_ptr basic construction", "[pyl_child_ptr]") {
@@ -128,6 +134,18 @@ TEST_CASE("child_unique_ptr dynamic fields - retrieval", "[pyl_child_ptr]") {
     REQUIRE(alive == true);
 }
 
+TEST_CASE("child_unique_ptr field proxy owns its key", "[pyl_child_ptr]") {
+    Node root(1);
+    root.left.emplace(2);
+
+    std::string prefix = "stat_";
+    auto f = root.left[prefix + "hp"];   // key is a temporary
+    f = 7;
+    REQUIRE(f.exists());
+    REQUIRE(f.as<int>() == 7);
+    REQUIRE(root.left["stat_hp"].as<int>() == 7);
+}
+
 TEST_CASE("child_unique_ptr dynamic fields - exists check", "[pyl_child_ptr]") {
     Node root(1);
     root.left.emplace(2);
@@ -166,6 +184,48 @@ TEST_CASE("child_unique_ptr dynamic functions - field syntax", "[pyl_child_ptr]"
     REQUIRE(result == 30);
 }
 
+TEST_CASE("child_unique_ptr def returns a typed handle", "[pyl_child_ptr]") {
+    Node root(1);
+    root.left.emplace(2);
+
+    auto mul = root.left.def<int, int, int>("mul", [](int a, int b) {
+        return a * b;
+    });
+    REQUIRE(mul);
+    REQUIRE(mul(6, 7) == 42);
+
+    // handles keep the definition they were created from
+    root.left.def<int, int, int>("mul", [](int a, int b) { return a + b; });
+    REQUIRE(mul(6, 7) == 42);
+    REQUIRE(root.left.call<int>("mul", 6, 7) == 13);
+
+    int calls = 0;
+    auto bump = root.left.def<void>("bump", [&calls] { ++calls; });
+    bump();
+    root.left("bump");
+    REQUIRE(calls == 2);
+}
+
+TEST_CASE("child_unique_ptr fn looks up handles by signature", "[pyl_child_ptr]") {
+    Node root(1);
+    root.left.emplace(2);
+
+    root.left.def<std::string, const std::string&>("greet", [](const std::string& who) {
+        return "hi " + who;
+    });
+
+    auto greet = root.left.fn<std::string(const std::string&)>("greet");
+    REQUIRE(greet("bob") == "hi bob");
+
+    REQUIRE_THROWS_AS(root.left.fn<int(int)>("greet"), std::runtime_error);
+    REQUIRE_THROWS_AS(root.left.fn<int(int)>("missing"), std::runtime_error);
+    REQUIRE_THROWS_AS(root.left.call<int>("greet", 1, 2), std::runtime_error);
+
+    fn_handle<int(int)> empty;
+    REQUIRE_FALSE(empty);
+    REQUIRE_THROWS_AS(empty(1), std::runtime_error);
+}
+
 TEST_CASE("child_unique_ptr hash", "[pyl_child_ptr]") {
     Node root(1);
     root.left.emplace(2);
@@ -195,6 +255,7 @@ TEST_CASE("child_unique_ptr not equals", "[pyl_child_ptr]") {
     REQUIRE_FALSE(root.left.equals(root.right));
 }
 
+#ifndef PYL_DISABLE_CYCLE_CHECK
 TEST_CASE("child_unique_ptr cycle prevention", "[pyl_child_ptr]") {
     Node root(1);
     root.left.emplace(2);
@@ -205,6 +266,7 @@ TEST_CASE("child_unique_ptr cycle prevention", "[pyl_child_ptr]") {
     // Cycle should be prevented
     REQUIRE_FALSE(root.left->left);
 }
+#endif
 
 TEST_CASE("child_unique_ptr null pointer to_string", "[pyl_child_ptr]") {
     Node root(1);
@@ -276,3 +338,171 @@ TEST_CASE("make_child_unique_ptr with parent", "[pyl_child_ptr]") {
     REQUIRE(ptr.parent() == &root);
     REQUIRE(ptr->parent == &root);  // Also check the back-pointer directly
 }
+
+namespace {
+
+struct counting_resource : std::pmr::memory_resource {
+    std::size_t allocations = 0;
+    std::size_t deallocations = 0;
+
+    void* do_allocate(std::size_t bytes, std::size_t align) override {
+        ++allocations;
+        return std::pmr::new_delete_resource()->allocate(bytes, align);
+    }
+    void do_deallocate(void* p, std::size_t bytes, std::size_t align) override {
+        ++deallocations;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+    }
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+struct ArenaNode : Backtraceable<ArenaNode> {
+    using child_ptr = child_unique_ptr<ArenaNode, ArenaNode, pmr_deleter<ArenaNode>>;
+
+    static inline int alive = 0;
+
+    int value = 0;
+    child_ptr left{this};
+    child_ptr right{this};
+
+    explicit ArenaNode(int v) : value(v) { ++alive; }
+    ~ArenaNode() { --alive; }
+};
+
+} // namespace
+
+TEST_CASE("make_child_unique_ptr_in allocates from the resource", "[pyl_child_ptr]") {
+    const int before = ArenaNode::alive;
+    counting_resource res;
+    {
+        auto root = make_child_unique_ptr_in<ArenaNode>(res, nullptr, 1);
+        root->left = make_child_unique_ptr_in<ArenaNode>(res, root.get(), 2);
+        root->left->right.emplace(3);  // members inherit the resource
+
+        REQUIRE(res.allocations == 3);
+        REQUIRE(ArenaNode::alive == before + 3);
+        REQUIRE(root->left->parent == root.get());
+        REQUIRE(root->left->right->parent == root->left.get());
+    }
+    REQUIRE(res.deallocations == 3);
+    REQUIRE(ArenaNode::alive == before);
+}
+
+TEST_CASE("pmr child pointers free adopted heap objects with delete", "[pyl_child_ptr]") {
+    const int before = ArenaNode::alive;
+    counting_resource res;
+    {
+        auto root = make_child_unique_ptr_in<ArenaNode>(res, nullptr, 1);
+        root->left.reset(new ArenaNode(2));                       // from new
+        root->right = std::make_unique<ArenaNode>(3);             // from new
+        root->left->left.emplace(4);                              // heap-built parent: no resource
+        REQUIRE(res.allocations == 1);
+        REQUIRE(ArenaNode::alive == before + 4);
+    }
+    REQUIRE(res.deallocations == 1);
+    REQUIRE(ArenaNode::alive == before);
+}
+
+TEST_CASE("full_copy of a pmr child pointer allocates from the same resource", "[pyl_child_ptr]") {
+    struct Leaf { int v = 0; };
+    counting_resource res;
+    {
+        auto p = make_child_unique_ptr_in<Leaf>(res, static_cast<Leaf*>(nullptr), Leaf{5});
+        auto q = p.full_copy();
+        REQUIRE(q->v == 5);
+        REQUIRE(res.allocations == 2);
+    }
+    REQUIRE(res.deallocations == 2);
+}
+
+TEST_CASE("default pmr_deleter falls back to new/delete", "[pyl_child_ptr]") {
+    const int before = ArenaNode::alive;
+    ArenaNode root(1);
+    root.left.emplace(2);
+    REQUIRE(root.left->value == 2);
+    root.left.reset();
+    REQUIRE(ArenaNode::alive == before + 1);
+}
+
+TEST_CASE("child_arena supports bulk release", "[pyl_child_ptr]") {
+    const int before = ArenaNode::alive;
+    child_arena arena(4096);
+    {
+        auto root = make_child_unique_ptr_in<ArenaNode>(arena, nullptr, 1);
+        for (int i = 0; i < 3; ++i) {
+            root->left = make_child_unique_ptr_in<ArenaNode>(arena, root.get(), i);
+        }
+        REQUIRE(root->left->value == 2);
+    }
+    REQUIRE(ArenaNode::alive == before);
+
+    auto root = make_child_unique_ptr_in<ArenaNode>(arena, nullptr, 1);
+    root->left.emplace(2);
+    root.release();   // skip the destructor walk
+    arena.release();  // reclaim everything at once
+    REQUIRE(ArenaNode::alive == before + 2);   // released nodes are never destroyed
+}
+
+namespace {
+
+struct TrackedNode : TrackedBacktraceable<TrackedNode> {
+    using child_ptr = child_unique_ptr<TrackedNode, TrackedNode>;
+
+    int value = 0;
+    child_ptr left{this};
+    child_ptr right{this};
+
+    explicit TrackedNode(int v) : value(v) {}
+};
+
+} // namespace
+
+TEST_CASE("TrackedBacktraceable counts attached children", "[pyl_child_ptr]") {
+    TrackedNode root(1);
+    REQUIRE(root.child_count == 0);
+
+    root.left.emplace(2);
+    root.right.emplace(3);
+    REQUIRE(root.child_count == 2);
+
+    root.left.swap(root.right);
+    REQUIRE(root.child_count == 2);
+
+    root.left->left.swap(root.right);   // move node 2 one level down
+    REQUIRE(root.child_count == 1);
+    REQUIRE(root.left->child_count == 1);
+    REQUIRE(root.left->left->parent == root.left.get());
+
+    delete root.left->left.release();
+    REQUIRE(root.left->child_count == 0);
+
+    root.left.reset();
+    REQUIRE(root.child_count == 0);
+}
+
+TEST_CASE("TrackedBacktraceable builds deep chains and still prevents cycles", "[pyl_child_ptr]") {
+    TrackedNode root(0);
+    TrackedNode* tail = &root;
+    for (int i = 1; i <= 10000; ++i) {
+        tail->left.emplace(i);
+        tail = tail->left.get();
+    }
+    REQUIRE(tail->value == 10000);
+
+#ifndef PYL_DISABLE_CYCLE_CHECK
+    // adopting an ancestor (non-leaf) is refused
+    TrackedNode* mid = root.left.get();
+    tail->left.reset(mid);
+    REQUIRE_FALSE(tail->left);
+    REQUIRE(mid->parent == &root);
+#endif
+
+    // tear down iteratively to keep the destructor recursion shallow
+    while (root.left) {
+        auto next = std::move(root.left->left);
+        root.left = std::move(next);
+    }
+    REQUIRE(root.child_count == 0);
+}
@@ -0,0 +1,92 @@
+#include <catch2/catch_test_macros.hpp>
+#include <map>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+#include "pyl_columns.h"
+
+using namespace pyl;
+
+using price_table = columns<int, double>;
+
+static_assert(PairLikeRange<price_table>);
+static_assert(std::ranges::random_access_range<price_table>);
+static_assert(std::ranges::random_access_range<const price_table>);
+static_assert(std::ranges::sized_range<price_table>);
+static_assert(std::is_same_v<decltype(values(std::declval<price_table&>())), std::span<double>>);
+static_assert(std::is_same_v<decltype(keys(std::declval<const price_table&>())), std::span<const int>>);
+static_assert(std::ranges::contiguous_range<decltype(values(std::declval<price_table&>()))>);
+
+TEST_CASE("columns store keys and values in separate arrays", "[pyl_columns]") {
+    price_table t{{1, 1.5}, {2, 2.5}};
+    t.emplace_back(3, 3.5);
+    t.push_back({4, 4.5});
+
+    REQUIRE(t.size() == 4);
+    REQUIRE(t.key(2) == 3);
+    REQUIRE(t.value(3) == 4.5);
+    REQUIRE(t[1].first == 2);
+    REQUIRE(t[1].second == 2.5);
+
+    auto ks = t.keys();
+    auto vs = t.values();
+    REQUIRE(ks.data() + 1 == &t.key(1));
+    REQUIRE(vs.data() + 3 == &t.value(3));
+    REQUIRE(std::vector<int>(ks.begin(), ks.end()) == std::vector<int>{1, 2, 3, 4});
+
+    t.clear();
+    REQUIRE(t.empty());
+}
+
+TEST_CASE("columns build from any pair-like range", "[pyl_columns]") {
+    std::map<std::string, int> m{{"b", 2}, {"a", 1}, {"c", 3}};
+    columns<std::string, int> c(m);
+    REQUIRE(c.size() == 3);
+    REQUIRE(c.key(0) == "a");
+    REQUIRE(to_vector(values(c)) == std::vector<int>{1, 2, 3});
+
+    columns<std::string, int> copy(c);
+    REQUIRE(copy == c);
+}
+
+TEST_CASE("columns values feed the contiguous sum and reduce kernels", "[pyl_columns]") {
+    columns<long long, long long> c;
+    c.reserve(100'000);
+    for (long long i = 1; i <= 100'000; ++i) c.emplace_back(i, i);
+
+    const long long expected = 100'000LL * 100'001LL / 2;
+    REQUIRE(sum(values(c)) == expected);
+    REQUIRE(sum(par_unseq, values(c)) == expected);
+    REQUIRE(reduce(unseq, keys(c), 0LL, std::plus<>{}) == expected);
+}
+
+TEST_CASE("columns work with the pair forms of IF, MAP and ENUM", "[pyl_columns]") {
+    price_table t{{1, 10.0}, {2, 200.0}, {3, 30.0}, {4, 400.0}};
+
+    auto hot = t | IF(k, v, v > 100.0 && k > 0) | MAP(k, v, std::pair(k, v));
+    REQUIRE(to_vector(hot) == std::vector<std::pair<int, double>>{{2, 200.0}, {4, 400.0}});
+
+    std::vector<std::size_t> idx;
+    for (auto [i, k, v] : t | ENUM(i, k, v)) {
+        if (v > 100.0 && k % 2 == 0) idx.push_back(i);
+    }
+    REQUIRE(idx == std::vector<std::size_t>{1, 3});
+
+    // the proxy's second member refers into the value column
+    for (auto [k, v] : t) v += k;
+    REQUIRE(t.value(0) == 11.0);
+    REQUIRE(t.value(3) == 404.0);
+
+    auto rows = to_vector(t);
+    REQUIRE(rows[1] == std::pair<int, double>{2, 202.0});
+}
+
+TEST_CASE("columns sort_by_key reorders both columns", "[pyl_columns]") {
+    columns<int, std::string> c{{3, "c"}, {1, "a"}, {2, "b"}, {1, "a2"}};
+    c.sort_by_key();
+    REQUIRE(std::vector<int>(c.keys().begin(), c.keys().end()) == std::vector<int>{1, 1, 2, 3});
+    REQUIRE(c.value(0) == "a");
+    REQUIRE(c.value(1) == "a2");
+    REQUIRE(c.value(3) == "c");
+}
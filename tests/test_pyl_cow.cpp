@@ -0,0 +1,150 @@
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+#include "pyl_child_ptr.h"
+#include "pyl_cow.h"
+
+using namespace pyl;
+
+namespace {
+
+struct Config {
+    int limit = 0;
+    std::string name;
+    cow_ptr<Config> left, right;
+
+    Config() = default;
+    Config(int l, std::string n) : limit(l), name(std::move(n)) {}
+};
+
+cow_ptr<Config> sample_config() {
+    auto root = make_cow<Config>(1, std::string("root"));
+    root.write().left = make_cow<Config>(2, std::string("l"));
+    root.write().right = make_cow<Config>(3, std::string("r"));
+    root.write().left.write().right = make_cow<Config>(4, std::string("lr"));
+    return root;
+}
+
+struct CowNode : Backtraceable<CowNode> {
+    using child_ptr = child_unique_ptr<CowNode, CowNode,
+                                       std::default_delete<CowNode>, cow_field_storage<>>;
+    int value = 0;
+    explicit CowNode(int v) : value(v) {}
+    CowNode(const CowNode& o) : Backtraceable<CowNode>(o), value(o.value) {}
+};
+
+} // namespace
+
+static_assert(field_storage<cow_field_storage<>>);
+static_assert(field_storage<cow_field_storage<hash_field_storage>>);
+
+TEST_CASE("cow_ptr copies share until written", "[pyl_cow]") {
+    auto a = make_cow<Config>(1, std::string("a"));
+    auto b = a;
+    REQUIRE(a.shares_with(b));
+    REQUIRE(a.use_count() == 2);
+
+    b.write().limit = 5;
+    REQUIRE_FALSE(a.shares_with(b));
+    REQUIRE(a->limit == 1);
+    REQUIRE(b->limit == 5);
+    REQUIRE(a.use_count() == 1);
+
+    const Config* before = b.get();
+    b.write().limit = 6;                      // unique: no clone
+    REQUIRE(b.get() == before);
+
+    cow_ptr<Config> empty;
+    REQUIRE_FALSE(empty);
+    REQUIRE_THROWS_AS(empty.write(), std::runtime_error);
+    REQUIRE(empty.equals(cow_ptr<Config>{}));
+}
+
+TEST_CASE("cow_ptr snapshots clone only the written path", "[pyl_cow]") {
+    auto live = sample_config();
+    auto snap = live;
+
+    live.write().left.write().right.write().limit = 40;
+
+    REQUIRE(snap->left->right->limit == 4);
+    REQUIRE(live->left->right->limit == 40);
+    REQUIRE_FALSE(live.shares_with(snap));
+    REQUIRE_FALSE(live->left.shares_with(snap->left));
+    REQUIRE(live->right.shares_with(snap->right));   // untouched subtree
+    REQUIRE(live->left->right->name == "lr");
+
+    live.update([](Config& c) { c.name = "root2"; });
+    REQUIRE(snap->name == "root");
+    REQUIRE(live.full_copy().shares_with(live));
+}
+
+TEST_CASE("cow_ptr dynamic fields are shared with copies", "[pyl_cow]") {
+    auto a = make_cow<Config>();
+    a["mode"] = std::string("fast");
+    a["retries"] = 3;
+
+    auto b = a;
+    REQUIRE(b->limit == 0);
+    REQUIRE(b.fields()->shares_with(*a.fields()));
+    REQUIRE(b["mode"].as<std::string>() == "fast");
+
+    b["retries"] = 4;
+    REQUIRE_FALSE(b.fields()->shares_with(*a.fields()));
+    REQUIRE(a["retries"].as<int>() == 3);
+    int r = b["retries"];
+    REQUIRE(r == 4);
+    REQUIRE_FALSE(a["missing"].exists());
+    REQUIRE(a.shares_with(b));                       // node still shared
+}
+
+TEST_CASE("cow_ptr field proxy owns its key", "[pyl_cow]") {
+    auto a = make_cow<Config>();
+    std::string prefix = "opt_";
+    auto f = a[prefix + "level"];
+    f = 2;
+    REQUIRE(f.as<int>() == 2);
+    REQUIRE(a["opt_level"].as<int>() == 2);
+}
+
+TEST_CASE("cow snapshots can be read from many threads", "[pyl_cow]") {
+    auto live = sample_config();
+    std::vector<std::thread> readers;
+    std::vector<int> seen(4, 0);
+    for (int t = 0; t < 4; ++t) {
+        readers.emplace_back([&, t, snap = live] {
+            int sum = 0;
+            for (int i = 0; i < 1000; ++i) {
+                auto local = snap;                   // per-request snapshot
+                sum += local->left->right->limit;
+            }
+            seen[static_cast<std::size_t>(t)] = sum;
+        });
+    }
+    for (int i = 0; i < 100; ++i) live.write().right.write().limit = i;
+    for (auto& r : readers) r.join();
+    REQUIRE(seen == std::vector<int>(4, 4000));
+    REQUIRE(live.use_count() == 1);
+}
+
+TEST_CASE("full_copy carries dynamic fields and functions", "[pyl_cow]") {
+    CowNode::child_ptr root;
+    root.emplace(1);
+    root["name"] = std::string("cfg");
+    root.def<int, int>("inc", [](int x) { return x + 1; });
+
+    auto copy = root.full_copy();
+    REQUIRE(copy->value == 1);
+    REQUIRE(copy.get() != root.get());
+    REQUIRE(copy["name"].as<std::string>() == "cfg");
+    REQUIRE(copy.call<int>("inc", 1) == 2);
+    REQUIRE(copy.fields()->shares_with(*root.fields()));   // O(1) field copy
+
+    copy["name"] = std::string("changed");
+    REQUIRE(root["name"].as<std::string>() == "cfg");
+    REQUIRE_FALSE(copy.fields()->shares_with(*root.fields()));
+
+    child_unique_ptr<CowNode> plain = make_child_unique_ptr<CowNode>(7);
+    plain["k"] = 1;
+    REQUIRE(plain.full_copy()["k"].as<int>() == 1);
+}
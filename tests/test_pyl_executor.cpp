@@ -0,0 +1,161 @@
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <functional>
+#include <numeric>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <mutex>
+#include <vector>
+#include "pyl_executor.h"
+#include "pyl_ranges.h"
+
+using namespace pyl;
+
+TEST_CASE("executor bulk runs every task exactly once", "[pyl_executor]") {
+    executor pool({.threads = 4});
+    REQUIRE(pool.concurrency() == 4);
+    REQUIRE(pool.numa_nodes() >= 1);
+
+    std::vector<std::atomic<int>> hits(10'000);
+    auto task = [&](std::size_t i) { hits[i].fetch_add(1, std::memory_order_relaxed); };
+    pool.bulk(hits.size(), task);
+
+    bool all_once = true;
+    for (auto& h : hits) all_once = all_once && h.load() == 1;
+    REQUIRE(all_once);
+
+    pool.bulk(0, task);   // no-op
+}
+
+TEST_CASE("executor spreads tasks over its threads", "[pyl_executor]") {
+    executor pool({.threads = 3});
+    std::mutex m;
+    std::set<std::thread::id> ids;
+    auto task = [&](std::size_t) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        std::lock_guard<std::mutex> lk(m);
+        ids.insert(std::this_thread::get_id());
+    };
+    pool.bulk(60, task);
+    REQUIRE(ids.size() > 1);
+    REQUIRE(ids.size() <= 3);
+}
+
+TEST_CASE("executor rethrows the first task exception", "[pyl_executor]") {
+    executor pool({.threads = 4});
+    std::atomic<int> ran{0};
+    auto task = [&](std::size_t i) {
+        ran.fetch_add(1);
+        if (i == 7) throw std::runtime_error("boom");
+    };
+    REQUIRE_THROWS_AS(pool.bulk(1000, task), std::runtime_error);
+    REQUIRE(ran.load() >= 1);
+
+    // still usable afterwards
+    std::atomic<int> count{0};
+    auto ok = [&](std::size_t) { count.fetch_add(1); };
+    pool.bulk(100, ok);
+    REQUIRE(count.load() == 100);
+}
+
+TEST_CASE("nested bulk on the same executor runs inline", "[pyl_executor]") {
+    executor pool({.threads = 4});
+    std::atomic<long> total{0};
+    auto inner = [&](std::size_t j) { total.fetch_add(static_cast<long>(j)); };
+    auto outer = [&](std::size_t) { pool.bulk(10, inner); };
+    pool.bulk(50, outer);
+    REQUIRE(total.load() == 50 * 45);
+}
+
+TEST_CASE("nested bulk from the caller's share runs on the caller", "[pyl_executor]") {
+    executor pool({.threads = 4});
+    const auto caller = std::this_thread::get_id();
+    std::atomic<int> caller_outer{0};
+    std::atomic<int> moved{0};   // inner tasks that ran away from the caller
+    // Only the caller's outer tasks nest, and slowly enough that idle
+    // workers would steal from a queued inner bulk
+    auto inner = [&](std::size_t) {
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+        if (std::this_thread::get_id() != caller) moved.fetch_add(1);
+    };
+    auto outer = [&](std::size_t) {
+        if (std::this_thread::get_id() != caller) return;
+        caller_outer.fetch_add(1);
+        pool.bulk(32, inner);
+    };
+    pool.bulk(4, outer);
+    REQUIRE(caller_outer.load() >= 1);
+    REQUIRE(moved.load() == 0);
+}
+
+TEST_CASE("concurrent callers share one executor", "[pyl_executor]") {
+    executor pool({.threads = 4});
+    std::atomic<long> total{0};
+    auto task = [&](std::size_t i) { total.fetch_add(static_cast<long>(i)); };
+
+    std::vector<std::thread> callers;
+    for (int t = 0; t < 4; ++t) {
+        callers.emplace_back([&] { pool.bulk(1000, task); });
+    }
+    for (auto& c : callers) c.join();
+    REQUIRE(total.load() == 4L * (999L * 1000L / 2));
+}
+
+TEST_CASE("parallel_for over indices and ranges", "[pyl_executor]") {
+    std::vector<int> v(5000, 1);
+
+    parallel_for(0, v.size(), [&](std::size_t b, std::size_t e) {
+        for (std::size_t i = b; i < e; ++i) v[i] += static_cast<int>(i);
+    }, 64);
+    REQUIRE(v[0] == 1);
+    REQUIRE(v[4999] == 5000);
+
+    parallel_for(v, [](int& x) { x = -x; });
+    REQUIRE(v[10] == -11);
+
+    // empty and reversed bounds are no-ops
+    parallel_for(5, 5, [](std::size_t, std::size_t) { FAIL("called"); });
+    parallel_for(std::vector<int>{}, [](int) { FAIL("called"); });
+}
+
+TEST_CASE("parallel_reduce folds chunks in order", "[pyl_executor]") {
+    std::vector<long long> v(100'000);
+    std::iota(v.begin(), v.end(), 1);
+
+    REQUIRE(parallel_reduce(v, 0LL, std::plus<>{}) == 100'000LL * 100'001LL / 2);
+    REQUIRE(parallel_reduce(v, 10LL, std::plus<>{}, 333) == 100'000LL * 100'001LL / 2 + 10);
+
+    // non-commutative op: string concatenation keeps element order
+    std::vector<std::string> words{"a", "b", "c", "d", "e", "f", "g"};
+    REQUIRE(parallel_reduce(words, std::string(">"), std::plus<>{}, 2) == ">abcdefg");
+
+    auto count = parallel_reduce(std::size_t{0}, std::size_t{1000}, std::size_t{0},
+        [](std::size_t b, std::size_t e) { return e - b; }, std::plus<>{}, 7);
+    REQUIRE(count == 1000);
+
+    std::vector<int> empty;
+    REQUIRE(parallel_reduce(empty, 42, std::plus<>{}) == 42);
+}
+
+TEST_CASE("set_scheduler redirects pyl::par algorithms", "[pyl_executor]") {
+    struct counting_scheduler final : scheduler {
+        inline_scheduler inner;
+        std::size_t calls = 0;
+        void bulk(std::size_t n, bulk_task task) override {
+            ++calls;
+            inner.bulk(n, task);
+        }
+        std::size_t concurrency() const noexcept override { return 2; }
+    } counting;
+
+    std::vector<long long> v(200'000, 2);
+    {
+        scoped_scheduler guard(counting);
+        REQUIRE(&current_scheduler() == &counting);
+        REQUIRE(sum(par, v) == 400'000);
+        REQUIRE_FALSE(any_of(par, v, [](long long x) { return x != 2; }));
+    }
+    REQUIRE(counting.calls == 2);
+    REQUIRE(&current_scheduler() == &default_executor());
+}
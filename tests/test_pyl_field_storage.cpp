@@ -0,0 +1,180 @@
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+#include "pyl_field_storage.h"
+#include "pyl_child_ptr.h"
+
+using namespace pyl;
+
+static_assert(field_storage<flat_field_storage<>>);
+static_assert(field_storage<hash_field_storage>);
+static_assert(synchronized_field_storage<concurrent_field_storage<>>);
+static_assert(!synchronized_field_storage<flat_field_storage<>>);
+
+TEST_CASE("flat_field_storage keeps entries sorted", "[pyl_field_storage]") {
+    flat_field_storage<4> s;
+
+    s.get_or_insert("b") = 2;
+    s.get_or_insert("a") = 1;
+    s.get_or_insert("c") = 3;
+    s.get_or_insert("a") = 10;
+
+    REQUIRE(s.size() == 3);
+    REQUIRE(std::any_cast<int>(*s.find("a")) == 10);
+    REQUIRE(s.find("missing") == nullptr);
+
+    std::vector<std::string> keys;
+    s.for_each([&](std::string_view k, const std::any&) { keys.emplace_back(k); });
+    REQUIRE(keys == std::vector<std::string>{"a", "b", "c"});
+}
+
+TEST_CASE("flat_field_storage spills past inline capacity", "[pyl_field_storage]") {
+    flat_field_storage<2> s;
+    for (int i = 0; i < 6; ++i) {
+        s.get_or_insert("k" + std::to_string(5 - i)) = i;
+    }
+
+    REQUIRE(s.size() == 6);
+    for (int i = 0; i < 6; ++i) {
+        REQUIRE(std::any_cast<int>(*s.find("k" + std::to_string(5 - i))) == i);
+    }
+
+    REQUIRE(s.erase("k3"));
+    REQUIRE_FALSE(s.erase("k3"));
+    REQUIRE(s.size() == 5);
+
+    flat_field_storage<2> copy = s;
+    flat_field_storage<2> moved = std::move(s);
+    REQUIRE(copy.size() == 5);
+    REQUIRE(moved.size() == 5);
+    REQUIRE(s.empty());
+    REQUIRE(std::any_cast<int>(*moved.find("k0")) == 5);
+
+    moved.clear();
+    REQUIRE(moved.empty());
+    moved.get_or_insert("x") = 1;
+    REQUIRE(moved.size() == 1);
+}
+
+TEST_CASE("flat_field_storage erase inline", "[pyl_field_storage]") {
+    flat_field_storage<4> s;
+    s.get_or_insert("a") = 1;
+    s.get_or_insert("b") = 2;
+    s.get_or_insert("c") = 3;
+
+    REQUIRE(s.erase("b"));
+    REQUIRE(s.size() == 2);
+    REQUIRE(s.find("b") == nullptr);
+    REQUIRE(std::any_cast<int>(*s.find("c")) == 3);
+}
+
+TEST_CASE("hash_field_storage lookups by string_view", "[pyl_field_storage]") {
+    hash_field_storage s;
+    std::string key = "hp";
+
+    s.get_or_insert(key) = 100;
+    REQUIRE(std::any_cast<int>(*s.find(std::string_view(key))) == 100);
+    REQUIRE(s.erase("hp"));
+    REQUIRE(s.empty());
+}
+
+struct HashNode : Backtraceable<HashNode> {
+    using child_ptr = child_unique_ptr<HashNode, HashNode,
+                                       std::default_delete<HashNode>, hash_field_storage>;
+    int value = 0;
+    child_ptr next{this};
+    explicit HashNode(int v) : value(v) {}
+};
+
+TEST_CASE("child_unique_ptr with hash_field_storage", "[pyl_field_storage]") {
+    HashNode root(1);
+    root.next.emplace(2);
+
+    root.next["hp"] = 100;
+    root.next["name"] = std::string("slime");
+
+    int hp = root.next["hp"];
+    REQUIRE(hp == 100);
+    REQUIRE(root.next["name"].as<std::string>() == "slime");
+    REQUIRE(root.next.fields()->size() == 2);
+    REQUIRE(to_text(root.next).str().find("<") != std::string::npos);
+}
+
+TEST_CASE("concurrent_field_storage reads, stores and erases", "[pyl_field_storage]") {
+    concurrent_field_storage<4> s;
+    REQUIRE(s.empty());
+    for (int i = 0; i < 20; ++i) {
+        s.store("k" + std::to_string(i), i);
+    }
+    s.store("k3", 30);
+
+    REQUIRE(s.size() == 20);
+    REQUIRE(s.read("k3", [](const std::any* v) { return std::any_cast<int>(*v); }) == 30);
+    REQUIRE_FALSE(s.read("missing", [](const std::any* v) { return v != nullptr; }));
+
+    REQUIRE(s.erase("k0"));
+    REQUIRE_FALSE(s.erase("k0"));
+    REQUIRE(s.size() == 19);
+
+    int total = 0;
+    s.for_each([&](std::string_view, const std::any& v) { total += std::any_cast<int>(v); });
+    REQUIRE(total == 190 - 3 + 30);
+
+    concurrent_field_storage<4> copy = s;
+    s.clear();
+    REQUIRE(s.empty());
+    REQUIRE(copy.size() == 19);
+    copy.get_or_insert("new") = 1;
+    REQUIRE(std::any_cast<int>(*copy.find("new")) == 1);
+    rcu_synchronize();
+}
+
+struct SharedNode : Backtraceable<SharedNode> {
+    using child_ptr = child_unique_ptr<SharedNode, SharedNode,
+                                       std::default_delete<SharedNode>, concurrent_field_storage<>>;
+    int value = 0;
+    child_ptr next{this};
+    explicit SharedNode(int v) : value(v) {}
+};
+
+TEST_CASE("child_unique_ptr with concurrent_field_storage is shared between threads", "[pyl_field_storage]") {
+    static_assert(SharedNode::child_ptr::concurrent);
+    SharedNode root(1);
+    root.next.emplace(2);
+    root.next.def<int, int>("twice", [](int x) { return 2 * x; });
+
+    // first assignments race on creating the map
+    std::vector<std::thread> writers;
+    for (int t = 0; t < 4; ++t) {
+        writers.emplace_back([&, t] { root.next["w" + std::to_string(t)] = t; });
+    }
+    for (auto& w : writers) w.join();
+    REQUIRE(root.next.fields()->size() == 4);
+
+    std::atomic<bool> stop{false};
+    std::atomic<bool> bad{false};
+    std::atomic<long> reads{0};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t) {
+        readers.emplace_back([&] {
+            while (!stop.load()) {
+                int gen = root.next["gen"].exists() ? root.next["gen"].as<int>() : 0;
+                if (gen < 0 || root.next.call<int>("twice", 21) != 42) bad = true;
+                reads.fetch_add(1);
+            }
+        });
+    }
+    for (int i = 1; i <= 200; ++i) {
+        root.next["gen"] = i;
+        if (i % 50 == 0) root.next.def<int, int>("twice", [](int x) { return x + x; });
+    }
+    while (reads.load() < 100) std::this_thread::yield();
+    stop = true;
+    for (auto& r : readers) r.join();
+
+    REQUIRE_FALSE(bad.load());
+    REQUIRE(root.next["gen"].as<int>() == 200);
+    rcu_synchronize();
+}
@@ -0,0 +1,149 @@
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "pyl_generator.h"
+#include "pyl_ranges.h"
+
+using namespace pyl;
+
+namespace {
+
+generator<int> countdown(int n) {
+    while (n > 0) co_yield n--;
+}
+
+generator<std::string> lines(std::string_view text) {
+    std::string line;
+    for (char c : text) {
+        if (c == '\n') {
+            co_yield line;
+            line.clear();
+        } else {
+            line += c;
+        }
+    }
+    if (!line.empty()) co_yield line;
+}
+
+generator<std::pair<std::string, int>> scores() {
+    co_yield {"ann", 3};
+    co_yield {"bob", 7};
+    co_yield {"cid", 5};
+}
+
+generator<int&> each(std::vector<int>& v) {
+    for (int& x : v) co_yield x;
+}
+
+generator<int> failing() {
+    co_yield 1;
+    throw std::runtime_error("parse error");
+}
+
+} // namespace
+
+static_assert(std::ranges::input_range<generator<int>>);
+static_assert(std::ranges::view<generator<int>>);
+static_assert(!std::ranges::forward_range<generator<int>>);
+static_assert(std::is_same_v<std::ranges::range_reference_t<generator<int>>, const int&>);
+static_assert(std::is_same_v<std::ranges::range_reference_t<generator<int&>>, int&>);
+
+TEST_CASE("generator yields lazily in order", "[pyl_generator]") {
+    std::vector<int> got;
+    for (int x : countdown(4)) got.push_back(x);
+    REQUIRE(got == std::vector<int>{4, 3, 2, 1});
+
+    REQUIRE(to_vector(countdown(0)).empty());
+    REQUIRE(to_vector(lines("a\nbb\n\nccc")) == std::vector<std::string>{"a", "bb", "", "ccc"});
+}
+
+TEST_CASE("generator composes with IF, MAP, ENUM and sum", "[pyl_generator]") {
+    auto squares = countdown(6) | IF(x, x % 2 == 0) | MAP(x, x * x);
+    REQUIRE(to_vector(std::move(squares)) == std::vector<int>{36, 16, 4});
+
+    REQUIRE(sum(countdown(100)) == 5050);
+    REQUIRE(reduce(countdown(4), 1, std::multiplies<>{}) == 24);
+
+    std::vector<std::size_t> idx;
+    std::vector<int> val;
+    for (auto [i, x] : countdown(3) | ENUM(i, x)) {
+        idx.push_back(i);
+        val.push_back(x);
+    }
+    REQUIRE(idx == std::vector<std::size_t>{0, 1, 2});
+    REQUIRE(val == std::vector<int>{3, 2, 1});
+
+    auto names = scores() | IF(k, v, v > 4 && !k.empty()) | MAP(k, v, k + "=" + std::to_string(v));
+    REQUIRE(to_vector(std::move(names)) == std::vector<std::string>{"bob=7", "cid=5"});
+    REQUIRE(to_vector(values(scores())) == std::vector<int>{3, 7, 5});
+}
+
+TEST_CASE("generator<T&> yields references into the source", "[pyl_generator]") {
+    std::vector<int> v{1, 2, 3};
+    for (int& x : each(v)) x *= 10;
+    REQUIRE(v == std::vector<int>{10, 20, 30});
+}
+
+TEST_CASE("generator propagates exceptions from the body", "[pyl_generator]") {
+    auto g = failing();
+    auto it = g.begin();
+    REQUIRE(*it == 1);
+    REQUIRE_THROWS_AS(++it, std::runtime_error);
+    REQUIRE(it == g.end());
+}
+
+TEST_CASE("generator stops early and is movable", "[pyl_generator]") {
+    auto g = countdown(1'000'000);
+    generator<int> h = std::move(g);
+    int seen = 0;
+    for (int x : h) {
+        if (x < 999'998) break;
+        ++seen;
+    }
+    REQUIRE(seen == 3);
+
+    generator<int> empty;
+    REQUIRE(empty.begin() == empty.end());
+}
+
+TEST_CASE("generator frames are recycled per thread", "[pyl_generator]") {
+    auto& pool = *generator_detail::local_frame_pool();
+    { auto g = countdown(2); }
+    std::size_t cached = pool.cached();
+    REQUIRE(cached >= 1);
+
+    for (int i = 0; i < 100; ++i) {
+        REQUIRE(sum(countdown(3)) == 6);
+    }
+    REQUIRE(pool.cached() == cached);   // reused, not grown
+
+    void* a = pool.allocate(100);
+    pool.deallocate(a, 100);
+    REQUIRE(pool.allocate(128) == a);   // same size class
+    pool.deallocate(a, 128);
+}
+
+TEST_CASE("generator frames outlive the thread's frame pool", "[pyl_generator]") {
+    static std::atomic<int> first{0};
+    static std::atomic<int> late_sum{0};
+    struct late_generator {
+        generator<int> g;
+        ~late_generator() {
+            g = generator<int>();   // frees a frame after the pool is gone
+            late_sum = sum(countdown(3));
+        }
+    };
+
+    std::thread([] {
+        thread_local late_generator late;   // constructed before the pool, destroyed after it
+        late.g = countdown(5);
+        first = *late.g.begin();
+    }).join();
+    REQUIRE(first.load() == 5);
+    REQUIRE(late_sum.load() == 6);
+}
@@ -0,0 +1,157 @@
+#include <catch2/catch_test_macros.hpp>
+#include <set>
+#include <string>
+#include <string_view>
+#include "pyl_hash.h"
+#include "pyl_text.h"
+#include "pyl_child_ptr.h"
+
+using namespace pyl;
+
+namespace {
+
+struct Point {
+    int x;
+    int y;
+    bool operator==(const Point&) const = default;
+};
+
+struct Named {
+    std::string name;
+    std::string to_string() const { return name; }
+    bool operator==(const Named&) const = default;
+};
+
+// no equality: hashed by to_string()
+struct Label {
+    std::string text;
+    std::string to_string() const { return text; }
+};
+
+// == ignores `hits`, so neither bytes nor text may be hashed
+struct Cached {
+    int id = 0;
+    int hits = 0;
+    bool operator==(const Cached& o) const { return id == o.id; }
+};
+
+struct Opaque {
+    double d;
+};
+
+struct CountingKey {
+    int id;
+    std::size_t hash() const { return static_cast<std::size_t>(id); }
+    bool equals(const CountingKey& o) const { return id == o.id; }
+};
+
+} // namespace
+
+template <> inline constexpr bool pyl::hash_object_bytes<Point> = true;
+
+static_assert(hashable<Point>);
+static_assert(!hashable<Named>);   // needs hash(): == is user-visible
+static_assert(hashable<Label>);
+static_assert(!hashable<Cached>);
+static_assert(!hashable<Opaque>);
+static_assert(hashable<Text>);
+
+TEST_CASE("hash_bytes depends on every byte and the seed", "[pyl_hash]") {
+    std::set<std::size_t> seen;
+    std::string s(80, 'a');
+    for (std::size_t len = 0; len <= s.size(); ++len) {
+        seen.insert(hash_bytes(s.data(), len));
+    }
+    REQUIRE(seen.size() == s.size() + 1);
+
+    std::string t = s;
+    t[63] = 'b';
+    REQUIRE(hash_string(s) != hash_string(t));
+    REQUIRE(hash_bytes(s.data(), s.size(), 1) != hash_bytes(s.data(), s.size(), 2));
+}
+
+TEST_CASE("string-like pyl types hash by contents", "[pyl_hash]") {
+    Text text = "latency_ms";
+    std::string str = "latency_ms";
+    std::string_view sv = str;
+
+    REQUIRE(text.hash() == hash_string(sv));
+    REQUIRE(TextView(text).hash() == text.hash());
+    REQUIRE(intern("latency_ms").hash() == text.hash());
+    REQUIRE(pyl::hash<std::string>{}(str) == text.hash());
+    REQUIRE(pyl::hash<const char*>{}("latency_ms") == text.hash());
+}
+
+TEST_CASE("pyl::hash covers scalars and plain structs", "[pyl_hash]") {
+    REQUIRE(pyl::hash<int>{}(1) != pyl::hash<int>{}(2));
+    REQUIRE(pyl::hash<double>{}(0.0) == pyl::hash<double>{}(-0.0));
+    REQUIRE(pyl::hash<Point>{}(Point{1, 2}) == pyl::hash<Point>{}(Point{1, 2}));
+    REQUIRE(pyl::hash<Point>{}(Point{1, 2}) != pyl::hash<Point>{}(Point{2, 1}));
+    REQUIRE(pyl::hash<Label>{}(Label{"n"}) == hash_string("n"));
+    REQUIRE(hash_combine(1, 2) != hash_combine(2, 1));
+}
+
+TEST_CASE("flat_map<Text> supports transparent lookup", "[pyl_hash]") {
+    flat_map<Text, int> counts;
+    counts[Text("alpha")] = 1;
+    counts[Text("beta")] = 2;
+
+    REQUIRE(counts.find(std::string_view("alpha"))->second == 1);
+    REQUIRE(counts.find("beta")->second == 2);
+    REQUIRE(counts.find(TextView("beta"))->second == 2);
+    REQUIRE(counts.find(intern("alpha"))->second == 1);
+    REQUIRE(counts.find("gamma") == counts.end());
+    REQUIRE(counts.count(std::string("alpha")) == 1);
+}
+
+TEST_CASE("flat_set accepts ObjInterface keys", "[pyl_hash]") {
+    flat_set<CountingKey> keys;
+    keys.insert(CountingKey{1});
+    keys.insert(CountingKey{1});
+    keys.insert(CountingKey{2});
+    REQUIRE(keys.size() == 2);
+
+    flat_set<InternedText> names;
+    names.insert(intern("a"));
+    names.insert(intern("a"));
+    REQUIRE(names.size() == 1);
+    REQUIRE(names.contains("a"));
+}
+
+TEST_CASE("child_unique_ptr hash no longer formats the pointee", "[pyl_hash]") {
+    struct Node : Backtraceable<Node> {
+        int v = 0;
+        bool operator==(const Node& o) const { return v == o.v; }
+        std::string to_string() const { return std::to_string(v); }
+    };
+    child_unique_ptr<Node> a{nullptr, new Node};
+    child_unique_ptr<Node> b{nullptr, new Node};
+    a->v = 7;
+    b->v = 7;
+
+    // equal by value => equal hashes, independent of address and parent
+    REQUIRE(a.equals(b));
+    REQUIRE(a.hash() == b.hash());
+
+    child_unique_ptr<Opaque> o{nullptr, new Opaque{1.0}};
+    REQUIRE(o.hash() != 0u);
+}
+
+TEST_CASE("child_unique_ptr hash agrees with == for unhashable pointees", "[pyl_hash]") {
+    struct P {
+        std::string name;
+        double w = 0.0;
+        bool operator==(const P&) const = default;
+    };
+    STATIC_REQUIRE_FALSE(hashable<P>);
+
+    child_unique_ptr<P> a{nullptr, new P{"edge", 0.5}};
+    child_unique_ptr<P> b{nullptr, new P{"edge", 0.5}};
+    REQUIRE(a.equals(b));
+    REQUIRE(a.hash() == b.hash());
+
+    // no equality on the pointee: identity for both
+    child_unique_ptr<Opaque> o1{nullptr, new Opaque{1.0}};
+    child_unique_ptr<Opaque> o2{nullptr, new Opaque{1.0}};
+    REQUIRE_FALSE(o1.equals(o2));
+}
@@ -0,0 +1,149 @@
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <string>
+#include <system_error>
+#include <vector>
+#include "pyl_mmap.h"
+#include "pyl_ranges.h"
+
+using namespace pyl;
+
+namespace {
+
+// Temporary file removed at scope exit
+struct temp_file {
+    std::filesystem::path path;
+
+    explicit temp_file(const std::string& contents) {
+        static int counter = 0;
+        path = std::filesystem::temp_directory_path() /
+               ("pyl_mmap_test_" + std::to_string(++counter) + ".tsv");
+        std::ofstream out(path, std::ios::binary);
+        out << contents;
+    }
+    ~temp_file() {
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+    }
+};
+
+} // namespace
+
+static_assert(std::ranges::forward_range<kv_view>);
+static_assert(std::ranges::borrowed_range<kv_view>);
+static_assert(PairLikeRange<kv_view>);
+
+TEST_CASE("mapped_file maps the file contents", "[pyl_mmap]") {
+    temp_file tmp("hello world");
+    mapped_file f(tmp.path.string());
+
+    REQUIRE(f.is_open());
+    REQUIRE(f.bytes() == "hello world");
+    f.advise(access_hint::random);
+    f.advise(3, 4, access_hint::willneed);
+    f.advise(3, SIZE_MAX, access_hint::sequential);   // "to the end"
+
+    mapped_file moved = std::move(f);
+    REQUIRE_FALSE(f.is_open());
+    REQUIRE(moved.size() == 11);
+}
+
+TEST_CASE("mapped_file handles empty and missing files", "[pyl_mmap]") {
+    temp_file tmp("");
+    mapped_file f(tmp.path.string());
+    REQUIRE(f.is_open());
+    REQUIRE(f.empty());
+    REQUIRE(kv_view(f.bytes()).begin() == std::default_sentinel);
+
+    REQUIRE_THROWS_AS(mapped_file("/nonexistent/pyl_mmap_missing.tsv"), std::system_error);
+}
+
+TEST_CASE("kv_view splits lines into key/value views", "[pyl_mmap]") {
+    kv_view kv("a\t1\r\n\nb\t2\nnovalue\nc\tx\ty");
+
+    std::vector<kv_pair> got;
+    for (auto [k, v] : kv) got.emplace_back(k, v);
+
+    REQUIRE(got == std::vector<kv_pair>{{"a", "1"}, {"b", "2"}, {"novalue", ""}, {"c", "x\ty"}});
+}
+
+TEST_CASE("kv_file composes with keys, values, IF and MAP", "[pyl_mmap]") {
+    temp_file tmp("apple\t3\nbanana\t12\ncherry\t7\n");
+    kv_file snap(tmp.path.string());
+
+    auto ks = to_vector(keys(snap));
+    REQUIRE(ks == std::vector<std::string_view>{"apple", "banana", "cherry"});
+
+    auto lens = to_vector(values(snap) | MAP(v, v.size()));
+    REQUIRE(lens == std::vector<std::size_t>{1, 2, 1});
+
+    auto long_values = to_vector(snap | IF(k, v, !k.empty() && v.size() > 1) | MAP(k, v, std::string(k) + "=" + std::string(v)));
+    REQUIRE(long_values == std::vector<std::string>{"banana=12"});
+
+    std::map<std::string, std::string> loaded;
+    for (auto [k, v] : snap.view()) loaded.emplace(k, v);
+    REQUIRE(loaded.size() == 3);
+}
+
+TEST_CASE("kv_view lower_bound and find on sorted data", "[pyl_mmap]") {
+    std::string data;
+    for (int i = 0; i < 1000; ++i) {
+        char key[16];
+        std::snprintf(key, sizeof(key), "k%04d", i * 2);
+        data += key;
+        data += '\t';
+        data += std::to_string(i);
+        data += '\n';
+    }
+    kv_view kv(data);
+
+    REQUIRE(kv.find("k0000") == std::optional<std::string_view>("0"));
+    REQUIRE(kv.find("k1998") == std::optional<std::string_view>("999"));
+    REQUIRE(kv.find("k0500") == std::optional<std::string_view>("250"));
+    REQUIRE_FALSE(kv.find("k0501").has_value());
+    REQUIRE_FALSE(kv.find("zzz").has_value());
+
+    REQUIRE((*kv.lower_bound("k0501")).first == "k0502");
+    REQUIRE((*kv.lower_bound("")).first == "k0000");
+    REQUIRE(kv.lower_bound("l") == kv.end());
+}
+
+TEST_CASE("kv_view lower_bound skips blank lines", "[pyl_mmap]") {
+    kv_view kv("\nb\t1\n\n\n\nd\t2\n\r\n\nf\t3\n\n\n\n\n");
+
+    for (std::string_view key : {"", "a", "b", "c", "d", "e", "f"}) {
+        auto expected = std::ranges::find_if(kv, [&](const kv_pair& e) { return e.first >= key; });
+        REQUIRE(kv.lower_bound(key) == expected);
+    }
+    REQUIRE(kv.find("d") == std::optional<std::string_view>("2"));
+    REQUIRE(kv.find("f") == std::optional<std::string_view>("3"));
+    REQUIRE(kv.lower_bound("g") == kv.end());
+    REQUIRE(kv_view("\n\n\n").lower_bound("a") == kv_view("\n\n\n").end());
+
+    std::string data;
+    for (int i = 0; i < 100; ++i) {
+        data += "k" + std::to_string(100 + i * 2) + "\tv";
+        data.append(static_cast<std::size_t>(i % 7), '\n');
+        data += '\n';
+    }
+    kv_view spaced(data);
+    for (int i = 99; i < 300; ++i) {
+        std::string key = "k" + std::to_string(i);
+        auto expected = std::ranges::find_if(spaced, [&](const kv_pair& e) { return e.first >= key; });
+        REQUIRE(spaced.lower_bound(key) == expected);
+    }
+}
+
+TEST_CASE("keys/values return elements by value for prvalue pairs", "[pyl_ranges]") {
+    std::vector<int> v{1, 2, 3};
+    auto pairs_by_value = v | std::views::transform([](int x) { return std::pair<int, std::string>(x, std::to_string(x)); });
+
+    auto vs = to_vector(values(pairs_by_value));
+    REQUIRE(vs == std::vector<std::string>{"1", "2", "3"});
+    STATIC_REQUIRE(std::is_same_v<std::ranges::range_reference_t<decltype(values(pairs_by_value))>, std::string>);
+}
@@ -0,0 +1,127 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <atomic>
+#include <list>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+#include "pyl_ranges.h"
+
+using namespace pyl;
+
+TEST_CASE("sum with policies matches sequential sum for integers", "[pyl_parallel]") {
+    std::vector<long long> v(200'000);
+    std::iota(v.begin(), v.end(), 1);
+    const long long expected = 200'000LL * 200'001LL / 2;
+
+    REQUIRE(sum(v) == expected);
+    REQUIRE(sum(seq, v) == expected);
+    REQUIRE(sum(unseq, v) == expected);
+    REQUIRE(sum(par, v) == expected);
+    REQUIRE(sum(par_unseq, v) == expected);
+}
+
+TEST_CASE("sum with policies handles small and empty inputs", "[pyl_parallel]") {
+    std::vector<int> empty;
+    std::vector<int> few{1, 2, 3};
+
+    REQUIRE(sum(par, empty) == 0);
+    REQUIRE(sum(par_unseq, few) == 6);
+    REQUIRE(sum(unseq, few) == 6);
+}
+
+TEST_CASE("floating point sum modes", "[pyl_parallel]") {
+    // 1.0 followed by many tiny values: naive summation loses them
+    std::vector<double> v(1'000'001, 1e-16);
+    v[0] = 1.0;
+    const double exact = 1.0 + 1e-10;
+
+    double kahan = sum(par, v, SumMode::Kahan);
+    double pairwise = sum(par_unseq, v, SumMode::Pairwise);
+
+    REQUIRE(std::abs(kahan - exact) < 1e-15);
+    REQUIRE(std::abs(pairwise - exact) < 1e-12);
+    REQUIRE(sum(seq, v, SumMode::Kahan) == kahan);
+}
+
+TEST_CASE("parallel float sums are deterministic", "[pyl_parallel]") {
+    std::vector<float> v(300'000);
+    for (std::size_t i = 0; i < v.size(); ++i) {
+        v[i] = static_cast<float>(i % 97) * 0.1f;
+    }
+
+    float first = sum(par_unseq, v);
+    for (int run = 0; run < 5; ++run) {
+        REQUIRE(sum(par_unseq, v) == first);
+        REQUIRE(sum(par, v, SumMode::Pairwise) == sum(par, v, SumMode::Pairwise));
+    }
+}
+
+TEST_CASE("reduce with policy and custom operation", "[pyl_parallel]") {
+    std::vector<int> v(100'000, 1);
+    v[50'000] = 7;
+
+    int max = reduce(par, v, 0, [](int a, int b) { return a > b ? a : b; });
+    REQUIRE(max == 7);
+
+    REQUIRE(reduce(par_unseq, v, 10) == 100'000 + 6 + 10);
+    REQUIRE(reduce(seq, std::vector<int>{1, 2, 3, 4}, 1, std::multiplies<>{}) == 24);
+}
+
+TEST_CASE("reduce with policy over views and non-random-access ranges", "[pyl_parallel]") {
+    std::vector<int> v(100'000);
+    std::iota(v.begin(), v.end(), 0);
+
+    auto doubled = v | std::views::transform([](int x) { return static_cast<long long>(x) * 2; });
+    REQUIRE(reduce(par, doubled, 0LL) == 99'999LL * 100'000LL);
+
+    std::list<int> l{1, 2, 3};
+    REQUIRE(sum(par, l) == 6);
+
+    std::list<double> ld{0.5, 0.25};
+    REQUIRE(sum(par, ld, SumMode::Kahan) == 0.75);
+}
+
+TEST_CASE("parallel reduce propagates exceptions", "[pyl_parallel]") {
+    std::vector<int> v(200'000, 1);
+    auto op = [](int a, int b) {
+        if (b < 0) throw std::runtime_error("negative");
+        return a + b;
+    };
+    v[150'000] = -1;
+    REQUIRE_THROWS_AS(reduce(par, v, 0, op), std::runtime_error);
+}
+
+TEST_CASE("PANY and PALL match sequential results", "[pyl_parallel]") {
+    std::vector<int> nums(100'000);
+    std::iota(nums.begin(), nums.end(), 0);
+
+    REQUIRE(PANY(nums, x, x == 76'543));
+    REQUIRE_FALSE(PANY(nums, x, x < 0));
+    REQUIRE(PALL(nums, x, x >= 0));
+    REQUIRE_FALSE(PALL(nums, x, x != 99'999));
+    REQUIRE(none_of(par, nums, [](int x) { return x > 100'000; }));
+
+    std::vector<int> empty;
+    REQUIRE_FALSE(PANY(empty, x, x == 0));
+    REQUIRE(PALL(empty, x, x == 0));
+
+    std::list<int> l{1, 2, 3};
+    REQUIRE(any_of(par, l, [](int x) { return x == 2; }));
+    REQUIRE(all_of(seq, l, [](int x) { return x > 0; }));
+}
+
+TEST_CASE("PANY stops workers after the first witness", "[pyl_parallel]") {
+    std::vector<int> nums(1'000'000, 0);
+    nums[10] = 1;
+    std::atomic<std::size_t> evaluated{0};
+
+    bool found = any_of(par, nums, [&](int x) {
+        evaluated.fetch_add(1, std::memory_order_relaxed);
+        return x == 1;
+    });
+
+    REQUIRE(found);
+    // far fewer than all elements are inspected once the flag is set
+    REQUIRE(evaluated.load() < nums.size());
+}
@@ -2,6 +2,8 @@
 #include <vector>
 #include <map>
 #include <string>
+#include <tuple>
+#include <type_traits>
 #include "pyl_ranges.h"
 
 using namespace pyl;
@@ -189,3 +191,207 @@ TEST_CASE("ENUM with map (3-arg version)", "[pyl_ranges]") {
     REQUIRE(std::get<1>(result[0]) == "a");
     REQUIRE(std::get<2>(result[0]) == 10);
 }
+
+namespace {
+
+struct MoveCounter {
+    int value = 0;
+    int* copies = nullptr;
+
+    MoveCounter(int v, int* c) : value(v), copies(c) {}
+    MoveCounter(const MoveCounter& o) : value(o.value), copies(o.copies) { ++*copies; }
+    MoveCounter(MoveCounter&&) noexcept = default;
+    MoveCounter& operator=(const MoveCounter&) = default;
+    MoveCounter& operator=(MoveCounter&&) noexcept = default;
+};
+
+} // namespace
+
+TEST_CASE("to_vector moves from owning rvalue ranges", "[pyl_ranges]") {
+    int copies = 0;
+    std::vector<MoveCounter> src;
+    src.reserve(3);
+    for (int i = 0; i < 3; ++i) src.emplace_back(i, &copies);
+
+    auto copied = to_vector(src);
+    REQUIRE(copies == 3);
+
+    auto moved = to_vector(std::move(src));
+    REQUIRE(copies == 3);
+    REQUIRE(moved.size() == 3);
+    REQUIRE(moved[2].value == 2);
+    REQUIRE(moved.capacity() == 3);
+}
+
+TEST_CASE("to_vector with par fills random-access ranges in order", "[pyl_ranges]") {
+    std::vector<int> nums(100'000);
+    for (std::size_t i = 0; i < nums.size(); ++i) nums[i] = static_cast<int>(i);
+
+    auto squared = to_vector(par, nums | MAP(x, static_cast<long long>(x) * x));
+    REQUIRE(squared.size() == nums.size());
+    REQUIRE(squared[99'999] == 99'999LL * 99'999LL);
+    REQUIRE(squared == to_vector(nums | MAP(x, static_cast<long long>(x) * x)));
+}
+
+TEST_CASE("to_vector with par compacts filtered pipelines", "[pyl_ranges]") {
+    std::vector<int> nums(250'000);
+    for (std::size_t i = 0; i < nums.size(); ++i) nums[i] = static_cast<int>(i);
+
+    auto pipeline = nums | MAP(x, x * 3) | IF(y, y % 2 == 0);
+    auto parallel = to_vector(par, pipeline);
+    auto serial = to_vector(pipeline);
+
+    REQUIRE(parallel.size() == 125'000);
+    REQUIRE(parallel == serial);
+
+    // filter not in last position: sequential fallback, same result
+    auto mapped_after = to_vector(par, nums | IF(x, x % 5 == 0) | MAP(x, x + 1));
+    REQUIRE(mapped_after.size() == 50'000);
+    REQUIRE(mapped_after[1] == 6);
+
+    std::vector<std::string> words{"a", "bb", "ccc"};
+    REQUIRE(to_vector(par, words | IF(w, w.size() > 1)) == std::vector<std::string>{"bb", "ccc"});
+}
+
+TEST_CASE("CHUNK splits contiguous ranges into spans", "[pyl_ranges]") {
+    std::vector<int> nums{1, 2, 3, 4, 5, 6, 7};
+
+    auto blocks = nums | CHUNK(3);
+    static_assert(std::ranges::random_access_range<decltype(blocks)>);
+    static_assert(std::ranges::sized_range<decltype(blocks)>);
+
+    REQUIRE(blocks.size() == 3);
+    REQUIRE(blocks[0].size() == 3);
+    REQUIRE(blocks[2].size() == 1);
+    REQUIRE(blocks[2][0] == 7);
+
+    std::vector<int> sums;
+    for (auto block : blocks) {
+        sums.push_back(sum(block));
+    }
+    REQUIRE(sums == std::vector<int>{6, 15, 7});
+
+    for (auto block : nums | CHUNK(4)) {
+        for (int& x : block) x *= 10;
+    }
+    REQUIRE(nums[6] == 70);
+}
+
+TEST_CASE("BMAP and BIF run block-wise", "[pyl_ranges]") {
+    std::vector<int> nums(1000);
+    for (std::size_t i = 0; i < nums.size(); ++i) nums[i] = static_cast<int>(i);
+
+    auto out = nums | BMAP(x, x * 3) | BIF(y, y % 2 == 0);
+    auto expected = to_vector(nums | MAP(x, x * 3) | IF(y, y % 2 == 0));
+
+    REQUIRE(out == expected);
+    REQUIRE(out.size() == 500);
+
+    std::vector<std::string> words{"a", "bb", "ccc", "dd"};
+    auto longer = words | BIF(w, w.size() == 2);
+    REQUIRE(longer == std::vector<std::string>{"bb", "dd"});
+
+    auto lens = words | BMAP(w, w.size());
+    REQUIRE(lens == std::vector<std::size_t>{1, 2, 3, 2});
+}
+
+TEST_CASE("ENUM keeps stable indices across passes", "[pyl_ranges]") {
+    std::vector<std::string> words{"a", "b", "c"};
+    auto e = words | ENUM(i, w);
+
+    static_assert(std::ranges::random_access_range<decltype(e)>);
+    static_assert(std::ranges::sized_range<decltype(e)>);
+    REQUIRE(e.size() == 3);
+
+    for (int pass = 0; pass < 2; ++pass) {
+        std::size_t expected = 0;
+        for (auto [i, w] : e) {
+            REQUIRE(i == expected++);
+        }
+    }
+
+    REQUIRE(e[2].first == 2);
+    REQUIRE(e[2].second == "c");
+    REQUIRE((*(e.begin() + 1)).first == 1);
+
+    // elements are references into the source
+    for (auto [i, w] : e) w += std::to_string(i);
+    REQUIRE(words[2] == "c2");
+}
+
+TEST_CASE("ENUM feeds parallel reductions", "[pyl_ranges]") {
+    std::vector<int> nums(100'000, 1);
+    auto weighted = nums | ENUM(i, x)
+                  | MAP(p, static_cast<long long>(p.first) * p.second);
+
+    long long expected = 99'999LL * 100'000LL / 2;
+    REQUIRE(reduce(par, weighted, 0LL) == expected);
+    REQUIRE(reduce(weighted, 0LL) == expected);
+}
+
+TEST_CASE("ENUM works with filtered and unbounded ranges", "[pyl_ranges]") {
+    std::vector<int> nums{1, 2, 3, 4};
+    std::vector<std::size_t> idx;
+    for (auto [i, x] : nums | IF(x, x % 2 == 0) | ENUM(i, x)) {
+        idx.push_back(i);
+    }
+    REQUIRE(idx == std::vector<std::size_t>{0, 1});
+
+    auto first = *(std::views::iota(10) | ENUM(i, x)).begin();
+    REQUIRE(first.first == 0);
+    REQUIRE(first.second == 10);
+}
+
+TEST_CASE("ENUM over a non-common range stops at its sentinel", "[pyl_ranges]") {
+    auto small = std::views::iota(5) | std::views::take_while([](int v) { return v < 8; });
+    STATIC_REQUIRE_FALSE(std::ranges::common_range<decltype(small)>);
+
+    std::vector<std::pair<std::size_t, int>> got;
+    for (auto [i, x] : small | ENUM(i, x)) {
+        got.emplace_back(i, x);
+    }
+    REQUIRE(got == std::vector<std::pair<std::size_t, int>>{{0, 5}, {1, 6}, {2, 7}});
+}
+
+TEST_CASE("ENUM materializes copies of a temporary range", "[pyl_ranges]") {
+    auto make_vec = [] { return std::vector<std::string>{"alpha", "beta", "gamma"}; };
+
+    auto pairs = pyl::to_vector(make_vec() | ENUM(i, x));
+    STATIC_REQUIRE(std::is_same_v<decltype(pairs)::value_type, std::pair<std::size_t, std::string>>);
+    REQUIRE(pairs.size() == 3);
+    REQUIRE(pairs[0] == std::pair<std::size_t, std::string>{0, "alpha"});
+    REQUIRE(pairs[2] == std::pair<std::size_t, std::string>{2, "gamma"});
+
+    auto make_map = [] { return std::map<std::string, int>{{"a", 1}, {"b", 2}}; };
+    auto triples = pyl::to_vector(make_map() | ENUM(i, k, v));
+    STATIC_REQUIRE(std::is_same_v<decltype(triples)::value_type, std::tuple<std::size_t, std::string, int>>);
+    REQUIRE(triples.size() == 2);
+    REQUIRE(std::get<1>(triples[1]) == "b");
+    REQUIRE(std::get<2>(triples[1]) == 2);
+}
+
+TEST_CASE("ENUM reverses with correct indices", "[pyl_ranges]") {
+    std::vector<int> nums{1, 2, 3, 4, 5, 6};
+
+    std::vector<std::pair<std::size_t, int>> rev;
+    for (auto [i, x] : nums | ENUM(i, x) | std::views::reverse) {
+        rev.emplace_back(i, x);
+    }
+    REQUIRE(rev == std::vector<std::pair<std::size_t, int>>{{5, 6}, {4, 5}, {3, 4}, {2, 3}, {1, 2}, {0, 1}});
+
+    // a filter is common but not sized: ENUM ends in a sentinel there,
+    // and reverse walks up to it instead of starting from a bogus index
+    auto evens = nums | IF(x, x % 2 == 0) | ENUM(i, x);
+    STATIC_REQUIRE_FALSE(std::ranges::common_range<decltype(evens)>);
+
+    rev.clear();
+    for (auto [i, x] : evens | std::views::reverse) {
+        rev.emplace_back(i, x);
+    }
+    REQUIRE(rev == std::vector<std::pair<std::size_t, int>>{{2, 6}, {1, 4}, {0, 2}});
+
+    auto last = std::ranges::next(evens.begin(), 2);
+    REQUIRE((*last).first == 2);
+    REQUIRE((*last).second == 6);
+    REQUIRE(std::ranges::next(last) == evens.end());
+}
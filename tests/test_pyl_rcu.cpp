@@ -0,0 +1,93 @@
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "pyl_rcu.h"
+
+using namespace pyl;
+
+namespace {
+
+struct tracked {
+    static inline std::atomic<int> alive{0};
+    int value;
+    explicit tracked(int v) : value(v) { ++alive; }
+    tracked(const tracked& o) : value(o.value) { ++alive; }
+    ~tracked() { --alive; }
+};
+
+} // namespace
+
+TEST_CASE("rcu_ptr retires replaced objects after readers leave", "[pyl_rcu]") {
+    rcu_synchronize();
+    const int base = tracked::alive.load();
+    {
+        rcu_ptr<const tracked> p(new tracked(1));
+        {
+            rcu_read_guard g;
+            const tracked* old = p.load();
+            p.store(new tracked(2));
+            REQUIRE(old->value == 1);           // still readable inside the section
+            REQUIRE(p.load()->value == 2);
+            REQUIRE(tracked::alive.load() == base + 2);
+        }
+        rcu_synchronize();
+        REQUIRE(tracked::alive.load() == base + 1);
+    }
+    REQUIRE(tracked::alive.load() == base);
+}
+
+TEST_CASE("rcu read sections nest", "[pyl_rcu]") {
+    rcu_ptr<int> p(new int(5));
+    rcu_read_guard outer;
+    {
+        rcu_read_guard inner;
+        REQUIRE(*p.load() == 5);
+    }
+    REQUIRE(*p.load() == 5);
+}
+
+TEST_CASE("rcu_ptr publish_if_null installs only once", "[pyl_rcu]") {
+    rcu_ptr<int> p;
+    REQUIRE_FALSE(p);
+    auto a = std::make_unique<int>(1);
+    auto b = std::make_unique<int>(2);
+    REQUIRE(p.publish_if_null(a.get()));
+    a.release();
+    REQUIRE_FALSE(p.publish_if_null(b.get()));
+    REQUIRE(*p.load() == 1);
+
+    rcu_ptr<int> q = std::move(p);
+    REQUIRE_FALSE(p);
+    REQUIRE(*q.load() == 1);
+}
+
+TEST_CASE("rcu_ptr readers see whole versions while a writer updates", "[pyl_rcu]") {
+    struct pair_value { long a, b; };
+    rcu_ptr<const pair_value> p(new pair_value{0, 0});
+
+    std::atomic<bool> stop{false};
+    std::atomic<bool> torn{false};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t) {
+        readers.emplace_back([&] {
+            while (!stop.load(std::memory_order_relaxed)) {
+                rcu_read_guard g;
+                const pair_value* v = p.load();
+                if (v->a != v->b) torn = true;
+            }
+        });
+    }
+    for (long i = 1; i <= 2000; ++i) {
+        auto lk = rcu_writer_lock(&p);
+        p.store(new pair_value{i, i});
+    }
+    stop = true;
+    for (auto& r : readers) r.join();
+
+    REQUIRE_FALSE(torn.load());
+    REQUIRE(p.load()->a == 2000);
+    rcu_synchronize();
+    REQUIRE(rcu_pending() == 0);
+}
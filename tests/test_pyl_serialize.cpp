@@ -0,0 +1,255 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cstdio>
+#include <fstream>
+#include <memory_resource>
+#include <string>
+#include <vector>
+#include "pyl_mmap.h"
+#include "pyl_serialize.h"
+
+using namespace pyl;
+
+namespace {
+
+struct SNode : Backtraceable<SNode> {
+    using child_ptr = child_unique_ptr<SNode, SNode>;
+
+    int value = 0;
+    std::string label;
+    child_ptr left{this};
+    child_ptr right{this};
+
+    SNode(int v, std::string l) : value(v), label(std::move(l)) {}
+
+    explicit SNode(byte_reader& r) : value(r.read<int>()), label(r.read_string()) {}
+    void save(byte_writer& w) const {
+        w.write(value);
+        w.write_string(label);
+    }
+    template <class F> void visit_children(F&& f) { f(left); f(right); }
+    template <class F> void visit_children(F&& f) const { f(left); f(right); }
+};
+
+struct ANode : Backtraceable<ANode> {
+    using child_ptr = child_unique_ptr<ANode, ANode, pmr_deleter<ANode>>;
+
+    double weight = 0;
+    std::vector<child_ptr> kids;
+
+    explicit ANode(double w) : weight(w) {}
+    explicit ANode(byte_reader& r) : weight(r.read<double>()) {
+        auto n = r.read<std::uint32_t>();
+        for (std::uint32_t i = 0; i < n; ++i) kids.emplace_back(this);
+    }
+    void save(byte_writer& w) const {
+        w.write(weight);
+        w.write(static_cast<std::uint32_t>(kids.size()));   // slot count
+    }
+    template <class F> void visit_children(F&& f) { for (auto& k : kids) f(k); }
+    template <class F> void visit_children(F&& f) const { for (const auto& k : kids) f(k); }
+};
+
+struct Point {
+    int x = 0, y = 0;
+    Point(int a, int b) : x(a), y(b) {}
+    explicit Point(byte_reader& r) : x(r.read<int>()), y(r.read<int>()) {}
+    void save(byte_writer& w) const { w.write(x); w.write(y); }
+};
+
+enum class Color : std::uint8_t { red, green };
+
+SNode::child_ptr sample_tree() {
+    auto root = make_child_unique_ptr<SNode>(1, std::string("root"));
+    root->left = make_child_unique_ptr<SNode>(root.get(), 2, std::string("l"));
+    root->right = make_child_unique_ptr<SNode>(root.get(), 3, std::string("r"));
+    root->left->right.emplace(4, std::string("lr"));
+    root["name"] = std::string("config");
+    root["depth"] = 3;
+    root->left->right["ratio"] = 0.25;
+    return root;
+}
+
+} // namespace
+
+static_assert(serializable_node<SNode>);
+static_assert(serializable_node<ANode>);
+
+TEST_CASE("save_tree / load_tree round-trips structure, payloads and fields", "[pyl_serialize]") {
+    auto root = sample_tree();
+    auto bytes = save_tree(root);
+
+    auto copy = load_tree<SNode::child_ptr>(bytes);
+    REQUIRE(copy);
+    REQUIRE(copy->value == 1);
+    REQUIRE(copy->label == "root");
+    REQUIRE(copy->left->value == 2);
+    REQUIRE(copy->right->label == "r");
+    REQUIRE_FALSE(copy->right->left);
+    REQUIRE(copy->left->right->value == 4);
+
+    // parent links are rebuilt
+    REQUIRE(copy->left->parent == copy.get());
+    REQUIRE(copy->left->right->parent == copy->left.get());
+
+    REQUIRE(copy["name"].as<std::string>() == "config");
+    REQUIRE(copy["depth"].as<int>() == 3);
+    REQUIRE(copy->left->right["ratio"].as<double>() == 0.25);
+    REQUIRE_FALSE(copy->left.fields());
+}
+
+TEST_CASE("tree_image reads nodes and fields in place", "[pyl_serialize]") {
+    auto bytes = save_tree(sample_tree());
+    tree_image img(bytes);
+
+    REQUIRE(img.size() == 4);
+    auto root = img.root();
+    REQUIRE_FALSE(root.has_parent());
+    REQUIRE(root.payload().read<int>() == 1);
+    REQUIRE(root.field_count() == 2);
+
+    auto name = root.field<std::string_view>("name");
+    REQUIRE(name == std::optional<std::string_view>("config"));
+    REQUIRE(name->data() >= reinterpret_cast<const char*>(bytes.data()));   // points into the image
+    REQUIRE(root.field<int>("depth") == 3);
+    REQUIRE_FALSE(root.field<int>("missing"));
+    REQUIRE_THROWS_AS(root.field<double>("depth"), serialize_error);
+
+    std::vector<int> child_values;
+    std::vector<std::size_t> slots;
+    for (auto c : root.children()) {
+        child_values.push_back(c.payload().read<int>());
+        slots.push_back(c.slot());
+        REQUIRE(c.parent().index() == 0);
+    }
+    REQUIRE(child_values == std::vector<int>{2, 3});
+    REQUIRE(slots == std::vector<std::size_t>{0, 1});
+
+    auto left = *root.children().begin();
+    auto lr = *left.children().begin();
+    REQUIRE(lr.slot() == 1);
+    auto label = lr.payload();
+    label.read<int>();
+    REQUIRE(label.read_string_view() == "lr");
+}
+
+TEST_CASE("null roots and empty images", "[pyl_serialize]") {
+    SNode::child_ptr empty;
+    auto bytes = save_tree(empty);
+    REQUIRE(bytes.size() == tree_image::header_size);
+    REQUIRE(tree_image(std::span<const std::byte>(bytes)).empty());
+    REQUIRE_FALSE(load_tree<SNode::child_ptr>(bytes));
+}
+
+TEST_CASE("tree_image rejects malformed input", "[pyl_serialize]") {
+    auto bytes = save_tree(sample_tree());
+
+    REQUIRE_THROWS_AS(tree_image(std::span<const std::byte>(bytes.data(), 10)), serialize_error);
+
+    auto truncated = bytes;
+    truncated.resize(bytes.size() - 3);
+    REQUIRE_THROWS_AS(tree_image(std::span<const std::byte>(truncated)), serialize_error);
+
+    auto bad_magic = bytes;
+    bad_magic[0] = std::byte{'X'};
+    REQUIRE_THROWS_AS(tree_image(std::span<const std::byte>(bad_magic)), serialize_error);
+
+    auto bad_parent = bytes;   // node 1's parent -> itself
+    serialize_detail::store(bad_parent.data() + tree_image::header_size + tree_image::node_record,
+                            std::uint32_t{1});
+    REQUIRE_THROWS_AS(tree_image(std::span<const std::byte>(bad_parent)), serialize_error);
+}
+
+TEST_CASE("tree_image rejects duplicate slots and inconsistent links", "[pyl_serialize]") {
+    // pre-order: 0 root, 1 root.left, 2 root.left.right, 3 root.right
+    auto bytes = save_tree(sample_tree());
+    auto record = [](std::vector<std::byte>& b, std::size_t i, std::size_t field) {
+        return b.data() + tree_image::header_size + i * tree_image::node_record + field;
+    };
+    constexpr std::size_t first_child = 4, slot = 12;
+    tree_image img(bytes);
+    REQUIRE(img.size() == 4);
+    REQUIRE((img.node(3).parent().index() == 0 && img.node(3).slot() == 1));
+    REQUIRE((img.node(2).parent().index() == 1 && img.node(2).slot() == 1));
+
+    auto dup_slot = bytes;   // root.right claims root.left's slot
+    serialize_detail::store(record(dup_slot, 3, slot), std::uint32_t{0});
+    REQUIRE_THROWS_AS(tree_image(std::span<const std::byte>(dup_slot)), serialize_error);
+    REQUIRE_THROWS_AS(load_tree<SNode::child_ptr>(std::span<const std::byte>(dup_slot)), serialize_error);
+
+    auto unlinked = bytes;   // root's child list skips root.left
+    serialize_detail::store(record(unlinked, 0, first_child), std::uint32_t{3});
+    REQUIRE_THROWS_AS(tree_image(std::span<const std::byte>(unlinked)), serialize_error);
+
+    auto wrong_parent = bytes;   // root.left.right listed under root.left, parent says root
+    serialize_detail::store(record(wrong_parent, 2, 0), std::uint32_t{0});
+    REQUIRE_THROWS_AS(tree_image(std::span<const std::byte>(wrong_parent)), serialize_error);
+
+    REQUIRE_NOTHROW(tree_image(std::span<const std::byte>(bytes)));
+}
+
+TEST_CASE("load_tree into an arena with variable child slots", "[pyl_serialize]") {
+    auto root = make_child_unique_ptr_in<ANode>(*std::pmr::new_delete_resource(), nullptr, 1.0);
+    root->kids.emplace_back(root.get());
+    root->kids.emplace_back(root.get());
+    root->kids.emplace_back(root.get());
+    root->kids[0].emplace(2.0);
+    root->kids[2].emplace(3.0);
+    root->kids[2]->kids.emplace_back(root->kids[2].get());
+    root->kids[2]->kids[0].emplace(4.0);
+
+    auto bytes = save_tree(root);
+
+    child_arena arena;
+    auto copy = load_tree<ANode::child_ptr>(bytes, arena);
+    REQUIRE(copy.get_deleter().resource == &arena);
+    REQUIRE(copy->kids.size() == 3);
+    REQUIRE(copy->kids[0]->weight == 2.0);
+    REQUIRE_FALSE(copy->kids[1]);
+    REQUIRE(copy->kids[2]->kids[0]->weight == 4.0);
+    REQUIRE(copy->kids[2]->kids[0].get_deleter().resource == &arena);
+}
+
+TEST_CASE("registered codecs carry user types in dynamic fields", "[pyl_serialize]") {
+    register_field_codec<Point>("test.Point");
+    register_field_codec<Color>("test.Color");
+
+    auto root = make_child_unique_ptr<SNode>(0, std::string());
+    root["origin"] = Point(3, 4);
+    root["color"] = Color::green;
+    struct Opaque {};
+    root["opaque"] = Opaque{};
+    REQUIRE_THROWS_AS(save_tree(root), serialize_error);
+
+    auto ok = make_child_unique_ptr<SNode>(0, std::string());
+    ok["origin"] = Point(3, 4);
+    ok["color"] = Color::green;
+    auto bytes = save_tree(ok);
+
+    auto copy = load_tree<SNode::child_ptr>(bytes);
+    Point p = copy["origin"].as<Point>();
+    REQUIRE(p.x == 3);
+    REQUIRE(p.y == 4);
+    REQUIRE(copy["color"].as<Color>() == Color::green);
+
+    tree_image img(bytes);
+    REQUIRE(img.root().field<Point>("origin")->y == 4);
+    REQUIRE(img.root().field<Color>("color") == Color::green);
+}
+
+TEST_CASE("tree_image over a memory-mapped file", "[pyl_serialize]") {
+    auto bytes = save_tree(sample_tree());
+    std::string path = "pyl_serialize_test.bin";
+    {
+        std::ofstream out(path, std::ios::binary);
+        out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    }
+    {
+        mapped_file f(path, access_hint::random);
+        tree_image img(f.bytes());
+        REQUIRE(img.size() == 4);
+        REQUIRE(img.root().field<std::string_view>("name") == std::optional<std::string_view>("config"));
+        auto copy = load_tree<SNode::child_ptr>(img);
+        REQUIRE(copy->left->right->label == "lr");
+    }
+    std::remove(path.c_str());
+}
@@ -0,0 +1,190 @@
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "pyl_sink.h"
+#include "pyl_text.h"
+
+using namespace pyl;
+
+// Collects everything written to it
+struct CaptureSink : Sink {
+    std::mutex m;
+    std::string out;
+    int flushes = 0;
+
+    void write(std::string_view s) override {
+        std::lock_guard<std::mutex> lk(m);
+        out.append(s);
+    }
+    void flush() override {
+        std::lock_guard<std::mutex> lk(m);
+        ++flushes;
+    }
+};
+
+// Installs a sink for the duration of a test
+struct ScopedSink {
+    Sink* previous;
+    explicit ScopedSink(Sink* s) : previous(set_sink(s)) {}
+    ~ScopedSink() { set_sink(previous); }
+};
+
+TEST_CASE("current_sink defaults to stderr", "[pyl_sink]") {
+    REQUIRE(dynamic_cast<StderrSink*>(&current_sink()) != nullptr);
+}
+
+TEST_CASE("set_sink redirects F output", "[pyl_sink]") {
+    CaptureSink capture;
+    {
+        ScopedSink scoped(&capture);
+        int x = 42;
+        std::string name = "Alice";
+        F("x={x}, name={name}\n", x, name);
+    }
+
+    REQUIRE(capture.out == "x=42, name=Alice\n");
+    REQUIRE(dynamic_cast<StderrSink*>(&current_sink()) != nullptr);
+}
+
+TEST_CASE("set_sink redirects __F output", "[pyl_sink]") {
+    CaptureSink capture;
+    ScopedSink scoped(&capture);
+
+    FieldMap fields;
+    add_field(fields, "y", std::any(7));
+    pyl::__F("y={y}", fields);
+
+    REQUIRE(capture.out == "y=7");
+}
+
+TEST_CASE("AsyncSink delivers buffered text on flush", "[pyl_sink]") {
+    CaptureSink capture;
+    AsyncSink async(capture);
+
+    async.write("hello ");
+    async.write("world");
+    async.flush();
+
+    REQUIRE(capture.out == "hello world");
+    REQUIRE(capture.flushes >= 1);
+}
+
+TEST_CASE("AsyncSink hands off full thread buffers", "[pyl_sink]") {
+    CaptureSink capture;
+    AsyncSinkOptions opts;
+    opts.thread_buffer_bytes = 8;
+    opts.ring_capacity = 2;
+    AsyncSink async(capture, opts);
+
+    for (int i = 0; i < 100; ++i) {
+        async.write("0123456789");
+    }
+    async.flush();
+
+    REQUIRE(capture.out.size() == 1000);
+    REQUIRE(async.dropped() == 0);
+}
+
+TEST_CASE("AsyncSink flushes idle thread buffers by time", "[pyl_sink]") {
+    CaptureSink capture;
+    AsyncSinkOptions opts;
+    opts.flush_interval = std::chrono::milliseconds(5);
+    AsyncSink async(capture, opts);
+
+    async.write("idle");
+
+    std::string seen;
+    for (int i = 0; i < 400 && seen.empty(); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        std::lock_guard<std::mutex> lk(capture.m);
+        seen = capture.out;
+    }
+
+    REQUIRE(seen == "idle");
+}
+
+TEST_CASE("AsyncSink keeps lines from many threads intact", "[pyl_sink]") {
+    CaptureSink capture;
+    {
+        AsyncSinkOptions opts;
+        opts.thread_buffer_bytes = 64;
+        AsyncSink async(capture, opts);
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&async, t] {
+                for (int i = 0; i < 250; ++i) {
+                    async.write("thread " + std::to_string(t) + "\n");
+                }
+            });
+        }
+        for (auto& th : threads) th.join();
+    }  // destructor drains everything
+
+    REQUIRE(std::count(capture.out.begin(), capture.out.end(), '\n') == 1000);
+    for (int t = 0; t < 4; ++t) {
+        std::string line = "thread " + std::to_string(t) + "\n";
+        std::size_t n = 0;
+        for (auto pos = capture.out.find(line); pos != std::string::npos;
+             pos = capture.out.find(line, pos + 1)) {
+            ++n;
+        }
+        REQUIRE(n == 250);
+    }
+}
+
+TEST_CASE("AsyncSink keeps each thread's lines in order under forced sweeps", "[pyl_sink]") {
+    CaptureSink capture;
+    {
+        AsyncSinkOptions opts;
+        opts.thread_buffer_bytes = 32;
+        AsyncSink async(capture, opts);
+
+        std::atomic<bool> done{false};
+        std::thread flusher([&] {
+            while (!done.load()) async.flush();   // forces sweeps mid-stream
+        });
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&async, t] {
+                for (int i = 0; i < 500; ++i) {
+                    async.write(std::to_string(t) + ":" + std::to_string(i) + "\n");
+                }
+            });
+        }
+        for (auto& th : threads) th.join();
+        done = true;
+        flusher.join();
+    }
+
+    std::vector<int> next(4, 0);
+    std::size_t start = 0;
+    bool ordered = true;
+    for (auto nl = capture.out.find('\n'); nl != std::string::npos; nl = capture.out.find('\n', start)) {
+        std::string line = capture.out.substr(start, nl - start);
+        start = nl + 1;
+        auto colon = line.find(':');
+        int t = std::stoi(line.substr(0, colon));
+        int i = std::stoi(line.substr(colon + 1));
+        if (i != next[static_cast<std::size_t>(t)]++) ordered = false;
+    }
+    REQUIRE(ordered);
+    REQUIRE(next == std::vector<int>(4, 500));
+}
+
+TEST_CASE("AsyncSink as the F sink", "[pyl_sink]") {
+    CaptureSink capture;
+    AsyncSink async(capture);
+    {
+        ScopedSink scoped(&async);
+        int n = 3;
+        F("n={n}\n", n);
+        async.flush();
+    }
+
+    REQUIRE(capture.out == "n=3\n");
+}
@@ -0,0 +1,143 @@
+#include <catch2/catch_test_macros.hpp>
+#include <bit>
+#include <sstream>
+#include <string>
+#include <thread>
+#include "pyl_child_ptr.h"
+#include "pyl_stats.h"
+#include "pyl_text.h"
+
+using namespace pyl;
+
+namespace {
+
+struct StatsNode : TrackedBacktraceable<StatsNode> {
+    using child_ptr = child_unique_ptr<StatsNode>;
+    child_ptr child{this};
+};
+
+struct Unprintable {
+    int x = 0;
+    double y = 0;   // padding-free layout not guaranteed: no byte hash
+    std::string to_string() const { return "u"; }
+};
+
+struct Opaque { int x = 0; };
+
+struct StatsSink : Sink {
+    std::string out;
+    void write(std::string_view s) override { out.append(s); }
+};
+
+std::uint64_t delta(const stats_snapshot& before, stat_counter c) {
+    return stats().counter(c) - before.counter(c);
+}
+
+} // namespace
+
+TEST_CASE("stats snapshot reports whether instrumentation is compiled in", "[pyl_stats]") {
+    auto s = stats();
+    REQUIRE(s.enabled == stats_enabled);
+    if constexpr (!stats_enabled) {
+        PYL_STATS_INC(any_box);                       // expands to nothing
+        REQUIRE(stats().counter(stat_counter::any_box) == 0);
+        REQUIRE_FALSE(tracing());
+    }
+
+    std::ostringstream json;
+    s.write_json(json);
+    REQUIRE(json.str().find("\"cycle_walk_depth\"") != std::string::npos);
+    REQUIRE(stat_name(stat_counter::hash_to_string) == "hash_to_string");
+}
+
+TEST_CASE("histogram percentiles use log2 buckets", "[pyl_stats]") {
+    histogram_snapshot h;
+    for (std::uint64_t v : {1u, 2u, 3u, 100u}) {
+        ++h.count;
+        h.sum += v;
+        ++h.buckets[static_cast<std::size_t>(std::bit_width(v))];
+    }
+    h.min = 1;
+    h.max = 100;
+    REQUIRE(h.percentile(0.25) == 1);
+    REQUIRE(h.percentile(0.5) == 3);
+    REQUIRE(h.percentile(1.0) == 100);    // bucket bound clamped to max
+    REQUIRE(h.mean() == 26.5);
+}
+
+TEST_CASE("stats count the expensive fallback paths", "[pyl_stats]") {
+    if constexpr (!stats_enabled) return;
+
+    auto before = stats();
+
+    (void)pyl::hash<Unprintable>{}(Unprintable{});
+    REQUIRE(delta(before, stat_counter::hash_to_string) == 1);
+
+    (void)to_text(Opaque{});
+    REQUIRE(delta(before, stat_counter::to_text_typeid) == 1);
+
+    StatsSink sink;
+    Sink* previous = set_sink(&sink);
+    int x = 1;
+    __F("x={x} {y}\n", make_field_map(MAKE_FIELD(x), make_field("y", Opaque{})));
+    set_sink(previous);
+    REQUIRE(sink.out.rfind("x=1 <", 0) == 0);
+    REQUIRE(delta(before, stat_counter::to_text_typeid) == 2);   // Opaque again, via its formatter
+    REQUIRE(delta(before, stat_counter::runtime_format) == 1);
+    REQUIRE(delta(before, stat_counter::any_box) == 2);
+    REQUIRE(delta(before, stat_counter::any_format) == 2);
+    REQUIRE(stats().histogram(stat_histogram::runtime_format_ns).count >=
+            before.histogram(stat_histogram::runtime_format_ns).count + 1);
+
+    StatsNode root;
+    root.child.emplace();
+    root.child->child.emplace();
+    auto depth_before = stats().histogram(stat_histogram::cycle_walk_depth);
+    root.child->child->child.emplace();               // new leaf: no walk
+    auto grand = std::make_unique<StatsNode>();
+    grand->child.emplace();                           // non-leaf adoption walks 3 ancestors
+    root.child->child->child = std::move(grand);
+    auto depth = stats().histogram(stat_histogram::cycle_walk_depth);
+    REQUIRE(depth.count == depth_before.count + 1);
+    REQUIRE(depth.max >= 3);
+}
+
+TEST_CASE("stats sum counters from exited threads", "[pyl_stats]") {
+    if constexpr (!stats_enabled) return;
+
+    auto before = stats();
+    std::thread t([] {
+        for (int i = 0; i < 10; ++i) PYL_STATS_INC(cycle_check);
+    });
+    t.join();
+    REQUIRE(delta(before, stat_counter::cycle_check) == 10);
+
+    reset_stats();
+    REQUIRE(stats().counter(stat_counter::cycle_check) == 0);
+}
+
+TEST_CASE("spans are written as Chrome trace events while tracing", "[pyl_stats]") {
+    if constexpr (!stats_enabled) return;
+
+    std::ostringstream discard;
+    write_chrome_trace(discard);                     // drop earlier spans
+
+    set_tracing(true);
+    {
+        PYL_STATS_SPAN(runtime_format_ns, "test \"span\"");
+    }
+    std::thread([] { PYL_STATS_SPAN(runtime_format_ns, "worker"); }).join();
+    set_tracing(false);
+    {
+        PYL_STATS_SPAN(runtime_format_ns, "untraced");
+    }
+
+    std::ostringstream out;
+    write_chrome_trace(out);
+    std::string json = out.str();
+    REQUIRE(json.find("\"traceEvents\"") != std::string::npos);
+    REQUIRE(json.find("test \\\"span\\\"") != std::string::npos);
+    REQUIRE(json.find("\"worker\"") != std::string::npos);
+    REQUIRE(json.find("untraced") == std::string::npos);
+    REQUIRE(json.find("\"ph\": \"X\"") != std::string::npos);
+}
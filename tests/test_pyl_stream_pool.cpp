@@ -0,0 +1,67 @@
+#include <catch2/catch_test_macros.hpp>
+#include <iomanip>
+#include <ostream>
+#include <string>
+#include "pyl_stream_pool.h"
+#include "pyl_text.h"
+
+using namespace pyl;
+
+namespace {
+
+struct Hexed {
+    int v;
+    friend std::ostream& operator<<(std::ostream& os, const Hexed& h) {
+        return os << std::hex << std::setfill('0') << std::setw(4) << h.v;
+    }
+};
+
+// operator<< that formats through to_text itself
+struct Wrapper {
+    int depth;
+    friend std::ostream& operator<<(std::ostream& os, const Wrapper& w) {
+        if (w.depth == 0) return os << "leaf";
+        return os << "(" << to_text(Wrapper{w.depth - 1}).str() << ")";
+    }
+};
+
+struct Plain {
+    int v;
+    friend std::ostream& operator<<(std::ostream& os, const Plain& p) {
+        return os << p.v << " " << 0.5;
+    }
+};
+
+} // namespace
+
+TEST_CASE("stream_lease reuses the thread's stream", "[pyl_stream_pool]") {
+    const std::ostream* first = nullptr;
+    {
+        stream_lease s;
+        first = &s.stream();
+        s.stream() << "abc" << 12;
+        REQUIRE(s.view() == "abc12");
+        REQUIRE(stream_lease_depth() == 1);
+    }
+    REQUIRE(stream_lease_depth() == 0);
+
+    stream_lease again;
+    REQUIRE(&again.stream() == first);
+    REQUIRE(again.view().empty());
+}
+
+TEST_CASE("stream_lease restores format state between uses", "[pyl_stream_pool]") {
+    REQUIRE(to_text(Hexed{255}).str() == "00ff");
+    REQUIRE(to_text(Plain{255}).str() == "255 0.5");
+
+    stream_lease s;
+    s.stream() << std::setw(3) << 7;
+    REQUIRE(s.view() == "  7");
+}
+
+TEST_CASE("nested to_text calls get distinct streams", "[pyl_stream_pool]") {
+    REQUIRE(to_text(Wrapper{2}).str() == "((leaf))");
+    // deeper than the pool: overflow streams are used and discarded
+    REQUIRE(to_text(Wrapper{12}).str() == std::string(12, '(') + "leaf" + std::string(12, ')'));
+    REQUIRE(stream_lease_depth() == 0);
+}
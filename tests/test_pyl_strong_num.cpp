@@ -1,5 +1,6 @@
 #include <catch2/catch_test_macros.hpp>
 #include "pyl_strong_num.h"
+#include <limits>
 #include <sstream>
 
 using namespace pyl;
@@ -292,3 +293,115 @@ TEST_CASE("StrongNumber multiple types interaction", "[pyl_strong_num]") {
     // Verify they have different tags by checking they're not the same type
     REQUIRE_FALSE((std::is_same_v<UserId, Count>));
 }
+
+// Overflow policies
+STRONG_NUM_OVERFLOW(WrapI8, pyl::NumKind::Int, pyl::NumBits::B8, pyl::Overflow::Wrap);
+STRONG_NUM_OVERFLOW(SatI32, pyl::NumKind::Int, pyl::NumBits::B32, pyl::Overflow::Saturate);
+STRONG_NUM_OVERFLOW(SatSize, pyl::NumKind::Size, pyl::NumBits::B64, pyl::Overflow::Saturate);
+STRONG_NUM_OVERFLOW(CheckedSize, pyl::NumKind::Size, pyl::NumBits::B32, pyl::Overflow::Checked);
+
+TEST_CASE("overflow_policy_v defaults to Native", "[pyl_strong_num]") {
+    REQUIRE(overflow_policy_v<UserIdTag> == Overflow::Native);
+    REQUIRE(overflow_policy_v<void> == Overflow::Native);
+    REQUIRE(SatI32::overflow_policy == Overflow::Saturate);
+    REQUIRE(noexcept(SatI32{1} + SatI32{2}));
+    REQUIRE_FALSE(noexcept(CheckedSize{1u} + CheckedSize{2u}));
+}
+
+TEST_CASE("Wrap policy wraps signed values", "[pyl_strong_num]") {
+    WrapI8 a{127};
+    a += WrapI8{1};
+    REQUIRE(a.value() == -128);
+    REQUIRE((WrapI8{-128} - WrapI8{1}).value() == 127);
+    REQUIRE((-WrapI8{-128}).value() == -128);
+}
+
+TEST_CASE("Saturate policy clamps to min and max", "[pyl_strong_num]") {
+    constexpr auto hi = std::numeric_limits<int32_t>::max();
+    constexpr auto lo = std::numeric_limits<int32_t>::min();
+
+    REQUIRE((SatI32{hi} + SatI32{1}).value() == hi);
+    REQUIRE((SatI32{lo} - SatI32{1}).value() == lo);
+    REQUIRE((SatI32{hi} * SatI32{-2}).value() == lo);
+    REQUIRE((SatI32{lo} / SatI32{-1}).value() == hi);
+    REQUIRE((-SatI32{lo}).value() == hi);
+    REQUIRE((SatI32{40} + SatI32{2}).value() == 42);
+
+    SatSize s{5u};
+    s -= SatSize{7u};
+    REQUIRE(s.value() == 0u);
+    s = SatSize{std::numeric_limits<uint64_t>::max()};
+    s *= SatSize{2u};
+    REQUIRE(s.value() == std::numeric_limits<uint64_t>::max());
+}
+
+TEST_CASE("Checked policy throws on overflow", "[pyl_strong_num]") {
+    CheckedSize c{std::numeric_limits<uint32_t>::max()};
+    REQUIRE_THROWS_AS(c + CheckedSize{1u}, std::overflow_error);
+    REQUIRE_THROWS_AS(CheckedSize{1u} - CheckedSize{2u}, std::overflow_error);
+    REQUIRE_THROWS_AS(c *= CheckedSize{2u}, std::overflow_error);
+    REQUIRE(c.value() == std::numeric_limits<uint32_t>::max());
+    REQUIRE((CheckedSize{6u} * CheckedSize{7u}).value() == 42u);
+}
+
+TEST_CASE("Overflow policy in constant expressions", "[pyl_strong_num]") {
+    static_assert((SatI32{std::numeric_limits<int32_t>::max()} + SatI32{5}).value() ==
+                  std::numeric_limits<int32_t>::max());
+    static_assert((CheckedSize{2u} + CheckedSize{3u}).value() == 5u);
+    REQUIRE(true);
+}
+
+#ifdef __SIZEOF_INT128__
+STRONG_NUM_OVERFLOW(Big, pyl::NumKind::Int, pyl::NumBits::B128, pyl::Overflow::Checked);
+STRONG_NUM_OVERFLOW(BigSize, pyl::NumKind::Size, pyl::NumBits::B128, pyl::Overflow::Saturate);
+
+TEST_CASE("128-bit StrongNumbers with overflow policies", "[pyl_strong_num]") {
+    using strong_num_detail::int_limits;
+    using I = NumTypeT<NumKind::Int, NumBits::B128>;
+    using U = NumTypeT<NumKind::Size, NumBits::B128>;
+
+    Big a{int_limits<I>::max()};
+    REQUIRE_THROWS_AS(a + Big{1}, std::overflow_error);
+    REQUIRE(((a - Big{1}).value() == int_limits<I>::max() - 1));
+
+    BigSize s{int_limits<U>::max()};
+    s += BigSize{1};
+    REQUIRE((s.value() == int_limits<U>::max()));
+    REQUIRE(BigSize{3}.hash() != BigSize{4}.hash());
+
+    REQUIRE(strong_num_detail::is_widening_type_v<int64_t, I>);
+    REQUIRE_FALSE(strong_num_detail::is_widening_type_v<I, int64_t>);
+}
+#endif
+
+TEST_CASE("StrongNumber to_chars and format_to write into caller buffers", "[pyl_strong_num]") {
+    UserId u{-1234};
+    char buf[UserId::max_chars];
+    char* end = u.format_to(buf);
+    REQUIRE(std::string(buf, end) == "-1234");
+
+    char tiny[3];
+    REQUIRE(u.to_chars(tiny, tiny + sizeof(tiny)) == nullptr);
+    REQUIRE(pyl::to_chars(buf, buf + sizeof(buf), Count{7u}) == buf + 1);
+
+    REQUIRE(Price{2.5}.to_string() == std::to_string(2.5));
+    REQUIRE(u.to_full_string() == "[" + std::string(type_name<UserId>()) + " value=-1234]");
+    REQUIRE(u.to_full_string().starts_with("[pyl::StrongNumber<"));
+    REQUIRE(max_chars<Price> == max_chars<double>);
+
+    std::string out = "n=";
+    append_chars(out, Count{42u});
+    REQUIRE(out == "n=42");
+}
+
+#ifdef __SIZEOF_INT128__
+TEST_CASE("128-bit StrongNumbers format without std::to_string", "[pyl_strong_num]") {
+    STRONG_NUM(Wide, pyl::NumKind::Uint, pyl::NumBits::B128);
+    Wide w{~NumTypeT<NumKind::Uint, NumBits::B128>{0}};
+    REQUIRE(w.to_string() == "340282366920938463463374607431768211455");
+
+    std::ostringstream os;
+    os << Big{-5};
+    REQUIRE(os.str() == "-5");
+}
+#endif
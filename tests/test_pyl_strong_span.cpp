@@ -0,0 +1,125 @@
+#include <catch2/catch_test_macros.hpp>
+#include <limits>
+#include <vector>
+#include "pyl_strong_span.h"
+
+using namespace pyl;
+
+namespace {
+
+struct PriceTag {};
+using Price = StrongNumber<double, PriceTag>;
+
+struct QtyTag {};
+using Qty = StrongNumber<std::int32_t, QtyTag>;
+
+struct SatQtyTag { static constexpr Overflow overflow = Overflow::Saturate; };
+using SatQty = StrongNumber<std::int32_t, SatQtyTag>;
+
+struct CheckedBytesTag { static constexpr Overflow overflow = Overflow::Checked; };
+using CheckedBytes = StrongNumber<std::uint64_t, CheckedBytesTag>;
+
+struct SatU8Tag { static constexpr Overflow overflow = Overflow::Saturate; };
+using SatU8 = StrongNumber<std::uint8_t, SatU8Tag>;
+
+} // namespace
+
+static_assert(is_layout_compatible_strong_v<Price>);
+static_assert(is_layout_compatible_strong_v<const Qty>);
+static_assert(strong_number<Price>);
+static_assert(!strong_number<double>);
+
+TEST_CASE("reinterpret_as_underlying views strong values as raw", "[pyl_strong_span]") {
+    std::vector<Price> prices{Price{1.5}, Price{2.5}};
+
+    std::span<double> raw = reinterpret_as_underlying(std::span(prices));
+    REQUIRE(raw.size() == 2);
+    REQUIRE(raw[1] == 2.5);
+
+    raw[0] = 4.0;
+    REQUIRE(prices[0].value() == 4.0);
+
+    std::vector<double> values{1.0, 2.0};
+    strong_span<const Price> back = as_strong<Price>(std::span<const double>(values));
+    REQUIRE(back[1] == Price{2.0});
+}
+
+TEST_CASE("bulk add, scale and prefix_sum keep the tag", "[pyl_strong_span]") {
+    std::vector<Qty> a{Qty{1}, Qty{2}, Qty{3}};
+    std::vector<Qty> b{Qty{10}, Qty{20}, Qty{30}};
+    std::vector<Qty> out(3);
+
+    bulk::add(a, b, out);
+    REQUIRE(out[2] == Qty{33});
+
+    bulk::add(std::span<Qty>(a), std::span<const Qty>(b));
+    REQUIRE(a[0] == Qty{11});
+
+    bulk::scale(out, 2);
+    REQUIRE(out[0] == Qty{22});
+
+    bulk::prefix_sum(out);
+    REQUIRE(out[0] == Qty{22});
+    REQUIRE(out[1] == Qty{66});
+    REQUIRE(out[2] == Qty{132});
+
+    std::vector<Qty> short_out(2);
+    REQUIRE_THROWS_AS(bulk::add(a, b, short_out), std::invalid_argument);
+}
+
+TEST_CASE("bulk min, max and less", "[pyl_strong_span]") {
+    std::vector<Price> prices;
+    for (int i = 0; i < 37; ++i) {
+        prices.emplace_back(static_cast<double>((i * 7) % 37));
+    }
+
+    REQUIRE(bulk::min(prices) == Price{0.0});
+    REQUIRE(bulk::max(prices) == Price{36.0});
+
+    bool mask[37];
+    std::size_t n = bulk::less(std::span<const Price>(prices), Price{10.0}, std::span<bool>(mask));
+    REQUIRE(n == 10);
+    REQUIRE(mask[0]);
+
+    std::vector<Price> empty;
+    REQUIRE_THROWS_AS(bulk::max(empty), std::invalid_argument);
+}
+
+TEST_CASE("bulk kernels follow the saturate policy", "[pyl_strong_span]") {
+    constexpr auto hi = std::numeric_limits<std::int32_t>::max();
+    constexpr auto lo = std::numeric_limits<std::int32_t>::min();
+    std::vector<SatQty> a{SatQty{hi}, SatQty{lo}, SatQty{5}};
+    std::vector<SatQty> b{SatQty{1}, SatQty{-1}, SatQty{6}};
+    std::vector<SatQty> out(3);
+
+    bulk::add(a, b, out);
+    REQUIRE(out[0].value() == hi);
+    REQUIRE(out[1].value() == lo);
+    REQUIRE(out[2].value() == 11);
+
+    bulk::scale(out, -3);
+    REQUIRE(out[0].value() == lo);
+    REQUIRE(out[1].value() == hi);
+    REQUIRE(out[2].value() == -33);
+
+    std::vector<SatU8> bytes(300, SatU8{1});
+    bulk::prefix_sum(bytes);
+    REQUIRE(bytes[254].value() == 255);
+    REQUIRE(bytes[299].value() == 255);
+}
+
+TEST_CASE("bulk kernels throw under the checked policy", "[pyl_strong_span]") {
+    constexpr auto hi = std::numeric_limits<std::uint64_t>::max();
+    std::vector<CheckedBytes> a{CheckedBytes{1u}, CheckedBytes{hi}};
+    std::vector<CheckedBytes> b{CheckedBytes{2u}, CheckedBytes{1u}};
+    std::vector<CheckedBytes> out(2);
+
+    REQUIRE_THROWS_AS(bulk::add(a, b, out), std::overflow_error);
+    REQUIRE(out[0].value() == 3u);
+
+    std::vector<CheckedBytes> small{CheckedBytes{1u}, CheckedBytes{2u}};
+    bulk::scale(small, 4u);
+    REQUIRE(small[1].value() == 8u);
+    REQUIRE_THROWS_AS(bulk::scale(small, hi), std::overflow_error);
+    REQUIRE_THROWS_AS(bulk::prefix_sum(a), std::overflow_error);
+}
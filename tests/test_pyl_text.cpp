@@ -1,6 +1,10 @@
 #include <catch2/catch_test_macros.hpp>
 #include <sstream>
+#include <limits>
+#include <ranges>
+#include <vector>
 #include "pyl_text.h"
+#include "pyl_strong_num.h"
 
 using namespace pyl;
 
@@ -268,3 +272,274 @@ TEST_CASE("format_with_parsed handles unknown placeholders", "[pyl_text]") {
 
     REQUIRE(result == "known=42, unknown={z}");
 }
+
+TEST_CASE("parse_format runs at compile time", "[pyl_text]") {
+    static constexpr char fmt[] = "a={a}!";
+    constexpr auto parsed = parse_format(fmt);
+
+    STATIC_REQUIRE(parsed.count == 3);
+    STATIC_REQUIRE(parsed.tokens[1].kind == TokenKind::Placeholder);
+    STATIC_REQUIRE(parsed.tokens[1].sv == "a");
+}
+
+TEST_CASE("compiled_format binds placeholders to arguments", "[pyl_text]") {
+    using Fmt = compiled_format<"y={y}, x={x}, y again={y}", "x", "y">;
+
+    STATIC_REQUIRE(Fmt::all_bound);
+    STATIC_REQUIRE(Fmt::bindings[1] == 1);
+    STATIC_REQUIRE(Fmt::bindings[3] == 0);
+    STATIC_REQUIRE(Fmt::literal_size == 16);
+
+    REQUIRE(Fmt::format(10, 20) == "y=20, x=10, y again=20");
+}
+
+TEST_CASE("compiled_format reports unbound placeholders", "[pyl_text]") {
+    STATIC_REQUIRE_FALSE(compiled_format<"known={x}, unknown={z}", "x">::all_bound);
+}
+
+TEST_CASE("compiled_format renders like any_to_string", "[pyl_text]") {
+    using Fmt = compiled_format<"{i} {d} {b} {s} {c} {t}", "i", "d", "b", "s", "c", "t">;
+
+    std::string s = "str";
+    const char* c = "chars";
+    Text t = "text";
+
+    REQUIRE(Fmt::format(42, 3.5, true, s, c, t) ==
+            "42 " + std::to_string(3.5) + " true str chars text");
+}
+
+TEST_CASE("compiled_format falls back to to_text for other types", "[pyl_text]") {
+    Point p{1, 2};
+    Color col{1, 2, 3};
+
+    REQUIRE(compiled_format<"p={p} c={col}", "p", "col">::format(p, col) ==
+            "p=Point(1, 2) c=RGB(1,2,3)");
+}
+
+TEST_CASE("any_to_string covers wide integers", "[pyl_text]") {
+    REQUIRE(any_to_string(std::any(std::int64_t{-9000000000})) == "-9000000000");
+    REQUIRE(any_to_string(std::any(std::uint64_t{18000000000000000000u})) == "18000000000000000000");
+    REQUIRE(any_to_string(std::any(std::size_t{7})) == "7");
+}
+
+TEST_CASE("any_to_string formats Text", "[pyl_text]") {
+    REQUIRE(any_to_string(std::any(Text("hi"))) == "hi");
+}
+
+TEST_CASE("any_to_string keeps std::to_string output for floats", "[pyl_text]") {
+    REQUIRE(any_to_string(std::any(3.14)) == std::to_string(3.14));
+    REQUIRE(any_to_string(std::any(-0.5f)) == std::to_string(-0.5f));
+}
+
+TEST_CASE("any_to_string reports unregistered types", "[pyl_text]") {
+    struct Unregistered {};
+
+    REQUIRE(any_to_string(std::any(Unregistered{})) == "<unknown>");
+}
+
+TEST_CASE("make_field registers the boxed type", "[pyl_text]") {
+    Point p{3, 4};
+    auto field = make_field("p", p);
+
+    REQUIRE(field.first == "p");
+    REQUIRE(any_to_string(field.second) == "Point(3, 4)");
+}
+
+TEST_CASE("register_any_formatter adds user formatters", "[pyl_text]") {
+    struct Celsius { int deg; };
+    register_any_formatter(std::type_index(typeid(Celsius)),
+        [](std::string& out, const std::any& a) {
+            out += std::to_string(std::any_cast<const Celsius&>(a).deg) + "C";
+        });
+
+    REQUIRE(any_to_string(std::any(Celsius{21})) == "21C");
+}
+
+TEST_CASE("append_any writes into the caller's buffer", "[pyl_text]") {
+    std::string out = "v=";
+    append_any(out, std::any(12));
+    out += ',';
+    append_any(out, std::any(std::string("s")));
+
+    REQUIRE(out == "v=12,s");
+}
+
+TEST_CASE("format_with_parsed renders MAKE_FIELD values", "[pyl_text]") {
+    Color c{1, 2, 3};
+    long n = 5;
+    auto fields = make_field_map(MAKE_FIELD(c), MAKE_FIELD(n));
+    const char fmt[] = "{c} x{n}";
+
+    REQUIRE(format_with_parsed(parse_format(fmt), fields) == "RGB(1,2,3) x5");
+}
+
+TEST_CASE("MAKE_FIELD covers StrongNumber values", "[pyl_text]") {
+    struct RowsTag {};
+    using Rows = StrongNumber<std::int64_t, RowsTag>;
+    Rows rows{12};
+    auto fields = make_field_map(MAKE_FIELD(rows));
+
+    REQUIRE(any_to_string(fields["rows"]) == "12");
+}
+
+TEST_CASE("to_text, concat and compiled_format write StrongNumbers via to_chars", "[pyl_text]") {
+    struct RowsTag {};
+    using Rows = StrongNumber<std::int64_t, RowsTag>;
+    struct RatioTag {};
+    using Ratio = StrongNumber<double, RatioTag>;
+
+    STATIC_REQUIRE(chars_writable<Rows>);
+    REQUIRE(to_text(Rows{-7}).str() == "-7");
+    REQUIRE(to_text(Ratio{0.5}).str() == std::to_string(0.5));
+    REQUIRE(concat("rows=", Rows{3}, " ratio=", Ratio{2.0}).str() == "rows=3 ratio=2.000000");
+    REQUIRE(compiled_format<"{r}/{q}", "r", "q">::format(Rows{1}, Ratio{0.25}) == "1/0.250000");
+}
+
+#ifdef __SIZEOF_INT128__
+TEST_CASE("to_text handles 128-bit integers", "[pyl_text]") {
+    using I = NumTypeT<NumKind::Int, NumBits::B128>;
+    I big = static_cast<I>(1) << 100;
+    REQUIRE(to_text(big).str() == "1267650600228229401496703205376");
+    REQUIRE(to_text(-big).str() == "-1267650600228229401496703205376");
+}
+#endif
+
+TEST_CASE("Text rvalue concatenation reuses the left buffer", "[pyl_text]") {
+    Text a = "abc";
+    a.str().reserve(64);
+    const char* buffer = a.c_str();
+
+    Text b = std::move(a) + "def" + 12 + Text("!");
+
+    REQUIRE(b.str() == "abcdef12!");
+    REQUIRE(b.c_str() == buffer);
+}
+
+TEST_CASE("Text mixed rvalue and lvalue operands", "[pyl_text]") {
+    Text a = "A";
+    Text b = "B";
+
+    REQUIRE((a + Text("x")).str() == "Ax");
+    REQUIRE((Text("x") + a).str() == "xA");
+    REQUIRE((Text("x") + Text("y")).str() == "xy");
+    REQUIRE(("pre" + Text("x")).str() == "prex");
+    REQUIRE((a + b).str() == "AB");
+    REQUIRE(a.str() == "A");
+    REQUIRE(b.str() == "B");
+}
+
+TEST_CASE("Text concatenation matches to_text for numbers", "[pyl_text]") {
+    Text a = "v=";
+
+    REQUIRE((a + 2.5).str() == "v=" + to_text(2.5).str());
+    REQUIRE((a + true).str() == "v=1");
+    REQUIRE((Text("v=") + -7).str() == "v=-7");
+}
+
+TEST_CASE("Text operator+= appends in place", "[pyl_text]") {
+    Text message = "Even squares:";
+    for (int n : {4, 16, 36}) {
+        message += " ";
+        message += n;
+    }
+    message += Text(".");
+
+    REQUIRE(message.str() == "Even squares: 4 16 36.");
+}
+
+TEST_CASE("concat builds Text with one reservation", "[pyl_text]") {
+    Point p{1, 2};
+    std::string s = "str";
+    Text t = "text";
+
+    Text result = concat("a=", 1, ", s=", s, ", t=", t, ", p=", p, ", f=", 0.5);
+
+    REQUIRE(result.str() == "a=1, s=str, t=text, p=Point(1, 2), f=" + std::to_string(0.5));
+    REQUIRE(result.str() == (Text("a=") + 1 + ", s=" + s + ", t=" + t + ", p=" + p + ", f=" + 0.5).str());
+}
+
+TEST_CASE("TextView views without copying", "[pyl_text]") {
+    Text owner = "hello";
+    std::string s = "hello";
+
+    TextView a = owner;
+    TextView b = s;
+    TextView c = "hello";
+
+    REQUIRE(a.data() == owner.str().data());
+    REQUIRE(a == b);
+    REQUIRE(b == c);
+    REQUIRE(a == owner);
+    REQUIRE(a < TextView("world"));
+    REQUIRE(a.hash() == owner.hash());
+    REQUIRE(owner.view() == a);
+    REQUIRE(to_text(a).str() == "hello");
+    REQUIRE(a.to_full_string() == "[TextView value=\"hello\"]");
+}
+
+TEST_CASE("TextView concatenation yields Text", "[pyl_text]") {
+    TextView v = "id";
+    Text t = "#";
+
+    REQUIRE((v + "=" + 7).str() == "id=7");
+    REQUIRE((t + v).str() == "#id");
+    REQUIRE((v + t).str() == "id#");
+    REQUIRE((1 + v).str() == "1id");
+    REQUIRE(concat(v, ':', 2).str() == "id" + std::to_string(':') + "2");
+}
+
+TEST_CASE("intern returns shared entries", "[pyl_text]") {
+    InternedText a = intern("latency_ms");
+    InternedText b = intern(std::string("latency_") + "ms");
+    InternedText c = intern("throughput");
+
+    REQUIRE(a == b);
+    REQUIRE(a != c);
+    REQUIRE(a.c_str() == b.c_str());
+    REQUIRE(a.hash() == b.hash());
+    REQUIRE(a.view() == "latency_ms");
+    REQUIRE(intern("").empty());
+    REQUIRE(intern("") == InternedText{});
+
+    std::size_t before = interned_count();
+    intern("latency_ms");
+    REQUIRE(interned_count() == before);
+
+    REQUIRE((Text("label=") + a).str() == "label=latency_ms");
+    REQUIRE(any_to_string(std::any(a)) == "latency_ms");
+}
+
+TEST_CASE("join writes numeric ranges in one pass", "[pyl_text]") {
+    std::vector<int> ints{1, -2, 30, std::numeric_limits<int>::min()};
+    REQUIRE(join(ints, ", ").str() == "1, -2, 30, " + std::to_string(std::numeric_limits<int>::min()));
+    REQUIRE(join(std::vector<int>{}, ", ").empty());
+    REQUIRE(join(std::vector<int>{7}, ", ").str() == "7");
+
+    std::vector<double> ds{0.5, 2.0};
+    REQUIRE(join(ds, "|").str() == std::to_string(0.5) + "|" + std::to_string(2.0));
+
+    struct RowsTag {};
+    using Rows = StrongNumber<std::int64_t, RowsTag>;
+    std::vector<Rows> rows{Rows{3}, Rows{-4}};
+    REQUIRE(join(rows, ",").str() == "3,-4");
+
+    std::string out = "n=";
+    append_join(out, std::vector<unsigned>{1u, 2u, 3u, 100u}, "");
+    REQUIRE(out == "n=123100");
+}
+
+TEST_CASE("join renders non-numeric ranges like placeholders", "[pyl_text]") {
+    std::vector<std::string> words{"a", "bc", "", "d"};
+    REQUIRE(join(words, "-").str() == "a-bc--d");
+    REQUIRE(join(std::vector<bool>{true, false}, " ").str() == "true false");
+    REQUIRE(join(std::vector<Point>{{1, 2}, {3, 4}}, "; ").str() == "Point(1, 2); Point(3, 4)");
+
+    auto evens = std::views::iota(1, 9) | std::views::filter([](int i) { return i % 2 == 0; });
+    REQUIRE(join(evens, ",").str() == "2,4,6,8");
+}
+
+TEST_CASE("to_text_all brackets the joined range", "[pyl_text]") {
+    REQUIRE(to_text_all(std::vector<int>{1, 2, 3}).str() == "[1, 2, 3]");
+    REQUIRE(to_text_all(std::vector<std::string>{}).str() == "[]");
+    REQUIRE(to_text_all(std::vector<std::string_view>{"x", "y"}).str() == "[x, y]");
+}
@@ -0,0 +1,41 @@
+#include <catch2/catch_test_macros.hpp>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "pyl_type_name.h"
+
+using namespace pyl;
+
+namespace {
+struct Widget {};
+namespace inner { struct Gadget {}; }
+}
+
+TEST_CASE("type_name is a compile-time demangled name", "[pyl_type_name]") {
+    STATIC_REQUIRE(type_name<int>() == "int");
+    STATIC_REQUIRE(type_name<double>() == "double");
+    STATIC_REQUIRE(type_name<const char*>() == "const char*");
+
+    constexpr std::string_view w = type_name<Widget>();
+    STATIC_REQUIRE(w.ends_with("Widget"));
+    REQUIRE(type_name<inner::Gadget>().ends_with("inner::Gadget"));
+
+    std::string_view v = type_name<std::vector<int>>();
+    REQUIRE(v.starts_with("std::"));
+    REQUIRE(v.find("vector<int") != std::string_view::npos);
+}
+
+TEST_CASE("type_name results are stable views", "[pyl_type_name]") {
+    REQUIRE(type_name<Widget>().data() == type_name<Widget>().data());
+    REQUIRE(type_name<Widget>() != type_name<inner::Gadget>());
+}
+
+TEST_CASE("append_address matches ostream pointer output", "[pyl_type_name]") {
+    int x = 0;
+    std::ostringstream oss;
+    oss << static_cast<const void*>(&x);
+
+    std::string s = "@";
+    append_address(s, &x);
+    REQUIRE(s == "@" + oss.str());
+}
@@ -0,0 +1,54 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <type_traits>
+#include "pyl_units.h"
+
+using namespace pyl;
+
+static_assert(std::is_same_v<unit_divide<meters, seconds>, meters_per_second>);
+static_assert(std::is_same_v<unit_multiply<meters, meters>, square_meters>);
+static_assert(std::is_same_v<unit_multiply<kilograms, meters_per_second2>, newtons>);
+static_assert(std::is_same_v<unit_divide<meters, meters>, scalar_unit>);
+static_assert(std::is_same_v<unit_divide<kilometers, hours>, kilometers_per_hour>);
+
+TEST_CASE("units compose through * and /", "[pyl_units]") {
+    quantity<meters> d{100.0};
+    quantity<seconds> t{10.0};
+
+    auto v = d / t;
+    static_assert(std::is_same_v<decltype(v), quantity<meters_per_second>>);
+    REQUIRE(v.value() == 10.0);
+
+    auto area = d * d;
+    static_assert(std::is_same_v<decltype(area), quantity<square_meters>>);
+    REQUIRE(area.value() == 10'000.0);
+
+    constexpr auto f = quantity<kilograms>{2.0} * quantity<meters_per_second2>{3.0};
+    static_assert(std::is_same_v<std::remove_const_t<decltype(f)>, quantity<newtons>>);
+    static_assert(f.value() == 6.0);
+}
+
+TEST_CASE("unit_cast converts between compatible units", "[pyl_units]") {
+    quantity<meters_per_second> v{10.0};
+    auto kmh = unit_cast<kilometers_per_hour>(v);
+    REQUIRE(std::abs(kmh.value() - 36.0) < 1e-12);
+
+    quantity<kilometers, std::int64_t> km{3};
+    REQUIRE(unit_cast<meters>(km).value() == 3000);
+
+    constexpr auto ms = unit_cast<milliseconds>(quantity<seconds>{1.5});
+    static_assert(ms.value() == 1500.0);
+}
+
+TEST_CASE("same-unit arithmetic still works", "[pyl_units]") {
+    quantity<meters> a{1.0};
+    quantity<meters> b{2.5};
+
+    REQUIRE((a + b).value() == 3.5);
+    REQUIRE(a < b);
+}
+
+// non-unit tags keep the original same-tag * and /
+struct ScoreTag {};
+static_assert(std::is_same_v<decltype(StrongNumber<int, ScoreTag>{2} * StrongNumber<int, ScoreTag>{3}),
+                             StrongNumber<int, ScoreTag>>);